@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "ConfigParser.h"
+
+using namespace hormodular;
+
+static const std::string FILEPATH = "../../data/robots/MultiDof-11-2.xml";
+
+static void BM_ConfigParserParse(benchmark::State& state)
+{
+    ConfigParser configParser;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(configParser.parse(FILEPATH));
+}
+BENCHMARK(BM_ConfigParserParse);
+
+BENCHMARK_MAIN();
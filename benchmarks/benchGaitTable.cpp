@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "GaitTable.h"
+
+using namespace hormodular;
+
+static const std::string GAIT_TABLE_FILEPATH = "../../data/gait tables/multidof-11-2-gaittable.txt";
+
+static void BM_GaitTableLoad(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        GaitTable gaitTable(GAIT_TABLE_FILEPATH);
+        benchmark::DoNotOptimize(gaitTable.getNumParameters());
+    }
+}
+BENCHMARK(BM_GaitTableLoad);
+
+static void BM_GaitTableLookup(benchmark::State& state)
+{
+    GaitTable gaitTable(GAIT_TABLE_FILEPATH);
+    std::vector<unsigned long> ids = gaitTable.getIDs();
+    int i = 0;
+
+    for (auto _ : state)
+    {
+        std::vector<float> parameters = gaitTable.getParameters(ids[i]);
+        benchmark::DoNotOptimize(parameters.data());
+        i = (i + 1) % ids.size();
+    }
+}
+BENCHMARK(BM_GaitTableLookup);
+
+BENCHMARK_MAIN();
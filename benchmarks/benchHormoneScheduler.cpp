@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "ConfigParser.h"
+#include "HormoneScheduler.hpp"
+
+using namespace hormodular;
+
+static const std::string FILEPATH = "../../data/robots/MultiDof-7-tripod.xml";
+
+//-- Simulates the hormone network until the module IDs converge
+static void BM_HormoneSchedulerConvergence(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    HormoneScheduler scheduler(configParser.getRobotDescription());
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        scheduler.reset();
+        state.ResumeTiming();
+
+        scheduler.run(10000000);
+    }
+
+    state.counters["convergence_time_us"] = scheduler.getConvergenceTime();
+    state.counters["wake_ups"] = scheduler.getNumWakeUps();
+    state.counters["deliveries"] = scheduler.getNumDeliveries();
+}
+BENCHMARK(BM_HormoneSchedulerConvergence)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ConfigParser.h"
+#include "ModularRobot.h"
+
+using namespace hormodular;
+
+static const std::string FILEPATH = "../../data/robots/MultiDof-7-tripod.xml";
+
+//-- Creates the robot (modules and headless interface) from an already parsed description
+static void BM_ModularRobotCreate(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    RobotDescriptionPtr robotDescription = configParser.getRobotDescription();
+
+    for (auto _ : state)
+    {
+        ModularRobot modularRobot(robotDescription, "dummy");
+        benchmark::DoNotOptimize(modularRobot.getElapsedTime());
+    }
+}
+BENCHMARK(BM_ModularRobotCreate);
+
+//-- Runs the full controller on a headless ("dummy") robot interface, with
+//-- the run time (ms) given as benchmark argument
+static void BM_ModularRobotRun(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    ModularRobot modularRobot(configParser.getRobotDescription(), "dummy");
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        modularRobot.reset();
+        state.ResumeTiming();
+
+        modularRobot.run(state.range(0));
+    }
+
+    //-- Simulated seconds per wall second
+    state.counters["sim_time_ratio"] = benchmark::Counter(state.range(0) / 1000.0 * state.iterations(),
+                                                          benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ModularRobotRun)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+//-- Same as BM_ModularRobotRun, but only recomputing the modules whose incoming hormones changed
+static void BM_ModularRobotRunIncremental(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    ModularRobot modularRobot(configParser.getRobotDescription(), "dummy");
+    modularRobot.setProperty("incremental", "enabled");
+
+    double recomputed = 0, periods = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        modularRobot.reset();
+        state.ResumeTiming();
+
+        modularRobot.run(state.range(0));
+
+        std::vector<int> recomputedModules = modularRobot.getRecomputedModulesPerPeriod();
+        for (size_t i = 0; i < recomputedModules.size(); i++)
+            recomputed += recomputedModules[i];
+        periods += recomputedModules.size();
+    }
+
+    state.counters["sim_time_ratio"] = benchmark::Counter(state.range(0) / 1000.0 * state.iterations(),
+                                                          benchmark::Counter::kIsRate);
+    state.counters["recomputed_per_period"] = periods > 0 ? recomputed / periods : 0;
+}
+BENCHMARK(BM_ModularRobotRunIncremental)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+//-- Same as BM_ModularRobotRun, recording the execution (argument 1: compressed recording)
+static void BM_ModularRobotRunRecording(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    ModularRobot modularRobot(configParser.getRobotDescription(), "dummy");
+
+    std::string recording_file = state.range(1) ? "benchModularRobot.hmr.gz" : "benchModularRobot.hmr";
+    modularRobot.setProperty("recording", recording_file);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        modularRobot.reset();
+        state.ResumeTiming();
+
+        modularRobot.run(state.range(0));
+    }
+
+    modularRobot.setProperty("recording", "disabled");
+    std::remove(recording_file.c_str());
+
+    state.counters["sim_time_ratio"] = benchmark::Counter(state.range(0) / 1000.0 * state.iterations(),
+                                                          benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ModularRobotRunRecording)->Args({10000, 0})->Args({10000, 1})->Unit(benchmark::kMillisecond);
+
+//-- Same as BM_ModularRobotRun, computing the joint targets at a lower control rate (argument 1, in Hz)
+//-- and interpolating them on every step (argument 2: 0 for linear, 1 for cubic interpolation)
+static void BM_ModularRobotRunControlRate(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    ModularRobot modularRobot(configParser.getRobotDescription(), "dummy");
+
+    std::stringstream rate;
+    rate << state.range(1);
+    modularRobot.setProperty("control_rate", rate.str());
+    modularRobot.setProperty("interpolation", state.range(2) ? "cubic" : "linear");
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        modularRobot.reset();
+        state.ResumeTiming();
+
+        modularRobot.run(state.range(0));
+    }
+
+    state.counters["sim_time_ratio"] = benchmark::Counter(state.range(0) / 1000.0 * state.iterations(),
+                                                          benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ModularRobotRunControlRate)->Args({10000, 50, 0})->Args({10000, 50, 1})->Args({10000, 200, 0})
+                                        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
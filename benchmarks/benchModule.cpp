@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "ConfigParser.h"
+#include "Module.hpp"
+
+using namespace hormodular;
+
+static const std::string FILEPATH = "../../data/robots/MultiDof-7-tripod.xml";
+
+//-- Creates the modules of the robot and attaches them as ModularRobot does
+static std::vector<Module *> createModules(ConfigParser& configParser)
+{
+    std::vector<Module *> modules;
+    for(int i = 0; i < configParser.getNumModules(); i++)
+        modules.push_back( new Module(configParser.getRobotDescription(), i) );
+
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        std::vector< std::vector<int> > connectorConfig = configParser.getConnectorInfo(i);
+
+        for (int j = 0; j < (int) connectorConfig.size(); j++)
+            if ( connectorConfig[j].size() != 0 )
+                modules[i]->attach( j, modules[connectorConfig[j][0]]->getConnector(connectorConfig[j][1]),
+                                    connectorConfig[j][2]);
+            else
+                modules[i]->attach(j, NULL);
+    }
+
+    return modules;
+}
+
+static void BM_ModuleProcessHormones(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    std::vector<Module *> modules = createModules(configParser);
+
+    //-- One iteration is a communication period of the whole robot
+    for (auto _ : state)
+    {
+        for(int i = 0; i < (int) modules.size(); i++)
+            modules[i]->processHormones();
+
+        for(int i = 0; i < (int) modules.size(); i++)
+            modules[i]->sendHormones();
+    }
+
+    state.counters["modules"] = modules.size();
+
+    for(int i = 0; i < (int) modules.size(); i++)
+        delete modules[i];
+}
+BENCHMARK(BM_ModuleProcessHormones);
+
+static void BM_ModuleProcessHormonesDescriptorIDs(benchmark::State& state)
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    std::vector<Module *> modules = createModules(configParser);
+
+    for(int i = 0; i < (int) modules.size(); i++)
+        modules[i]->setIdEncoding(Module::DESCRIPTOR_ID, state.range(0));
+
+    //-- One iteration is a communication period of the whole robot
+    for (auto _ : state)
+    {
+        for(int i = 0; i < (int) modules.size(); i++)
+            modules[i]->processHormones();
+
+        for(int i = 0; i < (int) modules.size(); i++)
+            modules[i]->sendHormones();
+    }
+
+    state.counters["modules"] = modules.size();
+
+    for(int i = 0; i < (int) modules.size(); i++)
+        delete modules[i];
+}
+BENCHMARK(BM_ModuleProcessHormonesDescriptorIDs)->Arg(2)->Arg(4)->Arg(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "Orientation.hpp"
+
+using namespace hormodular;
+
+//-- Orientations found on the robots from data/robots
+static std::vector<Orientation> robotOrientations()
+{
+    std::vector<Orientation> orientations;
+    orientations.push_back(Orientation(  0,  0, 180));
+    orientations.push_back(Orientation(  0, 90,   0));
+    orientations.push_back(Orientation(-90,  0,  90));
+    orientations.push_back(Orientation( 90,  0, -90));
+    orientations.push_back(Orientation(  0,  0,   0));
+    orientations.push_back(Orientation(-90,  0,   0));
+    orientations.push_back(Orientation( 90,  0,   0));
+    orientations.push_back(Orientation(180, -90,  0));
+    return orientations;
+}
+
+static void BM_GetRelativeOrientation(benchmark::State& state)
+{
+    std::vector<Orientation> orientations = robotOrientations();
+
+    int i = 0;
+    for (auto _ : state)
+    {
+        int j = (i + 1) % orientations.size();
+        benchmark::DoNotOptimize(Orientation::getRelativeOrientation(i % 4, orientations[i], orientations[j]));
+        i = j;
+    }
+}
+BENCHMARK(BM_GetRelativeOrientation);
+
+static void BM_GetRelativeOrientationEigen(benchmark::State& state)
+{
+    std::vector<Orientation> orientations = robotOrientations();
+
+    int i = 0;
+    for (auto _ : state)
+    {
+        int j = (i + 1) % orientations.size();
+        benchmark::DoNotOptimize(Orientation::getRelativeOrientationEigen(i % 4, orientations[i], orientations[j]));
+        i = j;
+    }
+}
+BENCHMARK(BM_GetRelativeOrientationEigen);
+
+static void BM_GetRelativeOrientationIndex(benchmark::State& state)
+{
+    std::vector<Orientation> orientations = robotOrientations();
+    std::vector<OrientationIndex> indices;
+    for (size_t i = 0; i < orientations.size(); i++)
+        indices.push_back(orientations[i].getIndex());
+
+    int i = 0;
+    for (auto _ : state)
+    {
+        int j = (i + 1) % indices.size();
+        benchmark::DoNotOptimize(Orientation::getRelativeOrientation(i % 4, indices[i], indices[j]));
+        i = j;
+    }
+}
+BENCHMARK(BM_GetRelativeOrientationIndex);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "SinusoidalOscillator.h"
+#include "Trajectory.h"
+
+using namespace hormodular;
+
+static void BM_SinusoidalOscillatorCalculatePos(benchmark::State& state)
+{
+    SinusoidalOscillator oscillator(30, 10, 90, 1000);
+    unsigned long time = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(oscillator.calculatePos(time));
+        time += 250;
+    }
+}
+BENCHMARK(BM_SinusoidalOscillatorCalculatePos);
+
+//-- Joint values of a 7-module robot for one control step: computed on the fly vs read from a trajectory
+static const int NUM_JOINTS = 7;
+
+static void BM_OscillatorsStep(benchmark::State& state)
+{
+    std::vector<Oscillator *> oscillators;
+    for (int i = 0; i < NUM_JOINTS; i++)
+        oscillators.push_back(new SinusoidalOscillator(30, 10, 45 * i, 2000));
+
+    std::vector<float> joint_values(NUM_JOINTS);
+    unsigned long time = 0;
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < NUM_JOINTS; i++)
+            joint_values[i] = oscillators[i]->calculatePos(time);
+        benchmark::DoNotOptimize(joint_values.data());
+        time += 250;
+    }
+
+    for (int i = 0; i < NUM_JOINTS; i++)
+        delete oscillators[i];
+}
+BENCHMARK(BM_OscillatorsStep);
+
+static void BM_TrajectoryStep(benchmark::State& state)
+{
+    std::vector<Oscillator *> oscillators;
+    for (int i = 0; i < NUM_JOINTS; i++)
+        oscillators.push_back(new SinusoidalOscillator(30, 10, 45 * i, 2000));
+
+    Trajectory trajectory;
+    trajectory.compute(oscillators, 0.25, 10000000);
+
+    std::vector<float> joint_values(NUM_JOINTS);
+    int step = 0;
+
+    for (auto _ : state)
+    {
+        const float * values = trajectory.getJointValues(step);
+        joint_values.assign(values, values + NUM_JOINTS);
+        benchmark::DoNotOptimize(joint_values.data());
+        step = (step + 1) % trajectory.getNumSteps();
+    }
+
+    for (int i = 0; i < NUM_JOINTS; i++)
+        delete oscillators[i];
+}
+BENCHMARK(BM_TrajectoryStep);
+
+static void BM_TrajectoryCompute(benchmark::State& state)
+{
+    std::vector<Oscillator *> oscillators;
+    for (int i = 0; i < NUM_JOINTS; i++)
+        oscillators.push_back(new SinusoidalOscillator(30, 10, 45 * i, 2000));
+
+    Trajectory trajectory;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(trajectory.compute(oscillators, 0.25, 10000000));
+
+    for (int i = 0; i < NUM_JOINTS; i++)
+        delete oscillators[i];
+}
+BENCHMARK(BM_TrajectoryCompute);
+
+BENCHMARK_MAIN();
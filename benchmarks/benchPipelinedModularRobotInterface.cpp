@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <time.h>
+#include <vector>
+#include "PipelinedModularRobotInterface.hpp"
+
+using namespace hormodular;
+
+//-- Busy-waits the given time (in us), as a computation would do
+static void spin(int time_us)
+{
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    while ( (now.tv_sec - start.tv_sec) * 1000000 + (now.tv_nsec - start.tv_nsec) / 1000 < time_us );
+}
+
+//-- Robot interface whose steps take a fixed time, as a simulator stepping the physics
+class SpinningInterface : public ModularRobotInterface
+{
+    public:
+        SpinningInterface(int step_time_us) : step_time_us(step_time_us) {}
+
+        virtual bool start() { return true; }
+        virtual bool stop() { return true; }
+        virtual bool destroy() { return true; }
+        virtual bool reset() { return true; }
+        virtual float getTravelledDistance() { return 0; }
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0) { spin(step_time_us); return true; }
+        virtual std::vector<float> getJointValues() { return std::vector<float>(); }
+
+    private:
+        int step_time_us;
+};
+
+//-- Control loop with a controller step of argument 0 us and a robot step of argument 1 us, sending the
+//-- joint values from the control loop (argument 2 = 0) or pipelined with a latency of argument 2 steps
+static void BM_PipelinedControlLoop(benchmark::State& state)
+{
+    ModularRobotInterface * robotInterface = new SpinningInterface(state.range(1));
+    if ( state.range(2) > 0 )
+        robotInterface = new PipelinedModularRobotInterface(robotInterface, state.range(2));
+
+    std::vector<float> joint_values(100, 0);
+    for (auto _ : state)
+    {
+        spin(state.range(0));
+        robotInterface->sendJointValues(joint_values, 1);
+    }
+
+    if ( state.range(2) > 0 )
+        static_cast<PipelinedModularRobotInterface *>(robotInterface)->flush();
+
+    state.counters["steps_per_second"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+
+    robotInterface->destroy();
+    delete robotInterface;
+}
+BENCHMARK(BM_PipelinedControlLoop)->Args({100, 100, 0})->Args({100, 100, 1})->Args({100, 100, 2})
+                                  ->Args({50, 200, 0})->Args({50, 200, 1})
+                                  ->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
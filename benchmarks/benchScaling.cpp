@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <malloc.h>
+#include <string>
+#include <sstream>
+#include "ConfigParser.h"
+#include "ModularRobot.h"
+#include "ModuleArray.hpp"
+#include "RobotGenerator.hpp"
+
+using namespace hormodular;
+
+//-- Bytes allocated on the heap
+static size_t heapUsage()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return (unsigned int) mallinfo().uordblks;
+#endif
+}
+
+//-- Generates a synthetic robot (argument 0: 0 for a tree, 1 for a lattice; argument 1: number of
+//-- modules) on the working directory and returns its description
+static RobotDescriptionPtr generateRobot(benchmark::State& state, std::string& name)
+{
+    RobotGenerator::Shape shape = state.range(0) == 0 ? RobotGenerator::TREE : RobotGenerator::LATTICE;
+    std::stringstream nameStr;
+    nameStr << "benchScaling-" << (shape == RobotGenerator::TREE ? "tree" : "lattice") << "-" << state.range(1);
+    name = nameStr.str();
+
+    RobotGenerator robotGenerator(shape, state.range(1));
+    if ( !robotGenerator.save(".", name) )
+        return RobotDescriptionPtr();
+
+    ConfigParser configParser;
+    configParser.setCacheEnabled(false);
+    configParser.parse(RobotGenerator::getConfigFile(".", name));
+
+    state.counters["gait_table_rows"] = robotGenerator.getNumGaitTableRows();
+    return configParser.getRobotDescription();
+}
+
+static void removeRobot(const std::string& name)
+{
+    std::remove(RobotGenerator::getConfigFile(".", name).c_str());
+    std::remove(("./" + name + "-gaittable.txt").c_str());
+    std::remove(("./" + name + "-frequencies.txt").c_str());
+}
+
+//-- Creates the robot (modules, connections and headless interface)
+static void BM_ScalingCreate(benchmark::State& state)
+{
+    std::string name;
+    RobotDescriptionPtr robotDescription = generateRobot(state, name);
+    if ( !robotDescription )
+    {
+        state.SkipWithError("Robot could not be generated");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        ModularRobot modularRobot(robotDescription, "dummy");
+        benchmark::DoNotOptimize(modularRobot.getElapsedTime());
+    }
+
+    removeRobot(name);
+}
+
+//-- Runs the full controller with descriptor IDs on a headless ("dummy") robot interface, one
+//-- communication period per iteration, reporting the heap used per module
+static void BM_ScalingCommunicationPeriod(benchmark::State& state)
+{
+    std::string name;
+    RobotDescriptionPtr robotDescription = generateRobot(state, name);
+    if ( !robotDescription )
+    {
+        state.SkipWithError("Robot could not be generated");
+        return;
+    }
+
+    //-- The first period loads the gait tables used by the modules
+    size_t heapBefore = heapUsage();
+    ModularRobot modularRobot(robotDescription, "dummy");
+    modularRobot.setProperty("ids", "descriptor");
+    modularRobot.run(ModularRobot::COMMUNICATION_PERIOD_MS);
+    size_t heapAfter = heapUsage();
+
+    for (auto _ : state)
+        modularRobot.run(modularRobot.getElapsedTime() / 1000 + ModularRobot::COMMUNICATION_PERIOD_MS);
+
+    state.counters["bytes_per_module"] = heapAfter > heapBefore ? (double) (heapAfter - heapBefore) / state.range(1) : 0;
+    state.counters["modules_per_second"] = benchmark::Counter(state.range(1) * state.iterations(),
+                                                              benchmark::Counter::kIsRate);
+
+    removeRobot(name);
+}
+
+//-- Default time step of ModularRobot
+static const float STEP_MS = 0.25;
+
+//-- Calculates the joint positions and advances the time of all the modules, one module at a time,
+//-- each module with its own storage (as the modules were stored before ModuleArray)
+static void BM_ScalingStepModules(benchmark::State& state)
+{
+    std::string name;
+    RobotDescriptionPtr robotDescription = generateRobot(state, name);
+    if ( !robotDescription )
+    {
+        state.SkipWithError("Robot could not be generated");
+        return;
+    }
+
+    std::vector<Module *> modules;
+    for (int i = 0; i < robotDescription->getNumModules(); i++)
+        modules.push_back( new Module(robotDescription, i) );
+
+    std::vector<float> jointValues(modules.size());
+    for (auto _ : state)
+    {
+        for (int i = 0; i < (int) modules.size(); i++)
+            jointValues[i] = modules[i]->calculateNextJointPos();
+        for (int i = 0; i < (int) modules.size(); i++)
+            modules[i]->updateElapsedTime(STEP_MS);
+        benchmark::DoNotOptimize(jointValues.data());
+    }
+
+    state.counters["modules_per_second"] = benchmark::Counter(state.range(1) * state.iterations(),
+                                                              benchmark::Counter::kIsRate);
+
+    for (int i = 0; i < (int) modules.size(); i++)
+        delete modules[i];
+    removeRobot(name);
+}
+
+//-- Same step, sweeping the shared ModuleArray used by ModularRobot::step()
+static void BM_ScalingStepArray(benchmark::State& state)
+{
+    std::string name;
+    RobotDescriptionPtr robotDescription = generateRobot(state, name);
+    if ( !robotDescription )
+    {
+        state.SkipWithError("Robot could not be generated");
+        return;
+    }
+
+    ModuleArray moduleArray(robotDescription, robotDescription->getNumModules());
+    std::vector<Module *> modules;
+    for (int i = 0; i < robotDescription->getNumModules(); i++)
+        modules.push_back( new Module(robotDescription, i, &moduleArray) );
+
+    std::vector<float> jointValues(modules.size());
+    for (auto _ : state)
+    {
+        moduleArray.calculateJointPositions(jointValues);
+        moduleArray.updateElapsedTime(STEP_MS);
+        benchmark::DoNotOptimize(jointValues.data());
+    }
+
+    state.counters["modules_per_second"] = benchmark::Counter(state.range(1) * state.iterations(),
+                                                              benchmark::Counter::kIsRate);
+
+    for (int i = 0; i < (int) modules.size(); i++)
+        delete modules[i];
+    removeRobot(name);
+}
+
+//-- The gait tables are shared by all the modules of the robot, so memory grows linearly with the
+//-- number of modules (the gait table has a row per module on random trees)
+static void ScalingArguments(benchmark::internal::Benchmark* benchmark)
+{
+    for (int modules = 10; modules <= 10000; modules *= 10)
+        benchmark->Args({0, modules});
+    for (int modules = 10; modules <= 10000; modules *= 10)
+        benchmark->Args({1, modules});
+}
+
+BENCHMARK(BM_ScalingCreate)->Apply(ScalingArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScalingCommunicationPeriod)->Apply(ScalingArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScalingStepModules)->Apply(ScalingArguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ScalingStepArray)->Apply(ScalingArguments)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
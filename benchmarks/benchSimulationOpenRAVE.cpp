@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "ConfigParser.h"
+#include "SimulationOpenRAVE.hpp"
+
+using namespace hormodular;
+
+static const std::string FILEPATH = "../../data/robots/MultiDof-7-tripod.xml";
+
+static std::string simulationFile()
+{
+    ConfigParser configParser;
+    configParser.parse(FILEPATH);
+    return configParser.getSimulationFile();
+}
+
+//-- Reset by reloading the environment from disk
+static void BM_SimulationReload(benchmark::State& state)
+{
+    SimulationOpenRAVE simulation(simulationFile(), false);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (int i = 0; i < 100; i++)
+            simulation.step(0.001);
+        state.ResumeTiming();
+
+        simulation.reload();
+    }
+}
+BENCHMARK(BM_SimulationReload)->Unit(benchmark::kMillisecond);
+
+//-- Reset by restoring the snapshot taken after loading the environment
+static void BM_SimulationReset(benchmark::State& state)
+{
+    SimulationOpenRAVE simulation(simulationFile(), false);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (int i = 0; i < 100; i++)
+            simulation.step(0.001);
+        state.ResumeTiming();
+
+        simulation.reset();
+    }
+}
+BENCHMARK(BM_SimulationReset)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -15,6 +15,8 @@
 //-- Released under the GPL license (more info on LICENSE.txt file)
 //------------------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "ModularRobotEvalOp.h"
 
 
@@ -111,7 +113,7 @@ bool ModularRobotEvalOp::initialize(StateP state)
         return false;
     }
     //-- Create robot, simulated type
-    robotInterface = createModularRobotInterface( "simulated", configParser);
+    robotInterface = createModularRobotInterface( "simulated", configParser.getRobotDescription());
 
     //-- Create sinusoidal oscillators with the test parameters
     oscillators.clear();
@@ -145,25 +147,23 @@ FitnessP ModularRobotEvalOp::evaluate(IndividualP individual)
     //-- Run the robot:
     std::cout << "[Evolve] Run!" << std::endl;
 
-    //-- Here you put the main loop
-    unsigned long elapsed_time = 0; //-- Should be in uS
-    unsigned long max_time_us = max_runtime*1000;
-    joint_values.clear();
-    for (int i = 0; i < (int) n_modules; i++)
-        joint_values.push_back(0);
-
-    while( elapsed_time < max_time_us )
+    //-- Precompute the joint trajectory of this individual
+    if ( !trajectory.compute(oscillators, timestep, max_runtime*1000) )
     {
-        //-- Update joint values
-        for ( int i = 0; i < (int) oscillators.size(); i++)
-            joint_values[i] = oscillators[i]->calculatePos(elapsed_time);
-
-        //-- Send joint values
-        robotInterface->sendJointValues(joint_values, timestep);
-
-        elapsed_time+=(unsigned long) (timestep*1000);
+        fitness->setValue(0);
+        return fitness;
+    }
 
-        //std::cout << "[Evolve] Time: " << elapsed_time << "us" << std::endl;
+    //-- Here you put the main loop (the trajectory is sent one buffer at a time)
+    for ( int step = 0; step < trajectory.getNumSteps(); step += trajectory.getBufferedSteps())
+    {
+        int batch_steps = std::min(trajectory.getBufferedSteps(), trajectory.getNumSteps() - step);
+        if ( !robotInterface->sendJointTrajectory(trajectory, step, batch_steps, timestep) )
+        {
+            std::cerr << "[Evolve] Error: could not send the trajectory (step " << step << ")" << std::endl;
+            fitness->setValue(0);
+            return fitness;
+        }
     }
 
     //-- Select the fitness value (distance travelled in m)
@@ -18,6 +18,7 @@
 #include <ecf/ECF.h>
 #include "ConfigParser.h"
 #include "SinusoidalOscillator.h"
+#include "Trajectory.h"
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
 
@@ -55,7 +56,7 @@ class ModularRobotEvalOp : public EvaluateOp
         ConfigParser configParser;
         std::vector<Oscillator *> oscillators;
         ModularRobotInterface * robotInterface;
-        std::vector<float> joint_values;
+        Trajectory trajectory;
 
         int n_modules;
         unsigned long max_runtime;
@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+//-- benchmark-controller
+//------------------------------------------------------------------------------
+//--
+//-- Runs the modular robot controller several times and reports statistics
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#include "ModularRobot.h"
+#include "Profiler.hpp"
+
+using namespace hormodular;
+
+//-- Metrics compared between two result files: name and whether higher values are better
+struct ComparedMetric
+{
+    const char * name;
+    bool higher_is_better;
+};
+
+const ComparedMetric COMPARED_METRICS[] = {
+    { "throughput_mean", true },
+    { "step_latency_p50_us", false },
+    { "step_latency_p99_us", false },
+    { "distance_mean", true }
+};
+const int NUM_COMPARED_METRICS = sizeof(COMPARED_METRICS) / sizeof(COMPARED_METRICS[0]);
+
+double mean(const std::vector<double>& values)
+{
+    if ( values.empty() )
+        return 0;
+
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+//-- Sample standard deviation
+double stdev(const std::vector<double>& values)
+{
+    if ( values.size() < 2 )
+        return 0;
+
+    double m = mean(values);
+    double sq_sum = 0;
+    for (int i = 0; i < (int) values.size(); i++)
+        sq_sum += (values[i] - m) * (values[i] - m);
+
+    return std::sqrt(sq_sum / (values.size() - 1));
+}
+
+//-- Percentile (0-100) of sorted values, nearest-rank method
+double percentile(const std::vector<double>& sorted_values, double p)
+{
+    if ( sorted_values.empty() )
+        return 0;
+
+    int rank = (int) std::ceil(p / 100.0 * sorted_values.size());
+    rank = std::max(1, std::min(rank, (int) sorted_values.size()));
+    return sorted_values[rank - 1];
+}
+
+bool loadResults(const std::string& results_file, std::map<std::string, std::string>& results)
+{
+    std::ifstream file(results_file.c_str());
+    if ( !file.is_open() )
+    {
+        std::cerr << "[Benchmark] Error: could not open results file \"" << results_file << "\"" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while ( std::getline(file, line) )
+    {
+        if ( line.empty() || line[0] == '#' )
+            continue;
+
+        std::stringstream ss(line);
+        std::string key, value;
+        ss >> key;
+        std::getline(ss, value);
+        results[key] = value.substr(std::min(value.find_first_not_of(' '), value.size()));
+    }
+
+    return true;
+}
+
+//-- Compares two result files, returns the number of regressions found
+int compare(const std::string& baseline_file, const std::string& new_file, double tolerance)
+{
+    std::map<std::string, std::string> baseline, current;
+    if ( !loadResults(baseline_file, baseline) || !loadResults(new_file, current) )
+        return -1;
+
+    if ( baseline["config"] != current["config"] || baseline["run_time_ms"] != current["run_time_ms"] ||
+         baseline["step_ms"] != current["step_ms"] )
+        std::cout << "[Benchmark] Warning: results were obtained with different configurations" << std::endl;
+
+    std::cout << "Metric                   Baseline          New     Change" << std::endl
+              << "---------------------------------------------------------" << std::endl;
+
+    int regressions = 0;
+    for (int i = 0; i < NUM_COMPARED_METRICS; i++)
+    {
+        const std::string name = COMPARED_METRICS[i].name;
+        if ( baseline.find(name) == baseline.end() || current.find(name) == current.end() )
+        {
+            std::cout << name << ": missing" << std::endl;
+            continue;
+        }
+
+        double old_value = atof(baseline[name].c_str());
+        double new_value = atof(current[name].c_str());
+        double change = old_value != 0 ? 100.0 * (new_value - old_value) / std::fabs(old_value) : 0;
+
+        bool regression = COMPARED_METRICS[i].higher_is_better ? change < -tolerance : change > tolerance;
+        if ( regression )
+            regressions++;
+
+        std::cout.width(20);
+        std::cout << std::left << name << std::right << " ";
+        std::cout.width(12);
+        std::cout << old_value << " ";
+        std::cout.width(12);
+        std::cout << new_value << " ";
+        std::cout.width(10);
+        std::cout << change << "%" << ( regression ? "  REGRESSION" : "") << std::endl;
+    }
+
+    std::cout << std::endl << regressions << " regression(s) found (tolerance: " << tolerance << "%)" << std::endl;
+    return regressions;
+}
+
+int main(int argc, char * argv[] )
+{
+    //-- Compare mode
+    if ( argc >= 2 && std::string(argv[1]) == "--compare" )
+    {
+        if ( argc != 4 && argc != 5 )
+        {
+            std::cout << "Usage: benchmark-controller --compare (baseline results) (new results) [tolerance(%)=5]"
+                      << std::endl;
+            exit(-1);
+        }
+
+        double tolerance = argc == 5 ? atof(argv[4]) : 5;
+        int regressions = compare(argv[2], argv[3], tolerance);
+        return regressions == 0 ? 0 : 1;
+    }
+
+    //-- Extract data from arguments
+    if ( argc < 4 || argc > 7 )
+    {
+        std::cout << "Usage: benchmark-controller (config file) (run time(ms)) (runs) [simulation step(ms)=0.25ms] "
+                  << "[results file] [robot interface=simulated]" << std::endl
+                  << "       benchmark-controller --compare (baseline results) (new results) [tolerance(%)=5]"
+                  << std::endl;
+        exit(-1);
+    }
+
+    std::string config_file = argv[1];
+    int run_time = atoi(argv[2]);
+    int runs = atoi(argv[3]);
+    float step_time = argc >= 5 ? atof(argv[4]) : 0.25;
+    std::string results_file = argc >= 6 ? argv[5] : "";
+    std::string interface_type = argc >= 7 ? argv[6] : "simulated";
+
+    if ( run_time <= 0 || runs <= 0 )
+    {
+        std::cerr << "[Benchmark] Error: run time and number of runs must be positive" << std::endl;
+        return -1;
+    }
+
+    //-- Startup time (configuration, simulator and viewer loading):
+    uint64_t startup_start = Profiler::now();
+
+    //-- Load configuration on a ConfigParser
+    hormodular::ConfigParser configParser;
+    if ( configParser.parse(config_file) != 0)
+    {
+        std::cerr << "[Benchmark] Error: error parsing xml config file!" << std::endl;
+        return -1;
+    }
+
+    //-- Create robot:
+    hormodular::ModularRobot myRobot(configParser.getRobotDescription(), interface_type);
+    if ( !myRobot.setTimeStep(step_time) )
+        return -1;
+
+    myRobot.reset();
+    double startup_time_ms = (Profiler::now() - startup_start) / 1e6;
+
+    std::cout << "Benchmark-Controller" << std::endl
+              << "------------------------------------" << std::endl;
+
+    std::vector<double> throughputs;
+    std::vector<double> distances;
+    std::vector<double> step_latencies_us;
+    unsigned long run_time_us = 1000 * (unsigned long) run_time;
+
+    for (int run = 0; run < runs; run++)
+    {
+        myRobot.reset();
+
+        uint64_t start = Profiler::now();
+
+        while ( myRobot.getElapsedTime() < run_time_us )
+        {
+            uint64_t step_start = Profiler::now();
+            myRobot.step();
+            step_latencies_us.push_back( (Profiler::now() - step_start) / 1000.0);
+        }
+
+        double real_time_s = (Profiler::now() - start) / 1e9;
+        throughputs.push_back( run_time / 1000.0 / real_time_s);
+        distances.push_back( myRobot.getTravelledDistance());
+
+        std::cout << "Run #" << run << ": distance travelled " << distances.back() << ", real time "
+                  << real_time_s << "s" << std::endl;
+    }
+
+    std::sort(step_latencies_us.begin(), step_latencies_us.end());
+
+    //-- Report
+    std::stringstream report;
+    report << "config " << config_file << std::endl
+           << "interface " << interface_type << std::endl
+           << "runs " << runs << std::endl
+           << "run_time_ms " << run_time << std::endl
+           << "step_ms " << step_time << std::endl
+           << "startup_time_ms " << startup_time_ms << std::endl
+           << "throughput_mean " << mean(throughputs) << std::endl
+           << "throughput_stdev " << stdev(throughputs) << std::endl
+           << "step_latency_p50_us " << percentile(step_latencies_us, 50) << std::endl
+           << "step_latency_p90_us " << percentile(step_latencies_us, 90) << std::endl
+           << "step_latency_p99_us " << percentile(step_latencies_us, 99) << std::endl
+           << "step_latency_p999_us " << percentile(step_latencies_us, 99.9) << std::endl
+           << "step_latency_max_us " << percentile(step_latencies_us, 100) << std::endl
+           << "distance_mean " << mean(distances) << std::endl
+           << "distance_stdev " << stdev(distances) << std::endl
+           << "distance_min " << *std::min_element(distances.begin(), distances.end()) << std::endl
+           << "distance_max " << *std::max_element(distances.begin(), distances.end()) << std::endl;
+
+    std::cout << std::endl << "Statistics report" << std::endl
+              << "-----------------------------------------" << std::endl
+              << "(throughput in simulated seconds per real second)" << std::endl
+              << report.str() << std::endl;
+
+    if ( !results_file.empty() )
+    {
+        std::ofstream file(results_file.c_str());
+        if ( !file.is_open() )
+        {
+            std::cerr << "[Benchmark] Error: could not open results file \"" << results_file << "\"" << std::endl;
+            return -1;
+        }
+
+        file << "# benchmark-controller results" << std::endl << report.str();
+        std::cout << "Results saved to: " << results_file << std::endl;
+    }
+
+    std::cout << "Finished!" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+//-- compile-robot-configs
+//------------------------------------------------------------------------------
+//--
+//-- Parses robot configuration files and saves their cached binary version,
+//-- that is loaded by ConfigParser instead of the XML file while it does not
+//-- change
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "ConfigParser.h"
+
+using namespace hormodular;
+
+//-- Returns the XML files of a folder, sorted by name
+std::vector<std::string> getXMLFiles(const std::string& folder)
+{
+    std::vector<std::string> files;
+
+    DIR * dir = opendir(folder.c_str());
+    if ( !dir )
+    {
+        std::cerr << "[CompileRobotConfigs] Error: could not open folder \"" << folder << "\"" << std::endl;
+        return files;
+    }
+
+    struct dirent * entry;
+    while ( (entry = readdir(dir)) != NULL )
+    {
+        std::string name = entry->d_name;
+        if ( name.size() > 4 && name.compare(name.size() - 4, 4, ".xml") == 0 )
+            files.push_back(folder + "/" + name);
+    }
+    closedir(dir);
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    if ( argc < 2 )
+    {
+        std::cout << "Usage: compile-robot-configs (config file or folder) [(config file or folder) ...]" << std::endl;
+        exit(-1);
+    }
+
+    std::vector<std::string> config_files;
+    for (int i = 1; i < argc; i++)
+    {
+        struct stat info;
+        if ( stat(argv[i], &info) == 0 && S_ISDIR(info.st_mode) )
+        {
+            std::vector<std::string> folder_files = getXMLFiles(argv[i]);
+            config_files.insert(config_files.end(), folder_files.begin(), folder_files.end());
+        }
+        else
+        {
+            config_files.push_back(argv[i]);
+        }
+    }
+
+    //-- Parse each file from the XML (ignoring outdated caches) and save its cache
+    ConfigParser configParser;
+    configParser.setCacheEnabled(false);
+
+    int errors = 0;
+    for (int i = 0; i < (int) config_files.size(); i++)
+    {
+        std::string cache_file = ConfigParser::getCacheFile(config_files[i]);
+
+        if ( configParser.parse(config_files[i]) != 0 || !configParser.saveCache(cache_file) )
+        {
+            std::cerr << "[CompileRobotConfigs] Error: could not compile \"" << config_files[i] << "\"" << std::endl;
+            errors++;
+            continue;
+        }
+
+        std::cout << config_files[i] << " -> " << cache_file << std::endl;
+    }
+
+    std::cout << "Compiled: " << config_files.size() - errors << " (" << errors << " errors)" << std::endl;
+
+    return errors == 0 ? 0 : 1;
+}
@@ -25,8 +25,11 @@ int main(int argc, char * argv[] )
 {
     //-- Extract data from arguments
     std::string config_file;
+    std::string trace_file;
+    std::string recording_file;
     int run_time;
     float step_time;
+    std::string substeps = "1";
 
     if ( argc == 3 )
     {
@@ -34,18 +37,33 @@ int main(int argc, char * argv[] )
         run_time = atoi (argv[2] );
         step_time = 0.25;
     }
-    else if ( argc == 4)
+    else if ( argc >= 4 && argc <= 7)
     {
         config_file = argv[1];
         run_time = atoi (argv[2] );
         step_time = atof(argv[3]);
+
+        if ( argc >= 5 && std::string(argv[4]) != "-")
+            trace_file = argv[4];
+
+        if ( argc >= 6 && std::string(argv[5]) != "-")
+            recording_file = argv[5];
+
+        if ( argc == 7)
+            substeps = argv[6];
     }
     else
     {
-        std::cout << "Usage: evaluate-gaits-sim (config file) (run time(ms)) [simulation step(ms)=2ms]" << std::endl;
+        std::cout << "Usage: evaluate-controller-sim (config file) (run time(ms)) [simulation step(ms)=0.25ms] "
+                  << "[trace file (chrome trace-event json) or -] [recording file (.gz to compress) or -] "
+                  << "[physics substeps per step=1]" << std::endl;
         exit(-1);
     }
 
+    //-- Startup time (configuration, simulator and viewer loading):
+    struct timeval startup_starttime, startup_endtime;
+    gettimeofday( &startup_starttime, NULL);
+
     //-- Load configuration on a ConfigParser
     hormodular::ConfigParser configParser;
     if ( configParser.parse(config_file) != 0)
@@ -55,9 +73,11 @@ int main(int argc, char * argv[] )
     }
 
     //-- Create robot:
-    hormodular::ModularRobot myRobot(configParser);
+    hormodular::ModularRobot myRobot(configParser.getRobotDescription());
     myRobot.setTimeStep(step_time);
     myRobot.setProperty("viewer", "enabled");
+    if ( !myRobot.setProperty("substeps", substeps) )
+        return -1;
 
 
     std::cout << "Evaluate-Gaits (simulated version)" << std::endl
@@ -66,6 +86,18 @@ int main(int argc, char * argv[] )
     //-- Reset robot:
     myRobot.reset();
 
+    if ( !recording_file.empty() && !myRobot.setProperty("recording", recording_file) )
+        return -1;
+
+    gettimeofday( &startup_endtime, NULL);
+    std::cout << "Startup time: " << (startup_endtime.tv_sec - startup_starttime.tv_sec) * 1000.0
+                                     + (startup_endtime.tv_usec - startup_starttime.tv_usec) / 1000.0 << "ms" << std::endl;
+
+    //-- Per-phase timing (only available if compiled with ENABLE_PROFILING):
+    hormodular::Profiler::reset();
+    if ( !trace_file.empty() )
+        hormodular::Profiler::enableTrace(true);
+
     //-- Testing timing:
     struct timeval starttime, endtime;
     gettimeofday( &starttime, NULL);
@@ -90,6 +122,18 @@ int main(int argc, char * argv[] )
     std::cout << "Real time elapsed: " << sec_diff << "s " << usec_diff << "us " << std::endl;
     std::cout << std::endl;
 
+    if ( !recording_file.empty() )
+    {
+        myRobot.setProperty("recording", "disabled");
+        std::cout << "Recording saved to: " << recording_file << std::endl;
+    }
+
+    hormodular::Profiler::printSummary(std::cout);
+    if ( !trace_file.empty() && hormodular::Profiler::isEnabled() )
+        if ( hormodular::Profiler::saveTrace(trace_file) )
+            std::cout << "Trace saved to: " << trace_file << std::endl;
+    std::cout << std::endl;
+
     std::cout << "Finished!" << std::endl;
 
     return 0;
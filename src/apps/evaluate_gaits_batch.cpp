@@ -0,0 +1,528 @@
+//------------------------------------------------------------------------------
+//-- evaluate-gaits-batch
+//------------------------------------------------------------------------------
+//--
+//-- Evaluates many gait tables on simulated robots in a single process
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <sys/time.h>
+#include <boost/thread.hpp>
+
+#include "ConfigParser.h"
+#include "GaitTable.h"
+#include "SinusoidalOscillator.h"
+#include "SimulatedModularRobotInterface.hpp"
+
+using namespace hormodular;
+
+//-- One line of the manifest
+struct BatchJob
+{
+    std::string config_file;
+    std::string gait_table_file;
+    float frequency;
+    int run_time;
+    float timestep;
+};
+
+struct BatchResult
+{
+    bool ok;
+    std::string error;
+    float distance;
+    //! Wall time of the simulation of its group of jobs, divided by the jobs evaluated in the group
+    double real_time_s;
+};
+
+//-- State shared between the worker threads
+struct BatchState
+{
+    std::vector<BatchJob> jobs;
+    std::vector<BatchResult> results;
+    int robots_per_env;
+    float max_speed;
+    int next_job;
+    int finished_jobs;
+    boost::mutex mutex;
+};
+
+//-- OpenRAVE environments are created one at a time
+boost::mutex creation_mutex;
+
+std::string trim(const std::string& str)
+{
+    size_t first = str.find_first_not_of(" \t\r\n");
+    if ( first == std::string::npos )
+        return "";
+
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, last - first + 1);
+}
+
+//-- Loads a manifest with one evaluation per line:
+//--     config file, gait table, frequency, run time(ms) [, simulation step(ms)]
+//-- Fields are separated by commas (paths may contain spaces), '#' starts a comment
+bool loadManifest(const std::string& manifest_file, std::vector<BatchJob>& jobs)
+{
+    std::ifstream file(manifest_file.c_str());
+    if ( !file.is_open() )
+    {
+        std::cerr << "[Batch] Error: could not open manifest file \"" << manifest_file << "\"" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while ( std::getline(file, line) )
+    {
+        line_number++;
+
+        size_t comment = line.find('#');
+        if ( comment != std::string::npos )
+            line = line.substr(0, comment);
+
+        line = trim(line);
+        if ( line.empty() )
+            continue;
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while ( std::getline(ss, field, ',') )
+            fields.push_back(trim(field));
+
+        if ( fields.size() != 4 && fields.size() != 5 )
+        {
+            std::cerr << "[Batch] Error: line " << line_number << " of manifest should have 4 or 5 fields, found "
+                      << fields.size() << std::endl;
+            return false;
+        }
+
+        BatchJob job;
+        job.config_file = fields[0];
+        job.gait_table_file = fields[1];
+        job.frequency = atof(fields[2].c_str());
+        job.run_time = atoi(fields[3].c_str());
+        job.timestep = fields.size() == 5 ? atof(fields[4].c_str()) : 0.25;
+
+        if ( job.frequency <= 0 || job.run_time <= 0 || job.timestep <= 0 )
+        {
+            std::cerr << "[Batch] Error: line " << line_number << " of manifest has non-positive values" << std::endl;
+            return false;
+        }
+
+        jobs.push_back(job);
+    }
+
+    return true;
+}
+
+//-- Each worker keeps its own robots and gait tables, reused between evaluations
+struct WorkerCache
+{
+    std::map<std::string, ConfigParser> configParsers;
+    std::map<std::string, SimulatedModularRobotInterface *> robotInterfaces;
+    std::map<std::string, GaitTable *> gaitTables;
+};
+
+//-- Jobs that can share a simulation environment (same robot and same timing)
+bool canBeBatched(const BatchJob& a, const BatchJob& b)
+{
+    return a.config_file == b.config_file && a.run_time == b.run_time && a.timestep == b.timestep;
+}
+
+void deleteOscillators(std::vector<Oscillator *>& oscillators)
+{
+    for (int i = 0; i < (int) oscillators.size(); i++)
+        delete oscillators[i];
+    oscillators.clear();
+}
+
+//-- Evaluates a group of compatible jobs at the same time, each one on its own copy of the robot
+std::vector<BatchResult> evaluate(const std::vector<BatchJob>& jobs, int robots_per_env, float max_speed,
+                                  WorkerCache& cache)
+{
+    BatchResult failed_result;
+    failed_result.ok = false;
+    failed_result.distance = 0;
+    failed_result.real_time_s = 0;
+    std::vector<BatchResult> results(jobs.size(), failed_result);
+
+    const BatchJob& job = jobs.front();
+
+    //-- The copies of the robot collide with each other, so they are separated by more than what two
+    //-- of them can travel towards each other during the run
+    double max_travel = max_speed * job.run_time / 1000.0;
+    double copies_gap = 2 * max_travel;
+
+    //-- Load configuration (only the first time it is used)
+    if ( cache.configParsers.find(job.config_file) == cache.configParsers.end() )
+    {
+        ConfigParser configParser;
+        if ( configParser.parse(job.config_file) != 0)
+        {
+            for (int i = 0; i < (int) results.size(); i++)
+                results[i].error = "could not parse config file";
+            return results;
+        }
+
+        cache.configParsers[job.config_file] = configParser;
+    }
+
+    //-- Load the robot (again only if the copies are too close for this run time)
+    std::map<std::string, SimulatedModularRobotInterface *>::iterator cached = cache.robotInterfaces.find(job.config_file);
+    if ( cached == cache.robotInterfaces.end() || cached->second->getCopiesGap() < copies_gap )
+    {
+        boost::mutex::scoped_lock lock(creation_mutex);
+        if ( cached != cache.robotInterfaces.end() )
+        {
+            cached->second->destroy();
+            delete cached->second;
+        }
+
+        cache.robotInterfaces[job.config_file] = new SimulatedModularRobotInterface(
+                    cache.configParsers[job.config_file].getRobotDescription(), robots_per_env, copies_gap);
+    }
+
+    ConfigParser& configParser = cache.configParsers[job.config_file];
+    SimulatedModularRobotInterface * robotInterface = cache.robotInterfaces[job.config_file];
+
+    //-- Create sinusoidal oscillators with the gait table parameters of each job.
+    //-- Unused robot copies (if the group is smaller) stay still on their place
+    std::vector<std::vector<Oscillator *> > oscillators(robotInterface->getNumRobots());
+    std::vector<unsigned long> ids = configParser.getShapeIDs();
+    for (int j = 0; j < (int) jobs.size(); j++)
+    {
+        //-- Load gait table
+        if ( cache.gaitTables.find(jobs[j].gait_table_file) == cache.gaitTables.end() )
+            cache.gaitTables[jobs[j].gait_table_file] = new GaitTable(jobs[j].gait_table_file);
+
+        GaitTable * gaitTable = cache.gaitTables[jobs[j].gait_table_file];
+        if ( gaitTable->getIDs().empty() )
+        {
+            results[j].error = "could not load gait table";
+            continue;
+        }
+
+        for ( int i = 0; i < configParser.getNumModules(); i++)
+        {
+            std::vector<float> parameters;
+            if ( gaitTable->hasID(ids[i]) )
+                parameters = gaitTable->getParameters(ids[i]);
+
+            //-- Amplitude, offset and phase are required
+            if ( parameters.size() < 3 )
+            {
+                std::stringstream error;
+                error << "ID " << ids[i] << " not found on gait table (or less than 3 parameters)";
+                results[j].error = error.str();
+                deleteOscillators(oscillators[j]);
+                break;
+            }
+
+            oscillators[j].push_back(new SinusoidalOscillator(parameters[0], parameters[1], parameters[2],
+                                                              1000/jobs[j].frequency));
+        }
+    }
+
+    std::vector<std::vector<float> > joint_values(robotInterface->getNumRobots(),
+                                                  std::vector<float>(configParser.getNumModules(), 0));
+
+    //-- Time track:
+    struct timeval starttime, endtime;
+    gettimeofday( &starttime, NULL);
+
+    //-- Run the robots from their initial position
+    bool run_ok = robotInterface->reset();
+    std::string run_error = "could not reset the simulation";
+
+    unsigned long elapsed_time = 0; //-- Should be in uS
+    unsigned long max_time_us = job.run_time*1000;
+
+    while( run_ok && elapsed_time < max_time_us )
+    {
+        for ( int j = 0; j < (int) oscillators.size(); j++)
+            for ( int i = 0; i < (int) oscillators[j].size(); i++)
+                joint_values[j][i] = oscillators[j][i]->calculatePos(elapsed_time);
+
+        if ( !robotInterface->sendJointValues(joint_values, job.timestep) )
+        {
+            run_ok = false;
+            run_error = "could not send the joint values";
+        }
+
+        elapsed_time+=(unsigned long) (job.timestep*1000);
+    }
+
+    std::vector<float> distances = robotInterface->getTravelledDistances();
+
+    gettimeofday(&endtime, NULL);
+    double real_time_s = (endtime.tv_sec - starttime.tv_sec) + (endtime.tv_usec - starttime.tv_usec) / 1e6;
+
+    //-- The wall time of the group is shared between the jobs evaluated on it
+    int evaluated_jobs = 0;
+    for (int j = 0; j < (int) jobs.size(); j++)
+        if ( !oscillators[j].empty() )
+            evaluated_jobs++;
+
+    for (int j = 0; j < (int) jobs.size(); j++)
+    {
+        if ( oscillators[j].empty() )
+            continue;
+
+        if ( !run_ok )
+            results[j].error = run_error;
+        else if ( robotInterface->getNumRobots() > 1 && distances[j] > max_travel )
+        {
+            //-- Faster than the speed the copies were separated for: it may have hit its neighbours
+            std::stringstream error;
+            error << "travelled " << distances[j] << "m, more than the " << max_travel << "m allowed by the "
+                  << "maximum speed (copies may have collided)";
+            results[j].error = error.str();
+        }
+        else
+        {
+            results[j].ok = true;
+            results[j].distance = distances[j];
+            results[j].real_time_s = real_time_s / evaluated_jobs;
+        }
+
+        deleteOscillators(oscillators[j]);
+    }
+
+    return results;
+}
+
+void worker(BatchState * state)
+{
+    WorkerCache cache;
+
+    while ( true )
+    {
+        //-- Take the next job and the following ones that can be evaluated on the same environment
+        int first, last;
+        {
+            boost::mutex::scoped_lock lock(state->mutex);
+            if ( state->next_job >= (int) state->jobs.size() )
+                break;
+
+            first = state->next_job;
+            last = first + 1;
+            while ( last < (int) state->jobs.size() && last - first < state->robots_per_env &&
+                    canBeBatched(state->jobs[first], state->jobs[last]) )
+                last++;
+
+            state->next_job = last;
+        }
+
+        std::vector<BatchJob> jobs(state->jobs.begin() + first, state->jobs.begin() + last);
+        std::vector<BatchResult> results = evaluate(jobs, state->robots_per_env, state->max_speed, cache);
+
+        boost::mutex::scoped_lock lock(state->mutex);
+        for (int index = first; index < last; index++)
+        {
+            const BatchResult& result = results[index - first];
+            state->results[index] = result;
+            state->finished_jobs++;
+
+            std::cout << "[Batch] (" << state->finished_jobs << "/" << state->jobs.size() << ") "
+                      << state->jobs[index].gait_table_file << " on " << state->jobs[index].config_file << ": ";
+            if ( result.ok )
+                std::cout << "distance travelled " << result.distance << std::endl;
+            else
+                std::cout << "error, " << result.error << std::endl;
+        }
+    }
+
+    //-- Cleanup
+    for ( std::map<std::string, SimulatedModularRobotInterface *>::iterator it = cache.robotInterfaces.begin();
+          it != cache.robotInterfaces.end(); ++it)
+    {
+        boost::mutex::scoped_lock lock(creation_mutex);
+        it->second->destroy();
+        delete it->second;
+    }
+
+    for ( std::map<std::string, GaitTable *>::iterator it = cache.gaitTables.begin(); it != cache.gaitTables.end(); ++it)
+        delete it->second;
+}
+
+std::string jsonEscape(const std::string& str)
+{
+    std::string escaped;
+    for (int i = 0; i < (int) str.size(); i++)
+    {
+        if ( str[i] == '"' || str[i] == '\\')
+            escaped += '\\';
+        escaped += str[i];
+    }
+    return escaped;
+}
+
+std::string csvEscape(const std::string& str)
+{
+    if ( str.find_first_of(",\"") == std::string::npos )
+        return str;
+
+    std::string escaped = "\"";
+    for (int i = 0; i < (int) str.size(); i++)
+    {
+        if ( str[i] == '"' )
+            escaped += '"';
+        escaped += str[i];
+    }
+    return escaped + "\"";
+}
+
+bool saveResults(const std::string& output_file, const BatchState& state)
+{
+    std::ofstream file(output_file.c_str());
+    if ( !file.is_open() )
+    {
+        std::cerr << "[Batch] Error: could not open output file \"" << output_file << "\"" << std::endl;
+        return false;
+    }
+
+    bool json = output_file.size() >= 5 && output_file.substr(output_file.size() - 5) == ".json";
+
+    if ( json )
+        file << "[" << std::endl;
+    else
+        file << "config,gait_table,frequency,run_time,timestep,status,distance,real_time_s" << std::endl;
+
+    for (int i = 0; i < (int) state.jobs.size(); i++)
+    {
+        const BatchJob& job = state.jobs[i];
+        const BatchResult& result = state.results[i];
+        std::string status = result.ok ? "ok" : result.error;
+
+        if ( json )
+        {
+            file << "  {\"config\": \"" << jsonEscape(job.config_file) << "\", "
+                 << "\"gait_table\": \"" << jsonEscape(job.gait_table_file) << "\", "
+                 << "\"frequency\": " << job.frequency << ", "
+                 << "\"run_time\": " << job.run_time << ", "
+                 << "\"timestep\": " << job.timestep << ", "
+                 << "\"status\": \"" << jsonEscape(status) << "\", "
+                 << "\"distance\": " << result.distance << ", "
+                 << "\"real_time_s\": " << result.real_time_s << "}"
+                 << ( i + 1 < (int) state.jobs.size() ? "," : "") << std::endl;
+        }
+        else
+        {
+            file << csvEscape(job.config_file) << "," << csvEscape(job.gait_table_file) << ","
+                 << job.frequency << "," << job.run_time << "," << job.timestep << ","
+                 << csvEscape(status) << "," << result.distance << "," << result.real_time_s << std::endl;
+        }
+    }
+
+    if ( json )
+        file << "]" << std::endl;
+
+    return true;
+}
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    std::string manifest_file, output_file;
+    int num_threads = 1;
+    int robots_per_env = 1;
+    float max_speed = 0.25;
+
+    if ( argc >= 3 && argc <= 6 )
+    {
+        manifest_file = argv[1];
+        output_file = argv[2];
+
+        if ( argc >= 4 )
+            num_threads = atoi(argv[3]);
+
+        if ( argc >= 5 )
+            robots_per_env = atoi(argv[4]);
+
+        if ( argc == 6 )
+            max_speed = atof(argv[5]);
+    }
+
+    if ( manifest_file.empty() || num_threads < 1 || robots_per_env < 1 || max_speed <= 0 )
+    {
+        std::cout << "Usage: evaluate-gaits-batch (manifest file) (output file (.csv or .json)) [threads=1] "
+                  << "[robots per environment=1] [max robot speed(m/s)=0.25]" << std::endl
+                  << std::endl
+                  << "Each line of the manifest contains a comma-separated evaluation:" << std::endl
+                  << "    config file, gait table, frequency, run time(ms) [, simulation step(ms)=0.25ms]" << std::endl
+                  << std::endl
+                  << "The copies of the robot on an environment are separated by their size plus twice the distance"
+                  << std::endl
+                  << "a robot travels at the max speed; evaluations that exceed it are reported as failed." << std::endl
+                  << "real_time_s is the wall time of each environment divided by the evaluations run on it." << std::endl;
+        exit(-1);
+    }
+
+    BatchState state;
+    if ( !loadManifest(manifest_file, state.jobs) )
+        return -1;
+
+    BatchResult empty_result;
+    empty_result.ok = false;
+    empty_result.error = "not evaluated";
+    empty_result.distance = 0;
+    empty_result.real_time_s = 0;
+    state.results.assign(state.jobs.size(), empty_result);
+    state.robots_per_env = robots_per_env;
+    state.max_speed = max_speed;
+    state.next_job = 0;
+    state.finished_jobs = 0;
+
+    std::cout << "Evaluate-Gaits (batch simulated version)" << std::endl
+              << "------------------------------------" << std::endl
+              << "[Batch] " << state.jobs.size() << " evaluations on " << num_threads << " thread(s), "
+              << robots_per_env << " robot(s) per environment" << std::endl;
+
+    //-- Time track:
+    struct timeval starttime, endtime;
+    gettimeofday( &starttime, NULL);
+
+    //-- Run all the evaluations
+    boost::thread_group workers;
+    for (int i = 0; i < num_threads; i++)
+        workers.create_thread(boost::bind(&worker, &state));
+    workers.join_all();
+
+    gettimeofday(&endtime, NULL);
+    double real_time_s = (endtime.tv_sec - starttime.tv_sec) + (endtime.tv_usec - starttime.tv_usec) / 1e6;
+
+    int failed = 0;
+    for (int i = 0; i < (int) state.results.size(); i++)
+        if ( !state.results[i].ok )
+            failed++;
+
+    std::cout << std::endl;
+    std::cout << "Evaluations: " << state.jobs.size() << " (" << failed << " failed)" << std::endl;
+    std::cout << "Real time elapsed: " << real_time_s << "s" << std::endl;
+
+    if ( !saveResults(output_file, state) )
+        return -1;
+
+    std::cout << "Results saved to: " << output_file << std::endl;
+    std::cout << "Finished!" << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
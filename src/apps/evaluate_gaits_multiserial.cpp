@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//-- evaluate-gaits-multiserial
+//------------------------------------------------------------------------------
+//--
+//-- Evaluates the hormone controller on several real robots connected via
+//-- serial port, from a single process
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "ModularRobot.h"
+#include "SerialPortManager.hpp"
+
+//-- Runs the controller of a robot (one thread per robot)
+static void runRobot(hormodular::ModularRobot * robot, int run_time)
+{
+    robot->run(run_time);
+}
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    if ( argc < 4 )
+    {
+        std::cout << "Usage: evaluate-gaits-multiserial (run time(ms)) (step(ms)) (config file 1) "
+                  << "[config file 2 ...]" << std::endl;
+        exit(-1);
+    }
+
+    int run_time = atoi(argv[1]);
+    float step_time = atof(argv[2]);
+
+    //-- Load the configuration of each robot (each one with its serial port)
+    std::vector<hormodular::ConfigParser> configParsers(argc - 3);
+    for (int i = 0; i < (int) configParsers.size(); i++)
+    {
+        if ( configParsers[i].parse(argv[i + 3]) != 0)
+        {
+            std::cerr << "[Evaluate] Error: error parsing xml config file " << argv[i + 3] << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << "Evaluate-Gaits (multiserial version)" << std::endl
+              << "------------------------------------" << std::endl;
+
+    //-- Create the robots, all their ports handled by the shared SerialPortManager
+    std::vector<hormodular::ModularRobot *> robots;
+    for (int i = 0; i < (int) configParsers.size(); i++)
+    {
+        hormodular::ModularRobot * robot = new hormodular::ModularRobot(configParsers[i].getRobotDescription(),
+                                                                        "multiserial");
+        robot->setTimeStep(step_time);
+        robot->reset();
+        robots.push_back(robot);
+    }
+
+    //-- Run the controllers in parallel
+    boost::thread_group threads;
+    for (int i = 0; i < (int) robots.size(); i++)
+        threads.create_thread(boost::bind(&runRobot, robots[i], run_time));
+    threads.join_all();
+
+    //-- Report the statistics of each port
+    std::cout << "Robot time elapsed: " << run_time << std::endl << std::endl;
+    hormodular::SerialPortManager::getSharedManager().printStats(std::cout);
+    std::cout << std::endl;
+
+    for (int i = 0; i < (int) robots.size(); i++)
+        delete robots[i];
+
+    std::cout << "Finished!" << std::endl;
+
+    return 0;
+}
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "ModularRobot.h"
+#include "RealTime.hpp"
 
 
 int main(int argc, char * argv[] )
@@ -27,6 +28,7 @@ int main(int argc, char * argv[] )
     std::string config_file;
     int run_time;
     float step_time;
+    int realtime_cpu = -1;
 
     if ( argc == 3 )
     {
@@ -34,15 +36,19 @@ int main(int argc, char * argv[] )
         run_time = atoi (argv[2] );
         step_time = 0.25;
     }
-    else if ( argc == 4)
+    else if ( argc == 4 || argc == 5)
     {
         config_file = argv[1];
         run_time = atoi (argv[2] );
         step_time = atof(argv[3]);
+
+        if ( argc == 5 )
+            realtime_cpu = atoi(argv[4]);
     }
     else
     {
-        std::cout << "Usage: evaluate-gaits-serial (config file) (run time(ms)) [simulation step(ms)=2ms]" << std::endl;
+        std::cout << "Usage: evaluate-gaits-serial (config file) (run time(ms)) [simulation step(ms)=2ms] "
+                  << "[realtime cpu (-1: disabled)=-1]" << std::endl;
         exit(-1);
     }
 
@@ -55,12 +61,20 @@ int main(int argc, char * argv[] )
     }
 
     //-- Create robot:
-    hormodular::ModularRobot myRobot(configParser, "serial");
+    hormodular::ModularRobot myRobot(configParser.getRobotDescription(), "serial");
     myRobot.setTimeStep(step_time);
 
     std::cout << "Evaluate-Gaits (serial version)" << std::endl
               << "------------------------------------" << std::endl;
 
+    //-- Real-time mode: the control thread is pinned to a CPU, with SCHED_FIFO priority and locked memory
+    if ( realtime_cpu >= 0 )
+    {
+        hormodular::RealTime::enable(realtime_cpu);
+        hormodular::RealTime::printStatus();
+        myRobot.setProperty("realtime", "enabled");
+    }
+
     //-- Reset robot:
     myRobot.reset();
 
@@ -88,6 +102,13 @@ int main(int argc, char * argv[] )
     std::cout << "Real time elapsed: " << sec_diff << "s " << usec_diff << "us " << std::endl;
     std::cout << std::endl;
 
+    if ( realtime_cpu >= 0 )
+    {
+        myRobot.getJitterStats().print(std::cout);
+        std::cout << std::endl;
+        hormodular::RealTime::disable();
+    }
+
     std::cout << "Finished!" << std::endl;
 
     return 0;
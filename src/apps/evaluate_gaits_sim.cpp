@@ -18,10 +18,12 @@
 
 #include <iostream>
 #include <string>
+#include <algorithm>
 
 #include "ModularRobot.h"
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
+#include "Trajectory.h"
 
 using namespace hormodular;
 
@@ -55,6 +57,10 @@ int main(int argc, char * argv[] )
         exit(-1);
     }
 
+    //-- Startup time (configuration, simulator and viewer loading):
+    struct timeval startup_starttime, startup_endtime;
+    gettimeofday( &startup_starttime, NULL);
+
     //-- Load configuration on a ConfigParser
     hormodular::ConfigParser configParser;
     if ( configParser.parse(config_file) != 0)
@@ -75,21 +81,24 @@ int main(int argc, char * argv[] )
             oscillators.push_back(new SinusoidalOscillator(parameters[0], parameters[1], parameters[2],1000/frequency));
     }
 
-    //-- Create joints
-    std::vector<float> joint_values;
+    //-- Precompute the joint trajectory
+    Trajectory trajectory;
+    if ( !trajectory.compute(oscillators, timestep, run_time*1000) )
+        return -1;
 
     //-- Create robot
-    ModularRobotInterface * robotInterface = createModularRobotInterface( "simulated", configParser);
+    ModularRobotInterface * robotInterface = createModularRobotInterface( "simulated",
+                                                                          configParser.getRobotDescription());
     robotInterface->reset();
     robotInterface->setProperty("viewer", "enabled");
 
-    //-- Joint values set to 0:
-    for ( int i = 0; i < configParser.getNumModules(); i++)
-        joint_values.push_back(0);
-
     std::cout << "Evaluate-Gaits (simulated version)" << std::endl
               << "------------------------------------" << std::endl;
 
+    gettimeofday( &startup_endtime, NULL);
+    std::cout << "Startup time: " << (startup_endtime.tv_sec - startup_starttime.tv_sec) * 1000.0
+                                     + (startup_endtime.tv_usec - startup_starttime.tv_usec) / 1000.0 << "ms" << std::endl;
+
     //-- Time track:
     struct timeval starttime, endtime;
     gettimeofday( &starttime, NULL);
@@ -97,20 +106,17 @@ int main(int argc, char * argv[] )
     //-- Run the robot:
     std::cout << "[Evaluate] Run!" << std::endl;
 
-    //-- Here you put the main loop
-    unsigned long elapsed_time = 0; //-- Should be in uS
-    unsigned long max_time_us = run_time*1000;
-
-    while( elapsed_time < max_time_us )
+    //-- Here you put the main loop (the trajectory is sent one buffer at a time)
+    for ( int step = 0; step < trajectory.getNumSteps(); step += trajectory.getBufferedSteps())
     {
-        //-- Update joint values
-        for ( int i = 0; i < (int) oscillators.size(); i++)
-            joint_values[i] = oscillators[i]->calculatePos(elapsed_time);
-
-        //-- Send joint values
-        robotInterface->sendJointValues(joint_values, timestep);
-
-        elapsed_time+=(unsigned long) (timestep*1000);
+        int batch_steps = std::min(trajectory.getBufferedSteps(), trajectory.getNumSteps() - step);
+        if ( !robotInterface->sendJointTrajectory(trajectory, step, batch_steps, timestep) )
+        {
+            std::cerr << "[Evaluate] Error: could not send the trajectory (step " << step << ")" << std::endl;
+            robotInterface->destroy();
+            delete robotInterface;
+            return -1;
+        }
     }
 
 
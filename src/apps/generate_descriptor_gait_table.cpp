@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//-- generate-descriptor-gait-table
+//------------------------------------------------------------------------------
+//--
+//-- Converts a gait table indexed by base-17 module IDs to a gait table indexed
+//-- by topology descriptor IDs, for a given robot configuration
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "ConfigParser.h"
+#include "Module.hpp"
+#include "IdSolver.hpp"
+#include "GaitTable.h"
+
+using namespace hormodular;
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    if ( argc != 4 && argc != 5 )
+    {
+        std::cout << "Usage: generate-descriptor-gait-table (config file) (base-17 gait table) (output gait table) "
+                  << "[descriptor depth=" << Module::DEFAULT_DESCRIPTOR_DEPTH << "]" << std::endl;
+        exit(-1);
+    }
+
+    std::string config_file = argv[1];
+    std::string gait_table_file = argv[2];
+    std::string output_file = argv[3];
+    int depth = argc == 5 ? atoi(argv[4]) : Module::DEFAULT_DESCRIPTOR_DEPTH;
+
+    if ( depth < 1 )
+    {
+        std::cerr << "[GenerateDescriptorGaitTable] Error: descriptor depth must be at least 1" << std::endl;
+        return -1;
+    }
+
+    ConfigParser configParser;
+    if ( configParser.parse(config_file) != 0)
+    {
+        std::cerr << "[GenerateDescriptorGaitTable] Error: error parsing xml config file!" << std::endl;
+        return -1;
+    }
+
+    GaitTable gaitTable(gait_table_file);
+    RobotDescriptionPtr robotDescription = configParser.getRobotDescription();
+
+    //-- IDs with the current encoding and with descriptors, once the hormone exchange has converged
+    IdSolver idSolver(robotDescription);
+    if ( !idSolver.solve(Module::BASE17_ID) )
+        return -1;
+    std::vector<unsigned long> base17_ids = idSolver.getIDs();
+
+    idSolver.solve(Module::DESCRIPTOR_ID, depth);
+    std::vector<unsigned long> descriptor_ids = idSolver.getIDs();
+
+    //-- Modules with different base-17 IDs must get different descriptors
+    std::map<unsigned long, unsigned long> base17_by_descriptor;
+    for (int i = 0; i < (int) descriptor_ids.size(); i++)
+    {
+        std::map<unsigned long, unsigned long>::iterator it = base17_by_descriptor.find(descriptor_ids[i]);
+        if ( it == base17_by_descriptor.end() )
+            base17_by_descriptor[descriptor_ids[i]] = base17_ids[i];
+        else if ( it->second != base17_ids[i] )
+        {
+            std::cerr << "[GenerateDescriptorGaitTable] Error: modules with IDs " << it->second << " and "
+                      << base17_ids[i] << " have the same descriptor with depth " << depth
+                      << ", try with a larger depth (if it is not enough, the modules are in symmetric positions"
+                      << " of the robot, which is not supported)" << std::endl;
+            return -1;
+        }
+    }
+
+    //-- Save gait table
+    std::ofstream file(output_file.c_str());
+    if ( !file.is_open() )
+    {
+        std::cerr << "[GenerateDescriptorGaitTable] Error: could not open \"" << output_file << "\"" << std::endl;
+        return -1;
+    }
+
+    file << "# Gait Table created by Hormodular [https://github.com/David-Estevez/hormodular.git]" << std::endl
+         << "# name: gaitTable" << std::endl
+         << "# type: matrix" << std::endl
+         << "# rows: " << base17_by_descriptor.size() << std::endl
+         << "# columns: " << gaitTable.getNumParameters() + 1 << std::endl
+         << "# descriptor depth: " << depth << std::endl;
+
+    int missing = 0;
+    for (std::map<unsigned long, unsigned long>::iterator it = base17_by_descriptor.begin();
+         it != base17_by_descriptor.end(); ++it)
+    {
+        if ( !gaitTable.hasID(it->second) )
+        {
+            std::cerr << "[GenerateDescriptorGaitTable] Warning: ID " << it->second << " not found on gait table"
+                      << std::endl;
+            missing++;
+            continue;
+        }
+
+        std::vector<float> parameters = gaitTable.getParameters(it->second);
+        file << it->first;
+        for (int i = 0; i < (int) parameters.size(); i++)
+            file << " " << parameters[i];
+        file << std::endl;
+    }
+
+    std::cout << "Descriptor depth: " << depth << std::endl
+              << "Entries saved: " << base17_by_descriptor.size() - missing << " (" << missing << " missing)"
+              << std::endl
+              << "Gait table saved to: " << output_file << std::endl;
+
+    return missing == 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+//-- generate-robot-config
+//------------------------------------------------------------------------------
+//--
+//-- Generates the configuration file, gait table and frequency table of a
+//-- synthetic robot (random tree or lattice) with any number of modules
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "RobotGenerator.hpp"
+
+using namespace hormodular;
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    if ( argc < 5 || argc > 7 )
+    {
+        std::cout << "Usage: generate-robot-config (tree|lattice) (num modules) (output folder) (robot name) "
+                  << "[seed=0] [descriptor depth=" << Module::DEFAULT_DESCRIPTOR_DEPTH << "]" << std::endl;
+        exit(-1);
+    }
+
+    RobotGenerator::Shape shape;
+    if ( !RobotGenerator::parseShape(argv[1], shape) )
+    {
+        std::cerr << "[GenerateRobotConfig] Error: unknown shape \"" << argv[1] << "\"" << std::endl;
+        return -1;
+    }
+
+    int num_modules = atoi(argv[2]);
+    std::string folder = argv[3];
+    std::string name = argv[4];
+    unsigned int seed = argc >= 6 ? strtoul(argv[5], NULL, 10) : 0;
+    int depth = argc == 7 ? atoi(argv[6]) : Module::DEFAULT_DESCRIPTOR_DEPTH;
+
+    if ( num_modules < 1 || depth < 1 )
+    {
+        std::cerr << "[GenerateRobotConfig] Error: number of modules and descriptor depth must be at least 1"
+                  << std::endl;
+        return -1;
+    }
+
+    RobotGenerator robotGenerator(shape, num_modules, seed);
+    if ( !robotGenerator.save(folder, name, depth) )
+    {
+        std::cerr << "[GenerateRobotConfig] Error: could not save robot \"" << name << "\"" << std::endl;
+        return -1;
+    }
+
+    std::cout << "Modules: " << robotGenerator.getNumModules() << std::endl
+              << "Gait table rows: " << robotGenerator.getNumGaitTableRows() << std::endl
+              << "Configuration saved to: " << RobotGenerator::getConfigFile(folder, name) << std::endl;
+
+    return 0;
+}
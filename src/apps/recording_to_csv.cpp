@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//-- recording-to-csv
+//------------------------------------------------------------------------------
+//--
+//-- Converts a recording of the modular robot execution to CSV files
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "RecordingReader.hpp"
+
+using namespace hormodular;
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    if ( argc != 3 )
+    {
+        std::cout << "Usage: recording-to-csv (recording file) (output prefix)" << std::endl
+                  << std::endl
+                  << "Creates (output prefix)_joints.csv, (output prefix)_modules.csv and "
+                  << "(output prefix)_timing.csv" << std::endl;
+        exit(-1);
+    }
+
+    std::string recording_file = argv[1];
+    std::string prefix = argv[2];
+
+    RecordingReader reader;
+    if ( !reader.open(recording_file) )
+        return -1;
+
+    std::ofstream joints_file((prefix + "_joints.csv").c_str());
+    std::ofstream modules_file((prefix + "_modules.csv").c_str());
+    std::ofstream timing_file((prefix + "_timing.csv").c_str());
+    if ( !joints_file.is_open() || !modules_file.is_open() || !timing_file.is_open() )
+    {
+        std::cerr << "[RecordingToCsv] Error: could not create output files with prefix \"" << prefix << "\""
+                  << std::endl;
+        return -1;
+    }
+
+    //-- Headers
+    joints_file << "time_us";
+    modules_file << "time_us";
+    for (int i = 0; i < reader.getNumModules(); i++)
+    {
+        joints_file << ",joint_" << i;
+        modules_file << ",id_" << i;
+    }
+    for (int i = 0; i < reader.getNumModules(); i++)
+        modules_file << ",configuration_id_" << i;
+    joints_file << std::endl;
+    modules_file << std::endl;
+    timing_file << "time_us,send_time_ns" << std::endl;
+
+    //-- Records
+    Recorder::Record record;
+    unsigned long num_records = 0;
+    while ( reader.readNext(record) )
+    {
+        num_records++;
+
+        switch (record.type)
+        {
+            case Recorder::JOINT_VALUES:
+                joints_file << record.time_us;
+                for (int i = 0; i < (int) record.joint_values.size(); i++)
+                    joints_file << "," << record.joint_values[i];
+                joints_file << std::endl;
+                break;
+
+            case Recorder::MODULES:
+                modules_file << record.time_us;
+                for (int i = 0; i < (int) record.ids.size(); i++)
+                    modules_file << "," << record.ids[i];
+                for (int i = 0; i < (int) record.configuration_ids.size(); i++)
+                    modules_file << "," << record.configuration_ids[i];
+                modules_file << std::endl;
+                break;
+
+            case Recorder::TIMING:
+                timing_file << record.time_us << "," << record.send_time_ns << std::endl;
+                break;
+        }
+    }
+
+    std::cout << "Converted " << num_records << " records (" << reader.getNumModules() << " modules, step "
+              << reader.getStepTime() << "ms" << ( reader.isCompressed() ? ", compressed" : "") << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//-- replay-recording
+//------------------------------------------------------------------------------
+//--
+//-- Replays a recorded joint trajectory on the simulated or the real robot
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "ConfigParser.h"
+#include "ReplayModularRobotInterface.hpp"
+#include "Profiler.hpp"
+
+using namespace hormodular;
+
+//-- Percentile (0-100) of sorted values, nearest-rank method
+double percentile(const std::vector<double>& sorted_values, double p)
+{
+    if ( sorted_values.empty() )
+        return 0;
+
+    int rank = (int) std::ceil(p / 100.0 * sorted_values.size());
+    rank = std::max(1, std::min(rank, (int) sorted_values.size()));
+    return sorted_values[rank - 1];
+}
+
+void printPercentiles(const std::string& name, std::vector<double>& values)
+{
+    std::sort(values.begin(), values.end());
+    std::cout << name << ": p50 " << percentile(values, 50) << ", p90 " << percentile(values, 90)
+              << ", p99 " << percentile(values, 99) << ", max " << percentile(values, 100) << std::endl;
+}
+
+int main(int argc, char * argv[] )
+{
+    //-- Extract data from arguments
+    if ( argc < 3 || argc > 5 )
+    {
+        std::cout << "Usage: replay-recording (config file) (recording file) [robot interface=simulated] "
+                  << "[timing (realtime/fast)]" << std::endl
+                  << std::endl
+                  << "By default, recordings are replayed in real time on the serial robot and as fast as "
+                  << "possible otherwise" << std::endl;
+        exit(-1);
+    }
+
+    std::string config_file = argv[1];
+    std::string recording_file = argv[2];
+    std::string interface_type = argc >= 4 ? argv[3] : "simulated";
+    std::string timing = argc == 5 ? argv[4] : ( interface_type == "serial" ? "realtime" : "fast");
+
+    if ( timing != "realtime" && timing != "fast" )
+    {
+        std::cerr << "[Replay] Error: unknown timing \"" << timing << "\"" << std::endl;
+        return -1;
+    }
+
+    //-- Load configuration on a ConfigParser
+    hormodular::ConfigParser configParser;
+    if ( configParser.parse(config_file) != 0)
+    {
+        std::cerr << "[Replay] Error: error parsing xml config file!" << std::endl;
+        return -1;
+    }
+
+    //-- Create robot:
+    ReplayModularRobotInterface robotInterface(configParser.getRobotDescription(), recording_file,
+                                               interface_type);
+    if ( !robotInterface.reset() )
+    {
+        std::cerr << "[Replay] Error: could not load the recording or the robot" << std::endl;
+        robotInterface.destroy();
+        return -1;
+    }
+
+    robotInterface.setProperty("realtime", timing == "realtime" ? "enabled" : "disabled");
+    if ( interface_type == "simulated" )
+        robotInterface.setProperty("viewer", "enabled");
+
+    std::cout << "Replay-Recording" << std::endl
+              << "------------------------------------" << std::endl
+              << "[Replay] " << recording_file << " on " << interface_type << " robot (" << timing << ", step "
+              << robotInterface.getStepTime() << "ms)" << std::endl;
+
+    //-- Replay
+    std::vector<double> send_times_us, lateness_us;
+    uint64_t start = Profiler::now();
+
+    while ( robotInterface.replayStep() )
+    {
+        send_times_us.push_back(robotInterface.getLastSendTime() / 1000.0);
+        if ( timing == "realtime" )
+            lateness_us.push_back(robotInterface.getLastLateness() / 1000.0);
+    }
+
+    double real_time_s = (Profiler::now() - start) / 1e9;
+
+    //-- Report
+    std::cout << "Steps replayed: " << robotInterface.getReplayedSteps() << std::endl;
+    std::cout << "Robot time elapsed: " << robotInterface.getRecordedTime() / 1000.0 + robotInterface.getStepTime()
+              << "ms" << std::endl;
+    std::cout << "Real time elapsed: " << real_time_s << "s" << std::endl;
+    std::cout << "Distance travelled: " << robotInterface.getTravelledDistance() << std::endl;
+    printPercentiles("Send time (us)", send_times_us);
+    if ( timing == "realtime" )
+        printPercentiles("Lateness (us)", lateness_us);
+    std::cout << std::endl;
+
+    std::cout << "Finished!" << std::endl;
+
+    robotInterface.destroy();
+    return 0;
+}
@@ -16,9 +16,75 @@
 //------------------------------------------------------------------------------
 
 #include "ConfigParser.h"
+#include <fstream>
+#include <sstream>
+#include "Utils.hpp"
+
+//-- Cache file constants
+const uint32_t hormodular::ConfigParser::CACHE_MAGIC;
+const uint32_t hormodular::ConfigParser::CACHE_VERSION;
+
+//-- Helper functions for reading / writing the cache file (little endian)
+namespace
+{
+    void writeUInt32(std::ostream& stream, uint32_t value)
+    {
+        char bytes[4];
+        for (int i = 0; i < 4; i++)
+            bytes[i] = (value >> (8 * i)) & 0xff;
+        stream.write(bytes, 4);
+    }
+
+    void writeInt32(std::ostream& stream, int32_t value)
+    {
+        writeUInt32(stream, (uint32_t) value);
+    }
+
+    void writeString(std::ostream& stream, const std::string& value)
+    {
+        writeUInt32(stream, value.size());
+        stream.write(value.data(), value.size());
+    }
+
+    bool readUInt32(std::istream& stream, uint32_t& value)
+    {
+        unsigned char bytes[4];
+        if ( !stream.read((char *) bytes, 4) )
+            return false;
+
+        value = 0;
+        for (int i = 0; i < 4; i++)
+            value |= ((uint32_t) bytes[i]) << (8 * i);
+        return true;
+    }
+
+    bool readInt32(std::istream& stream, int32_t& value)
+    {
+        uint32_t aux = 0;
+        if ( !readUInt32(stream, aux) )
+            return false;
+
+        value = (int32_t) aux;
+        return true;
+    }
+
+    bool readString(std::istream& stream, std::string& value)
+    {
+        //-- Strings on the configuration files are paths and names, longer ones mean a corrupt file
+        static const uint32_t MAX_STRING_SIZE = 4096;
+
+        uint32_t size = 0;
+        if ( !readUInt32(stream, size) || size > MAX_STRING_SIZE )
+            return false;
+
+        value.resize(size);
+        return size == 0 || !stream.read(&value[0], size).fail();
+    }
+}
 
 hormodular::ConfigParser::ConfigParser()
 {
+    cacheEnabled = true;
     clearData();
 }
 
@@ -26,20 +92,230 @@ int hormodular::ConfigParser::parse(const std::string &filepath)
 {
     clearData();
 
-    //-- Create a xml document and load the file
-    tinyxml2::XMLDocument xmldoc;
-    xmldoc.LoadFile(filepath.c_str());
-
-    //-- Error checking
-    if ( xmldoc.ErrorID() == tinyxml2::XML_ERROR_FILE_COULD_NOT_BE_OPENED ||
-         xmldoc.ErrorID() == tinyxml2::XML_ERROR_FILE_NOT_FOUND ||
-         xmldoc.ErrorID() == tinyxml2::XML_ERROR_FILE_READ_ERROR )
+    //-- Read the whole file, as its hash is needed to know if the cache is up to date
+    std::ifstream file(filepath.c_str(), std::ios::in | std::ios::binary);
+    if ( !file.is_open() )
     {
         std::cerr << "[Error] ConfigParser: error opening \"" << filepath.c_str()
                   << "\", xml file could not be opened!" << std::endl;
         return FILE_NOT_OPENED;
     }
-    else if ( xmldoc.ErrorID() != tinyxml2::XML_SUCCESS )
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string xml = contents.str();
+
+    uint32_t hash = hashFNV1a(FNV1A_OFFSET_BASIS, xml.data(), xml.size());
+    uint32_t size = xml.size();
+
+    //-- Use the cached data if it was created from this same file
+    if ( cacheEnabled && loadCache(getCacheFile(filepath), hash, size) )
+    {
+        loadedFromCache = true;
+    }
+    else
+    {
+        int result = parseXML(xml);
+        if ( result != 0 )
+            return result;
+    }
+
+    xmlHash = hash;
+    xmlSize = size;
+    createRobotDescription();
+
+    return 0;
+}
+
+bool hormodular::ConfigParser::saveCache(const std::string &cachepath)
+{
+    if ( !robotDescription )
+    {
+        std::cerr << "[ConfigParser] Error: no file was parsed, cache cannot be saved" << std::endl;
+        return false;
+    }
+
+    std::ostringstream data(std::ios::out | std::ios::binary);
+
+    //-- Robot data
+    writeString(data, robotName);
+    writeString(data, simulationFile);
+    writeString(data, gaitTableFolder);
+    writeString(data, frequencyTableFile);
+    writeString(data, serialPort);
+
+    writeUInt32(data, gaitTableFiles.size());
+    for (int i = 0; i < (int) gaitTableFiles.size(); i++)
+        writeString(data, gaitTableFiles[i]);
+
+    //-- Module data
+    writeUInt32(data, numModules);
+    for (int i = 0; i < numModules; i++)
+    {
+        writeInt32(data, jointIDs[i]);
+        writeInt32(data, id_function_vector[i]);
+        writeInt32(data, id_depth_vector[i]);
+        writeUInt32(data, id_shape_vector[i]);
+        writeInt32(data, id_num_limbs_vector[i]);
+        writeInt32(data, id_limbs_vector[i]);
+        writeInt32(data, orientation_vector[i].getRoll());
+        writeInt32(data, orientation_vector[i].getPitch());
+        writeInt32(data, orientation_vector[i].getYaw());
+
+        writeUInt32(data, connector_info_vector[i].size());
+        for (int j = 0; j < (int) connector_info_vector[i].size(); j++)
+        {
+            writeUInt32(data, connector_info_vector[i][j].size());
+            for (int k = 0; k < (int) connector_info_vector[i][j].size(); k++)
+                writeInt32(data, connector_info_vector[i][j][k]);
+        }
+    }
+
+    std::string payload = data.str();
+
+    std::ofstream cache(cachepath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if ( !cache.is_open() )
+    {
+        std::cerr << "[ConfigParser] Error: could not open \"" << cachepath << "\"" << std::endl;
+        return false;
+    }
+
+    //-- Header, with the hash of the data to detect corrupt files
+    writeUInt32(cache, CACHE_MAGIC);
+    writeUInt32(cache, CACHE_VERSION);
+    writeUInt32(cache, xmlHash);
+    writeUInt32(cache, xmlSize);
+    writeUInt32(cache, hashFNV1a(FNV1A_OFFSET_BASIS, payload.data(), payload.size()));
+    cache.write(payload.data(), payload.size());
+
+    if ( !cache.good() )
+    {
+        std::cerr << "[ConfigParser] Error: error writing \"" << cachepath << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+std::string hormodular::ConfigParser::getCacheFile(const std::string &filepath)
+{
+    return filepath + ".cache";
+}
+
+void hormodular::ConfigParser::setCacheEnabled(bool enabled)
+{
+    cacheEnabled = enabled;
+}
+
+bool hormodular::ConfigParser::isLoadedFromCache() const
+{
+    return loadedFromCache;
+}
+
+bool hormodular::ConfigParser::loadCache(const std::string &cachepath, uint32_t expectedHash, uint32_t expectedSize)
+{
+    std::ifstream cache(cachepath.c_str(), std::ios::in | std::ios::binary);
+    if ( !cache.is_open() )
+        return false;
+
+    //-- Header: only caches of this version and created from the same XML contents are valid
+    uint32_t magic = 0, version = 0, hash = 0, size = 0;
+    if ( !readUInt32(cache, magic) || magic != CACHE_MAGIC
+         || !readUInt32(cache, version) || version != CACHE_VERSION
+         || !readUInt32(cache, hash) || hash != expectedHash
+         || !readUInt32(cache, size) || size != expectedSize )
+        return false;
+
+    //-- Data, checked against its hash
+    uint32_t dataHash = 0;
+    std::ostringstream contents(std::ios::out | std::ios::binary);
+    if ( !readUInt32(cache, dataHash) || !(contents << cache.rdbuf())
+         || hashFNV1a(FNV1A_OFFSET_BASIS, contents.str().data(), contents.str().size()) != dataHash )
+    {
+        std::cerr << "[ConfigParser] Warning: cache file \"" << cachepath << "\" is corrupt, ignoring it"
+                  << std::endl;
+        return false;
+    }
+    std::istringstream data(contents.str(), std::ios::in | std::ios::binary);
+
+    //-- Robot data
+    bool ok = readString(data, robotName)
+            && readString(data, simulationFile)
+            && readString(data, gaitTableFolder)
+            && readString(data, frequencyTableFile)
+            && readString(data, serialPort);
+
+    uint32_t numGaitTables = 0;
+    ok = ok && readUInt32(data, numGaitTables);
+    for (uint32_t i = 0; ok && i < numGaitTables; i++)
+    {
+        gaitTableFiles.push_back(std::string());
+        ok = readString(data, gaitTableFiles.back());
+    }
+
+    //-- Module data
+    uint32_t auxNumModules = 0;
+    ok = ok && readUInt32(data, auxNumModules);
+    for (uint32_t i = 0; ok && i < auxNumModules; i++)
+    {
+        int32_t jointID = 0, function = 0, depth = 0, numLimbs = 0, limb = 0, roll = 0, pitch = 0, yaw = 0;
+        uint32_t shape = 0, numConnectors = 0;
+
+        ok = readInt32(data, jointID) && readInt32(data, function) && readInt32(data, depth)
+                && readUInt32(data, shape) && readInt32(data, numLimbs) && readInt32(data, limb)
+                && readInt32(data, roll) && readInt32(data, pitch) && readInt32(data, yaw)
+                && readUInt32(data, numConnectors) && numConnectors <= (uint32_t) RobotDescription::NUM_CONNECTORS;
+        if ( !ok )
+            break;
+
+        jointIDs.push_back(jointID);
+        id_function_vector.push_back((ModuleFunction) function);
+        id_depth_vector.push_back(depth);
+        id_shape_vector.push_back(shape);
+        id_num_limbs_vector.push_back(numLimbs);
+        id_limbs_vector.push_back(limb);
+
+        Orientation orientation;
+        orientation.setRoll(roll);
+        orientation.setPitch(pitch);
+        orientation.setYaw(yaw);
+        orientation_vector.push_back(orientation);
+
+        std::vector< std::vector<int> > connectorInfo(numConnectors);
+        for (uint32_t j = 0; ok && j < numConnectors; j++)
+        {
+            uint32_t numValues = 0;
+            ok = readUInt32(data, numValues) && numValues <= 3;
+            for (uint32_t k = 0; ok && k < numValues; k++)
+            {
+                int32_t value = 0;
+                ok = readInt32(data, value);
+                connectorInfo[j].push_back(value);
+            }
+        }
+        connector_info_vector.push_back(connectorInfo);
+    }
+
+    if ( !ok )
+    {
+        std::cerr << "[ConfigParser] Warning: cache file \"" << cachepath << "\" is corrupt, ignoring it"
+                  << std::endl;
+        clearData();
+        return false;
+    }
+
+    numModules = auxNumModules;
+    return true;
+}
+
+int hormodular::ConfigParser::parseXML(const std::string &xml)
+{
+    //-- Create a xml document from the file contents
+    tinyxml2::XMLDocument xmldoc;
+    xmldoc.Parse(xml.c_str());
+
+    //-- Error checking
+    if ( xmldoc.ErrorID() != tinyxml2::XML_SUCCESS )
     {
         std::cerr << "[Error] ConfigParser: Some error occurred with the xml file. Error code: "
                      << xmldoc.ErrorID() << std::endl;
@@ -89,6 +365,42 @@ int hormodular::ConfigParser::parse(const std::string &filepath)
     frequencyTableFile = std::string(frequencyTableFileStr);
     removeBadCharacters(frequencyTableFile);
 
+    //-- Gait tables (optional)
+    tinyxml2::XMLElement* gaitTablesElement = modularRobotElement->FirstChildElement("gaitTables");
+    if ( gaitTablesElement )
+    {
+        int configurationId = 0;
+        tinyxml2::XMLElement* gaitTableElement = gaitTablesElement->FirstChildElement("gaitTable");
+
+        while (gaitTableElement)
+        {
+            gaitTableElement->QueryIntAttribute("configuration", &configurationId);
+            const char * gaitTableFileStr = gaitTableElement->GetText();
+            if ( configurationId < 0 || !gaitTableFileStr )
+            {
+                std::cerr << "[Error] Error extracting tag \"gaitTable\", a file and a configuration ID greater "
+                          << "or equal to 0 are required" << std::endl;
+                clearData();
+                return TAG_NOT_FOUND;
+            }
+
+            if ( configurationId >= (int) gaitTableFiles.size() )
+                gaitTableFiles.resize(configurationId + 1);
+
+            gaitTableFiles[configurationId] = std::string(gaitTableFileStr);
+            removeBadCharacters(gaitTableFiles[configurationId]);
+
+            configurationId++;
+            gaitTableElement = gaitTableElement->NextSiblingElement("gaitTable");
+        }
+    }
+    else
+    {
+        gaitTableFiles.push_back("multidof-11-2-gaittable.txt");
+        gaitTableFiles.push_back("multidof-7-tripod-gaittable.txt");
+        gaitTableFiles.push_back("multidof-9-quad-gaittable.txt");
+    }
+
     //-- Serial Port
     tinyxml2::XMLElement* serialPortElement = modularRobotElement->FirstChildElement("serialPort");
     if ( !serialPortElement )
@@ -249,6 +561,11 @@ std::string hormodular::ConfigParser::getFrequencyTableFile()
     return frequencyTableFile;
 }
 
+std::vector<std::string> hormodular::ConfigParser::getGaitTableFiles()
+{
+    return gaitTableFiles;
+}
+
 std::string hormodular::ConfigParser::getSerialPort()
 {
     return serialPort;
@@ -316,12 +633,54 @@ std::vector<hormodular::Orientation> hormodular::ConfigParser::getOrientations()
     return orientation_vector;
 }
 
+hormodular::RobotDescriptionPtr hormodular::ConfigParser::getRobotDescription() const
+{
+    return robotDescription;
+}
+
+void hormodular::ConfigParser::createRobotDescription()
+{
+    RobotDescription * description = new RobotDescription();
+
+    description->robotName = robotName;
+    description->simulationFile = simulationFile;
+    description->gaitTableFolder = gaitTableFolder;
+    description->frequencyTableFile = frequencyTableFile;
+    description->serialPort = serialPort;
+    description->gaitTableFiles = gaitTableFiles;
+    description->numModules = numModules;
+    description->jointIDs = jointIDs;
+    description->orientations = orientation_vector;
+
+    description->connections.resize(numModules * RobotDescription::NUM_CONNECTORS);
+    for (int i = 0; i < numModules; i++)
+        for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+        {
+            RobotDescription::Connection& connection = description->connections[i * RobotDescription::NUM_CONNECTORS + j];
+            if ( j < (int) connector_info_vector[i].size() && connector_info_vector[i][j].size() == 3 )
+            {
+                connection.module = connector_info_vector[i][j][0];
+                connection.connector = connector_info_vector[i][j][1];
+                connection.orientation = connector_info_vector[i][j][2];
+            }
+            else
+            {
+                connection.module = -1;
+                connection.connector = -1;
+                connection.orientation = -1;
+            }
+        }
+
+    robotDescription = RobotDescriptionPtr(description);
+}
+
 void hormodular::ConfigParser::clearData()
 {
     robotName = "";
     simulationFile = "";
     gaitTableFolder = "";
     frequencyTableFile = "";
+    gaitTableFiles.clear();
     numModules = 0;
     jointIDs.clear();
     id_function_vector.clear();
@@ -330,6 +689,11 @@ void hormodular::ConfigParser::clearData()
     id_num_limbs_vector.clear();
     id_limbs_vector.clear();
     orientation_vector.clear();
+    connector_info_vector.clear();
+    robotDescription.reset();
+    loadedFromCache = false;
+    xmlHash = 0;
+    xmlSize = 0;
 }
 
 bool hormodular::ConfigParser::removeBadCharacters(std::string& string)
@@ -29,8 +29,10 @@
 #include <cstring>
 #include <vector>
 #include <algorithm>
+#include <stdint.h>
 #include <tinyxml2.h>
 #include "Orientation.hpp"
+#include "RobotDescription.hpp"
 
 namespace hormodular {
 
@@ -55,10 +57,41 @@ class ConfigParser
          */
         int parse(const std::string& filepath);
 
+        /*!
+         * \brief Saves the data parsed on the last call to parse() as the cached version of the file parsed
+         *
+         * The cache is a binary file next to the XML file (see getCacheFile()) that stores the hash of the
+         * XML contents, so that parse() only uses it while the XML file does not change.
+         *
+         * \param cachepath Path of the cache file to write
+         * \return True if the cache was saved, false if no file was parsed successfully or on writing error
+         */
+        bool saveCache(const std::string& cachepath);
+
+        //! \brief Returns the path of the cache file used for the given XML file
+        static std::string getCacheFile(const std::string& filepath);
+
+        //! \brief Enables (default) or disables loading the cached version of the files parsed
+        void setCacheEnabled(bool enabled);
+
+        //! \brief Returns true if the data of the last file parsed was loaded from its cache file
+        bool isLoadedFromCache() const;
+
         std::string getRobotName();
         std::string getSimulationFile();
         std::string getGaitTableFolder();
         std::string getFrequencyTableFile();
+
+        /*!
+         * \brief Returns the gait table file (relative to the gait table folder) used for each
+         * configuration ID, or an empty string for the configuration IDs without gait table
+         *
+         * The gait tables are listed on the optional \<gaitTables\> element, with a \<gaitTable\>
+         * per table. Each table is used for the configuration ID given in its "configuration" attribute,
+         * or for the one following the previous table if omitted. Without \<gaitTables\>, the tables
+         * of the MultiDof-11-2, MultiDof-7-tripod and MultiDof-9-quad robots are used.
+         */
+        std::vector<std::string> getGaitTableFiles();
         std::string getSerialPort();
         int getNumModules();
         int getJointID(const int& module);
@@ -66,6 +99,12 @@ class ConfigParser
         std::vector< std::vector<int> > getConnectorInfo(int moduleIndex);
         std::vector<Orientation> getOrientations();
 
+        /*!
+         * \brief Returns the description of the robot parsed, to be shared by all the objects that need it
+         * \return The robot description, or an empty pointer if no file was parsed successfully
+         */
+        RobotDescriptionPtr getRobotDescription() const;
+
         //-- Error constants
         static const int FILE_NOT_OPENED = -1;
         static const int FILE_XML_ERROR = -2;
@@ -96,15 +135,41 @@ class ConfigParser
          */
         bool removeBadCharacters(std::string& string);
 
+        //! \brief Creates the robot description from the data parsed
+        void createRobotDescription();
+
+        /*!
+         * \brief Loads the data from a cache file, if it was created from the same XML contents
+         * \param cachepath Path of the cache file
+         * \param expectedHash Hash of the contents of the XML file
+         * \param expectedSize Size of the contents of the XML file
+         * \return True if the data was loaded, false otherwise (leaving the object empty)
+         */
+        bool loadCache(const std::string& cachepath, uint32_t expectedHash, uint32_t expectedSize);
+
+        //! \brief Parses the contents of a XML file, returning 0 if finished correctly, error code otherwise
+        int parseXML(const std::string& xml);
+
+        //-- Cache file constants
+        static const uint32_t CACHE_MAGIC = 0x444d5248; //-- "HRMD"
+        static const uint32_t CACHE_VERSION = 1;
+
         std::string robotName;
         std::string simulationFile;
         std::string gaitTableFolder;
         std::string frequencyTableFile;
+        std::vector<std::string> gaitTableFiles;
         std::string serialPort;
         int numModules;
         std::vector<int> jointIDs;
         std::vector< std::vector< std::vector<int> > > connector_info_vector;
         std::vector<Orientation> orientation_vector;
+        RobotDescriptionPtr robotDescription;
+
+        bool cacheEnabled;
+        bool loadedFromCache;
+        uint32_t xmlHash; //-- Hash of the contents of the XML file parsed
+        uint32_t xmlSize; //-- Size of the contents of the XML file parsed
 
         //-- Deprecated variables
         //! \deprecated This variable was used only for development purposes
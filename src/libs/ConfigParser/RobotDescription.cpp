@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+//-- RobotDescription
+//------------------------------------------------------------------------------
+//--
+//-- Immutable description of a modular robot, shared by all the objects that
+//-- need the robot configuration
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "RobotDescription.hpp"
+
+#include <stdexcept>
+
+const int hormodular::RobotDescription::NUM_CONNECTORS;
+
+hormodular::RobotDescription::RobotDescription()
+{
+    numModules = 0;
+}
+
+const std::string &hormodular::RobotDescription::getRobotName() const
+{
+    return robotName;
+}
+
+const std::string &hormodular::RobotDescription::getSimulationFile() const
+{
+    return simulationFile;
+}
+
+const std::string &hormodular::RobotDescription::getGaitTableFolder() const
+{
+    return gaitTableFolder;
+}
+
+const std::string &hormodular::RobotDescription::getFrequencyTableFile() const
+{
+    return frequencyTableFile;
+}
+
+const std::string &hormodular::RobotDescription::getSerialPort() const
+{
+    return serialPort;
+}
+
+const std::vector<std::string> &hormodular::RobotDescription::getGaitTableFiles() const
+{
+    return gaitTableFiles;
+}
+
+int hormodular::RobotDescription::getNumModules() const
+{
+    return numModules;
+}
+
+int hormodular::RobotDescription::getJointID(int module) const
+{
+    return jointIDs.at(module);
+}
+
+const std::vector<int> &hormodular::RobotDescription::getJointIDs() const
+{
+    return jointIDs;
+}
+
+const hormodular::Orientation &hormodular::RobotDescription::getOrientation(int module) const
+{
+    return orientations.at(module);
+}
+
+const hormodular::RobotDescription::Connection &hormodular::RobotDescription::getConnection(int module,
+                                                                                            int connector) const
+{
+    if ( connector < 0 || connector >= NUM_CONNECTORS )
+        throw std::out_of_range("RobotDescription::getConnection");
+
+    return connections.at(module * NUM_CONNECTORS + connector);
+}
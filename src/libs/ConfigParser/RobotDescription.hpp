@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//-- RobotDescription
+//------------------------------------------------------------------------------
+//--
+//-- Immutable description of a modular robot, shared by all the objects that
+//-- need the robot configuration
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file RobotDescription.hpp
+ *  \brief Immutable description of a modular robot
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef ROBOT_DESCRIPTION_H
+#define ROBOT_DESCRIPTION_H
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "Orientation.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class RobotDescription
+ *  \brief Immutable description of a modular robot: files used, modules and connections between them
+ *
+ *  It is created by ConfigParser once per configuration file and shared by pointer (see
+ *  RobotDescriptionPtr) between the ModularRobot, its modules and the robot interfaces, instead of
+ *  copying the configuration on each of them. Per-module data is stored on flat arrays indexed by
+ *  module (and connector).
+ */
+class RobotDescription
+{
+    public:
+        //! \brief Connection of a connector to a connector of other module
+        struct Connection
+        {
+            //! \brief Index of the module connected, or -1 if the connector is not connected
+            int module;
+            //! \brief Connector of the module connected (0 for front, 1 for right, 2 for back and 3 for left)
+            int connector;
+            int orientation;
+
+            bool isConnected() const { return module >= 0; }
+        };
+
+        static const int NUM_CONNECTORS = 4;
+
+        const std::string& getRobotName() const;
+        const std::string& getSimulationFile() const;
+        const std::string& getGaitTableFolder() const;
+        const std::string& getFrequencyTableFile() const;
+        const std::string& getSerialPort() const;
+
+        //! \brief Gait table file (relative to the gait table folder) for each configuration ID
+        const std::vector<std::string>& getGaitTableFiles() const;
+
+        int getNumModules() const;
+        int getJointID(int module) const;
+        const std::vector<int>& getJointIDs() const;
+        const Orientation& getOrientation(int module) const;
+
+        /*!
+         * \brief Returns the connection of a connector of a module
+         * \param module Index of the module
+         * \param connector Connector of the module (0 for front, 1 for right, 2 for back and 3 for left)
+         */
+        const Connection& getConnection(int module, int connector) const;
+
+    private:
+        //-- Only ConfigParser creates descriptions
+        friend class ConfigParser;
+        RobotDescription();
+
+        std::string robotName;
+        std::string simulationFile;
+        std::string gaitTableFolder;
+        std::string frequencyTableFile;
+        std::string serialPort;
+        std::vector<std::string> gaitTableFiles;
+
+        int numModules;
+        std::vector<int> jointIDs;
+        std::vector<Orientation> orientations;
+
+        //! \brief Connections of all the modules, NUM_CONNECTORS per module
+        std::vector<Connection> connections;
+};
+
+//! \brief Shared pointer to an immutable RobotDescription
+typedef boost::shared_ptr<const RobotDescription> RobotDescriptionPtr;
+
+}
+
+#endif //-- ROBOT_DESCRIPTION_H
@@ -23,6 +23,7 @@ hormodular::GaitTable::GaitTable(const std::string file_path)
 {
     //-- Check if the file exists
     this->file_path = file_path;
+    num_parameters = 0;
     std::ifstream file(file_path.c_str());
     if (file.good())
     {
@@ -150,11 +151,16 @@ int hormodular::GaitTable::loadFromFile( const std::string file_path)
         //-- Add the data to the table
         data.clear();
         ids.clear();
+        rows_by_id.clear();
+        zero_row.assign(num_parameters > 0 ? num_parameters : 0, 0);
 
         for (int i = 0; i < rows; i ++)
         {
             ids.push_back( (unsigned long) data_tmp[i*cols]);
 
+            //-- If an ID is repeated, the first row is used (as the previous linear search did)
+            rows_by_id.insert( std::make_pair(ids.back(), i));
+
             std::vector<float> newRow;
             for (int j = 1; j < cols; j++)
                 newRow.push_back(data_tmp[i*cols+j]);
@@ -189,7 +195,7 @@ int hormodular::GaitTable::loadFromFile( const std::string file_path)
 //-- Get things
 //----------------------------------------------------------------------------------------
 //-- Get element of the gait table
-float hormodular::GaitTable::at(int id, int parameter)
+float hormodular::GaitTable::at(unsigned long id, int parameter)
 {
     int tableRow = lookForID(id);
 
@@ -203,29 +209,34 @@ float hormodular::GaitTable::at(int id, int parameter)
 }
 
 //-- Get all parameters of a certain id
-std::vector<float> hormodular::GaitTable::getParameters(int id)
+std::vector<float> hormodular::GaitTable::getParameters(unsigned long id)
+{
+    return getRow(id);
+}
+
+const std::vector<float>& hormodular::GaitTable::getRow(unsigned long id)
 {
     int tableRow = lookForID(id);
 
     if ( tableRow == -1)
     {
         std::cerr << "[GaitTable] Error: ID "<< id <<" not found on gait table." << std::endl;
-        std::vector<float> vector_of_zeroes;
-
-        for (int i = 0; i < num_parameters; i++)
-            vector_of_zeroes.push_back(0);
-
-        return vector_of_zeroes;
+        return zero_row;
     }
 
     return data[tableRow];
 }
 
-std::vector<float> hormodular::GaitTable::operator[](int id)
+std::vector<float> hormodular::GaitTable::operator[](unsigned long id)
 {
     return getParameters(id);
 }
 
+bool hormodular::GaitTable::hasID(unsigned long id)
+{
+    return lookForID(id) != -1;
+}
+
 int hormodular::GaitTable::getNumParameters()
 {
     return num_parameters;
@@ -244,11 +255,12 @@ int hormodular::GaitTable::reload()
 
 int hormodular::GaitTable::lookForID(unsigned long id)
 {
-    for (int i = 0; i <(int) ids.size(); i++)
-        if ( ids[i] == id )
-           return i;
+    boost::unordered_map<unsigned long, int>::const_iterator it = rows_by_id.find(id);
+
+    if ( it == rows_by_id.end() )
+        return -1;
 
-    return -1;
+    return it->second;
 }
 
 //-- Save file
@@ -31,6 +31,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/unordered_map.hpp>
+
 namespace hormodular {
 
 /*! \class GaitTable
@@ -52,7 +54,7 @@ public:
      * \return The value stored at (id, parameter) on the gait table. If the ID
      * was not found, returns 0 (and shows an error message).
      */
-    float at( int id, int parameter );
+    float at( unsigned long id, int parameter );
 
     /*!
      * \brief Returns the value of all the parameters for a given ID
@@ -60,7 +62,14 @@ public:
      * found, returns a vector of zeroes with the correct dimensions (and shows an
      * error message).
      */
-    std::vector<float> getParameters( int id);
+    std::vector<float> getParameters( unsigned long id);
+
+    /*!
+     * \brief Returns the value of all the parameters for a given ID, without copying them
+     * \return The row of the table for the given ID. If the ID was not found, returns a row
+     * of zeroes with the correct dimensions (and shows an error message).
+     */
+    const std::vector<float>& getRow( unsigned long id);
 
     /*!
      * \brief Returns the value of all the parameters for a given ID
@@ -68,7 +77,10 @@ public:
      * found, returns a vector of zeroes with the correct dimensions (and shows an
      * error message).
      */
-    std::vector<float> operator[](int id);
+    std::vector<float> operator[](unsigned long id);
+
+    //! \brief Returns true if the table contains an entry for the given ID
+    bool hasID( unsigned long id);
 
 
     int getNumParameters();
@@ -95,6 +107,13 @@ private:
      */
     std::vector< std::vector<float> > data;
     std::vector<unsigned long> ids;
+
+    //! \brief Row returned for the IDs not found on the table
+    std::vector<float> zero_row;
+
+    //! \brief Row of the table for each ID, to avoid scanning the whole table on each lookup
+    boost::unordered_map<unsigned long, int> rows_by_id;
+
     int num_parameters;
     std::string file_path;
 
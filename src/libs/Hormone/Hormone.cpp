@@ -45,3 +45,13 @@ std::string hormodular::Hormone::getData()
 {
     return data;
 }
+
+bool hormodular::Hormone::operator==(const hormodular::Hormone &other) const
+{
+    return type == other.type && sourceConnector == other.sourceConnector && data == other.data;
+}
+
+bool hormodular::Hormone::operator!=(const hormodular::Hormone &other) const
+{
+    return !(*this == other);
+}
@@ -42,10 +42,15 @@ class Hormone
         int getSourceConnector();
         std::string getData();
 
+        //! \brief Two hormones are equal if they have the same type, source connector and data
+        bool operator==(const Hormone& other) const;
+        bool operator!=(const Hormone& other) const;
+
         //-- Allowed values for type
         static const int PING_HORMONE = 0;
         static const int LEG_HORMONE = 1;
         static const int HEAD_HORMONE = 2;
+        static const int TOPOLOGY_HORMONE = 3;
 
    private:
         int type;
@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------
+//-- HormoneScheduler
+//------------------------------------------------------------------------------
+//--
+//-- Discrete-event simulation of the hormone network of a modular robot
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "HormoneScheduler.hpp"
+
+bool hormodular::HormoneScheduler::Event::operator>(const hormodular::HormoneScheduler::Event &other) const
+{
+    if ( time != other.time )
+        return time > other.time;
+
+    return sequence > other.sequence;
+}
+
+hormodular::HormoneScheduler::HormoneScheduler(hormodular::RobotDescriptionPtr robotDescription,
+                                               unsigned long linkLatency_us, unsigned long executionTime_us)
+{
+    this->robotDescription = robotDescription;
+
+    //-- Create as many modules as needed, in incremental mode, sharing their gait tables
+    moduleArray = new ModuleArray(robotDescription, robotDescription->getNumModules());
+    for(int i = 0; i < robotDescription->getNumModules(); i++)
+    {
+        modules.push_back( new Module(robotDescription, i, moduleArray) );
+        modules[i]->setIncrementalMode(true);
+
+        for (int j = 0; j < 4; j++)
+            connectorIndex[modules[i]->getConnector(j)] = std::make_pair(i, j);
+    }
+
+    linkLatencies.resize(modules.size(), std::vector<unsigned long>(4, linkLatency_us));
+    executionTimes.resize(modules.size(), executionTime_us);
+    startTimes.resize(modules.size(), 0);
+
+    attachModules();
+    reset();
+}
+
+hormodular::HormoneScheduler::~HormoneScheduler()
+{
+    //-- Destroy modules
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        delete modules[i];
+        modules[i] = NULL;
+    }
+
+    delete moduleArray;
+    moduleArray = NULL;
+}
+
+bool hormodular::HormoneScheduler::setLinkLatency(int module, int connector, unsigned long latency_us)
+{
+    if ( module < 0 || module >= (int) modules.size() || connector < 0 || connector >= 4)
+    {
+        std::cerr << "[HormoneScheduler] Error: link " << module << ", " << connector << " does not exist."
+                  << std::endl;
+        return false;
+    }
+
+    linkLatencies[module][connector] = latency_us;
+    return true;
+}
+
+bool hormodular::HormoneScheduler::setExecutionTime(int module, unsigned long executionTime_us)
+{
+    if ( module < 0 || module >= (int) modules.size() )
+    {
+        std::cerr << "[HormoneScheduler] Error: module " << module << " does not exist." << std::endl;
+        return false;
+    }
+
+    executionTimes[module] = executionTime_us;
+    return true;
+}
+
+bool hormodular::HormoneScheduler::setStartTime(int module, unsigned long startTime_us)
+{
+    if ( module < 0 || module >= (int) modules.size() )
+    {
+        std::cerr << "[HormoneScheduler] Error: module " << module << " does not exist." << std::endl;
+        return false;
+    }
+
+    startTimes[module] = startTime_us;
+    return true;
+}
+
+bool hormodular::HormoneScheduler::reset()
+{
+    events = std::priority_queue<Event, std::vector<Event>, std::greater<Event> >();
+    sequence = 0;
+
+    currentTime = 0;
+    convergenceTime = 0;
+    numWakeUps = 0;
+    numDeliveries = 0;
+
+    wakeUpScheduled.assign(modules.size(), false);
+    busyUntil.assign(modules.size(), 0);
+
+    //-- Clear the hormones of the previous run and power on the modules
+    for (int i = 0; i < (int) modules.size(); i++)
+    {
+        modules[i]->reset();
+
+        for (int j = 0; j < 4; j++)
+        {
+            modules[i]->getConnector(j)->clearInputBuffer();
+            modules[i]->getConnector(j)->takeOutputHormones();
+        }
+
+        scheduleWakeUp(i, startTimes[i]);
+    }
+
+    return true;
+}
+
+bool hormodular::HormoneScheduler::step()
+{
+    if ( events.empty() )
+        return false;
+
+    Event event = events.top();
+    events.pop();
+
+    currentTime = event.time;
+
+    if ( event.type == WAKE_UP )
+        processWakeUp(event);
+    else
+        processDelivery(event);
+
+    return true;
+}
+
+bool hormodular::HormoneScheduler::run(unsigned long maxTime_us)
+{
+    while( !events.empty() && events.top().time <= maxTime_us )
+        step();
+
+    return events.empty();
+}
+
+bool hormodular::HormoneScheduler::isQuiescent()
+{
+    return events.empty();
+}
+
+unsigned long hormodular::HormoneScheduler::getCurrentTime()
+{
+    return currentTime;
+}
+
+unsigned long hormodular::HormoneScheduler::getConvergenceTime()
+{
+    return convergenceTime;
+}
+
+unsigned long hormodular::HormoneScheduler::getNumWakeUps()
+{
+    return numWakeUps;
+}
+
+unsigned long hormodular::HormoneScheduler::getNumDeliveries()
+{
+    return numDeliveries;
+}
+
+int hormodular::HormoneScheduler::getNumModules()
+{
+    return modules.size();
+}
+
+hormodular::Module *hormodular::HormoneScheduler::getModule(int index)
+{
+    if ( index < 0 || index >= (int) modules.size() )
+    {
+        std::cerr << "[HormoneScheduler] Error: module " << index << " does not exist." << std::endl;
+        return NULL;
+    }
+
+    return modules[index];
+}
+
+bool hormodular::HormoneScheduler::attachModules()
+{
+    //-- Attach the modules to the other modules
+    for(int i = 0; i < (int) modules.size(); i++)
+        for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+        {
+            const RobotDescription::Connection& connection = robotDescription->getConnection(i, j);
+            if ( connection.isConnected() )
+                modules[i]->attach( j, modules[connection.module]->getConnector(connection.connector));
+            else
+                modules[i]->attach(j, NULL);
+        }
+
+    return true;
+}
+
+void hormodular::HormoneScheduler::scheduleWakeUp(int module, unsigned long time)
+{
+    if ( wakeUpScheduled[module] )
+        return;
+
+    //-- A module cannot start processing until it has finished the previous time
+    Event event;
+    event.time = std::max(time, busyUntil[module]);
+    event.sequence = sequence++;
+    event.type = WAKE_UP;
+    event.module = module;
+    event.connector = -1;
+
+    events.push(event);
+    wakeUpScheduled[module] = true;
+}
+
+void hormodular::HormoneScheduler::processWakeUp(const hormodular::HormoneScheduler::Event &event)
+{
+    Module * module = modules[event.module];
+    wakeUpScheduled[event.module] = false;
+    numWakeUps++;
+
+    unsigned long previousID = module->getID();
+    int previousConfigurationId = module->getConfigurationId();
+
+    module->processHormones();
+
+    if ( !module->wasRecomputed() )
+        return;
+
+    //-- Results are available once the module has finished processing
+    unsigned long finishTime = event.time + executionTimes[event.module];
+    busyUntil[event.module] = finishTime;
+
+    if ( module->getID() != previousID || module->getConfigurationId() != previousConfigurationId )
+        convergenceTime = finishTime;
+
+    //-- Send the generated hormones through each link
+    for (int i = 0; i < 4; i++)
+    {
+        Connector * connector = module->getConnector(i);
+        std::vector<Hormone> hormones = connector->takeOutputHormones();
+
+        if ( connector->getRemoteConnector() == NULL )
+            continue;
+
+        std::pair<int, int> destination = connectorIndex[connector->getRemoteConnector()];
+
+        Event delivery;
+        delivery.time = finishTime + linkLatencies[event.module][i];
+        delivery.sequence = sequence++;
+        delivery.type = DELIVERY;
+        delivery.module = destination.first;
+        delivery.connector = destination.second;
+        delivery.hormones = hormones;
+
+        events.push(delivery);
+    }
+}
+
+void hormodular::HormoneScheduler::processDelivery(const hormodular::HormoneScheduler::Event &event)
+{
+    Connector * connector = modules[event.module]->getConnector(event.connector);
+    numDeliveries++;
+
+    connector->receiveHormones(event.hormones);
+
+    //-- Only wake up the module if its input changed
+    if ( connector->hasInputChanged() )
+        scheduleWakeUp(event.module, event.time);
+}
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+//-- HormoneScheduler
+//------------------------------------------------------------------------------
+//--
+//-- Discrete-event simulation of the hormone network of a modular robot
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file HormoneScheduler.hpp
+ *  \brief Discrete-event simulation of the hormone network of a modular robot
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef HORMONE_SCHEDULER_H
+#define HORMONE_SCHEDULER_H
+
+#include <vector>
+#include <queue>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+
+#include "RobotDescription.hpp"
+#include "Module.hpp"
+#include "Hormone.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class HormoneScheduler
+ *  \brief Discrete-event simulation of the hormone network of a modular robot
+ *
+ *  Alternative to the lockstep hormone processing of ModularRobot::run(): each
+ *  module has an execution time and each link between connectors a latency, and
+ *  modules are only woken up when the hormones in their input buffers change (the
+ *  modules are run in incremental mode). It is meant to study the convergence of the
+ *  module IDs of large robots and the effect of asynchronous timing. Joints are not
+ *  simulated.
+ *
+ *  With uniform timing the modules reach the same IDs as with the lockstep processing.
+ *  The hormone protocol relies on lockstep processing: with non-uniform timing it is not
+ *  guaranteed to settle (e.g. the head role can keep moving between neighbour modules)
+ *  nor to reach the same IDs. If it does not settle, run() stops at the given time.
+ *
+ *  All times are expressed in us.
+ */
+class HormoneScheduler
+{
+    public:
+        /*!
+         * \brief Creates the modules described by the configuration and connects them
+         * \param robotDescription Description of the robot, shared with its modules
+         * \param linkLatency_us Default time a hormone takes to travel between two connected modules
+         * \param executionTime_us Default time a module takes to process its hormones
+         */
+        HormoneScheduler(RobotDescriptionPtr robotDescription, unsigned long linkLatency_us = 1000,
+                         unsigned long executionTime_us = 100);
+        ~HormoneScheduler();
+
+        /*!
+         * \brief Sets the latency of the link starting at a connector of a module
+         * \return True if completed successfully, false otherwise
+         */
+        bool setLinkLatency(int module, int connector, unsigned long latency_us);
+
+        //! \brief Sets the execution time of a module
+        bool setExecutionTime(int module, unsigned long executionTime_us);
+
+        //! \brief Sets the time at which the module is powered on (0 by default)
+        bool setStartTime(int module, unsigned long startTime_us);
+
+        /*!
+         * \brief Resets the modules and the event queue, scheduling the first wake up of each module
+         * \return True if completed successfully, false otherwise
+         */
+        bool reset();
+
+        /*!
+         * \brief Processes the next event in the queue
+         * \return True if an event was processed, false if the queue is empty
+         */
+        bool step();
+
+        /*!
+         * \brief Processes events until there are no more pending hormones or the given time is reached
+         * \param maxTime_us Maximum simulated time
+         * \return True if the hormone network became quiescent, false otherwise
+         */
+        bool run(unsigned long maxTime_us);
+
+        //! \brief Returns true if there are no pending events
+        bool isQuiescent();
+
+        //! \brief Returns the current simulated time
+        unsigned long getCurrentTime();
+
+        /*!
+         * \brief Returns the time at which the last module changed its ID or configuration, which is the
+         * convergence time once the network is quiescent
+         */
+        unsigned long getConvergenceTime();
+
+        //! \brief Returns the number of times a module was woken up since last reset
+        unsigned long getNumWakeUps();
+
+        //! \brief Returns the number of times hormones were delivered through a link since last reset
+        unsigned long getNumDeliveries();
+
+        int getNumModules();
+        Module * getModule(int index);
+
+    private:
+        //! \brief Type of events in the queue
+        enum EventType { WAKE_UP, DELIVERY };
+
+        struct Event
+        {
+            unsigned long time;
+            unsigned long sequence; //-- Events at the same time are processed in FIFO order
+            EventType type;
+            int module;
+            int connector;
+            std::vector<Hormone> hormones;
+
+            bool operator>(const Event& other) const;
+        };
+
+        bool attachModules();
+        void scheduleWakeUp(int module, unsigned long time);
+        void processWakeUp(const Event& event);
+        void processDelivery(const Event& event);
+
+        RobotDescriptionPtr robotDescription;
+        ModuleArray * moduleArray;
+        std::vector<Module *> modules;
+
+        //! \brief Module and connector index for each connector, to find the destination of the links
+        std::map<Connector *, std::pair<int, int> > connectorIndex;
+
+        std::vector< std::vector<unsigned long> > linkLatencies;
+        std::vector<unsigned long> executionTimes;
+        std::vector<unsigned long> startTimes;
+
+        std::priority_queue<Event, std::vector<Event>, std::greater<Event> > events;
+        unsigned long sequence;
+
+        //! \brief Modules with a pending wake up event
+        std::vector<bool> wakeUpScheduled;
+        //! \brief Time at which each module finishes processing its hormones
+        std::vector<unsigned long> busyUntil;
+
+        unsigned long currentTime;
+        unsigned long convergenceTime;
+        unsigned long numWakeUps;
+        unsigned long numDeliveries;
+};
+
+}
+
+#endif //-- HORMONE_SCHEDULER_H
@@ -19,18 +19,23 @@
 
 
 
-hormodular::ModularRobot::ModularRobot(hormodular::ConfigParser configParser, std::string robotInterfaceType)
+hormodular::ModularRobot::ModularRobot(hormodular::RobotDescriptionPtr robotDescription, std::string robotInterfaceType)
 {
-    this->configParser = configParser;
+    this->robotDescription = robotDescription;
 
-    //-- Create as many modules as needed
-    for(int i = 0; i < configParser.getNumModules(); i++)
-        modules.push_back( new Module(configParser, i) );
+    //-- Create as many modules as needed, all of them stored on the same array
+    moduleArray = new ModuleArray(robotDescription, robotDescription->getNumModules());
+    for(int i = 0; i < robotDescription->getNumModules(); i++)
+        modules.push_back( new Module(robotDescription, i, moduleArray) );
 
     //-- Create robot, simulated type
-    robotInterface = createModularRobotInterface( robotInterfaceType, configParser);
+    robotInterface = createModularRobotInterface( robotInterfaceType, robotDescription);
+    pipeline = NULL;
 
     step_ms = 0.25;
+    warm_start = false;
+    control_period_us = 0;
+    realtime = false;
 
     reset();
 }
@@ -47,6 +52,9 @@ hormodular::ModularRobot::~ModularRobot()
         delete modules[i];
         modules[i] = NULL;
     }
+
+    delete moduleArray;
+    moduleArray = NULL;
 }
 
 bool hormodular::ModularRobot::run(unsigned long runTime)
@@ -54,51 +62,138 @@ bool hormodular::ModularRobot::run(unsigned long runTime)
     //-- Movement loop
     unsigned long runTimeUs = 1000*runTime;
 
-    while( elapsed_time < runTimeUs )
+    //-- One entry per communication period of the run
+    unsigned long periodUs = COMMUNICATION_PERIOD_MS*1000;
+    if ( runTimeUs > elapsed_time )
+        recomputed_modules.reserve(recomputed_modules.size() + (runTimeUs - elapsed_time) / periodUs + 1);
+
+    if ( realtime )
+    {
+        //-- The memory for the whole run is reserved and the gait tables loaded before the loop starts
+        unsigned long step_us = (unsigned long)(step_ms*1000);
+        unsigned long steps = step_us > 0 && runTimeUs > elapsed_time ? (runTimeUs - elapsed_time) / step_us + 1 : 0;
+        jitter_stats.reset((uint64_t) step_us * 1000, steps);
+        moduleArray->loadGaitTables();
+
+        while( elapsed_time < runTimeUs )
+        {
+            jitter_stats.addCycle(Profiler::now());
+            step();
+        }
+        jitter_stats.addCycle(Profiler::now());
+    }
+    else
+    {
+        while( elapsed_time < runTimeUs )
+            step();
+    }
+
+    //-- Wait until the robot has executed all the steps
+    if ( pipeline )
+        return pipeline->flush();
+
+    return true;
+}
+
+bool hormodular::ModularRobot::step()
+{
+    if ( elapsed_time % (COMMUNICATION_PERIOD_MS*1000) == 0)
     {
-        if ( elapsed_time % (COMMUNICATION_PERIOD_MS*1000) == 0)
         {
+            HORMODULAR_PROFILE_SCOPE(Profiler::HORMONE_PROCESSING);
+
             //-- Process incoming hormones
+            int recomputed = 0;
             for(int i = 0; i < (int) modules.size(); i++)
+            {
                 modules[i]->processHormones();
+                if ( modules[i]->wasRecomputed() )
+                    recomputed++;
+            }
+
+            recomputed_modules.push_back(recomputed);
 
-            //-- Get oscillator parameters from gait table:
-            for( int i = 0; i < (int) modules.size(); i++)
-                modules[i]->updateOscillatorParameters();
+            if ( recorder.isOpen() )
+                recordModules();
         }
 
-        //-- Update joint values
-        for ( int i = 0; i < (int) modules.size(); i++)
-            joint_values[i] = modules[i]->calculateNextJointPos();
+        HORMODULAR_PROFILE_SCOPE(Profiler::OSCILLATOR_UPDATE);
 
-        //-- Send joint values
-//        robotInterface->setProperty("LED", "toggle");
-        robotInterface->sendJointValues(joint_values, step_ms);
+        //-- Get oscillator parameters from gait table:
+        for( int i = 0; i < (int) modules.size(); i++)
+            modules[i]->updateOscillatorParameters();
+    }
 
-//            //-- Debug: get joint values to check if it is ok
-//            std::vector<float> feedback = robotInterface->getJointValues();
-//            for (int i = 0; i < (int) feedback.size(); i++)
-//                std::cout << feedback[i] << " ";
-//            std::cout << std::endl;
+    {
+        HORMODULAR_PROFILE_SCOPE(Profiler::OSCILLATOR_UPDATE);
 
-        if ( elapsed_time % (COMMUNICATION_PERIOD_MS*1000) == 0)
+        //-- Update joint values, or the joint targets once every control period
+        if ( control_period_us == 0 )
+            moduleArray->calculateJointPositions(joint_values);
+        else
         {
-            //-- Send hormones
-            for(int i = 0; i < (int) modules.size(); i++)
-                modules[i]->sendHormones();
+            bool first_targets = joint_targets.empty();
+            if ( first_targets || elapsed_time - last_control_time >= control_period_us )
+            {
+                //-- Targets are scheduled on multiples of the control period, not when the step happens to
+                //-- reach it, so that the rate does not drift when the step does not divide the period.
+                //-- If the step is longer than the period, the missed targets are skipped
+                if ( first_targets )
+                    last_control_time = elapsed_time;
+                else
+                    last_control_time += control_period_us;
+
+                if ( elapsed_time - last_control_time >= control_period_us )
+                    last_control_time = elapsed_time;
+
+                moduleArray->calculateJointPositions(joint_targets);
+                interpolator.addTargets(joint_targets);
+            }
+
+            interpolator.interpolate( (elapsed_time - last_control_time) / (float) control_period_us,
+                                      joint_values);
         }
+    }
 
-        //-- Update time:
-        for ( int i = 0; i < (int) modules.size(); i++)
-            modules[i]->updateElapsedTime(step_ms);
+    //-- Send joint values
+//    robotInterface->setProperty("LED", "toggle");
+    bool ok;
+    if ( recorder.isOpen() )
+    {
+        recorder.recordJointValues(elapsed_time, joint_values);
 
-        elapsed_time+=(unsigned long)(step_ms*1000);
-        //std::cout << "Run time: " << elapsed_time << std::endl;
-        //usleep( step_ms * 1000);
+        uint64_t send_start = Profiler::now();
+        ok = robotInterface->sendJointValues(joint_values, step_ms);
+        recorder.recordTiming(elapsed_time, Profiler::now() - send_start);
+    }
+    else
+    {
+        ok = robotInterface->sendJointValues(joint_values, step_ms);
+    }
+
+//    //-- Debug: get joint values to check if it is ok
+//    std::vector<float> feedback = robotInterface->getJointValues();
+//    for (int i = 0; i < (int) feedback.size(); i++)
+//        std::cout << feedback[i] << " ";
+//    std::cout << std::endl;
+
+    if ( elapsed_time % (COMMUNICATION_PERIOD_MS*1000) == 0)
+    {
+        HORMODULAR_PROFILE_SCOPE(Profiler::HORMONE_PROCESSING);
 
+        //-- Send hormones
+        for(int i = 0; i < (int) modules.size(); i++)
+            modules[i]->sendHormones();
     }
 
-    return true;
+    //-- Update time:
+    moduleArray->updateElapsedTime(step_ms);
+
+    elapsed_time+=(unsigned long)(step_ms*1000);
+    //std::cout << "Run time: " << elapsed_time << std::endl;
+    //usleep( step_ms * 1000);
+
+    return ok;
 }
 
 bool hormodular::ModularRobot::reset()
@@ -109,7 +204,7 @@ bool hormodular::ModularRobot::reset()
 
     //-- Initialize joint vector to 0
     joint_values.clear();
-    for (int i = 0; i < (int) configParser.getNumModules(); i++)
+    for (int i = 0; i < (int) robotDescription->getNumModules(); i++)
         joint_values.push_back(0);
 
     //-- Attach modules
@@ -117,6 +212,11 @@ bool hormodular::ModularRobot::reset()
         return false;
 
     elapsed_time = 0;
+    recomputed_modules.clear();
+
+    last_control_time = 0;
+    joint_targets.clear();
+    interpolator.reset();
 
     return true;
 }
@@ -137,7 +237,162 @@ bool hormodular::ModularRobot::setTimeStep(float step_ms)
 
 bool hormodular::ModularRobot::setProperty(std::string property, std::string value)
 {
-    if ( property.compare("viewer") == 0)
+    if ( property.compare("incremental") == 0)
+    {
+        bool enabled;
+        if ( value.compare("enabled") == 0)
+            enabled = true;
+        else if ( value.compare("disabled") == 0)
+            enabled = false;
+        else
+        {
+            std::cerr << "[ModularRobot] Error: unknown value for property \"incremental\": " << value << std::endl;
+            return false;
+        }
+
+        for (int i = 0; i < (int) modules.size(); i++)
+            modules[i]->setIncrementalMode(enabled);
+
+        return true;
+    }
+
+    if ( property.compare("recording") == 0)
+    {
+        if ( value.compare("disabled") == 0)
+            return recorder.close();
+
+        bool compressed = value.size() >= 3 && value.substr(value.size() - 3) == ".gz";
+        return recorder.open(value, modules.size(), step_ms, compressed);
+    }
+
+    if ( property.compare("ids") == 0)
+    {
+        Module::IdEncoding encoding;
+        if ( value.compare("base17") == 0)
+            encoding = Module::BASE17_ID;
+        else if ( value.compare("descriptor") == 0)
+            encoding = Module::DESCRIPTOR_ID;
+        else
+        {
+            std::cerr << "[ModularRobot] Error: unknown value for property \"ids\": " << value << std::endl;
+            return false;
+        }
+
+        for (int i = 0; i < (int) modules.size(); i++)
+            if ( !modules[i]->setIdEncoding(encoding, modules[i]->getDescriptorDepth()) )
+                return false;
+
+        return !warm_start || warmStartModules();
+    }
+
+    if ( property.compare("descriptor_depth") == 0)
+    {
+        int depth = atoi(value.c_str());
+        for (int i = 0; i < (int) modules.size(); i++)
+            if ( !modules[i]->setIdEncoding(modules[i]->getIdEncoding(), depth) )
+                return false;
+
+        return !warm_start || warmStartModules();
+    }
+
+    if ( property.compare("warm_start") == 0)
+    {
+        if ( value.compare("enabled") == 0)
+        {
+            warm_start = true;
+            return warmStartModules();
+        }
+        else if ( value.compare("disabled") == 0)
+        {
+            warm_start = false;
+            for (int i = 0; i < (int) modules.size(); i++)
+                modules[i]->setWarmStart(modules[i]->getID(), modules[i]->getConfigurationId(), 0);
+            return true;
+        }
+
+        std::cerr << "[ModularRobot] Error: unknown value for property \"warm_start\": " << value << std::endl;
+        return false;
+    }
+
+    if ( property.compare("control_rate") == 0)
+    {
+        if ( value.compare("disabled") == 0)
+        {
+            control_period_us = 0;
+            return true;
+        }
+
+        float rate_hz = atof(value.c_str());
+        if ( rate_hz <= 0 )
+        {
+            std::cerr << "[ModularRobot] Error: unknown value for property \"control_rate\": " << value << std::endl;
+            return false;
+        }
+
+        control_period_us = (unsigned long) (1000000 / rate_hz);
+        joint_targets.clear();
+        interpolator.reset();
+        return true;
+    }
+
+    if ( property.compare("interpolation") == 0)
+    {
+        JointInterpolator::Mode mode;
+        if ( !JointInterpolator::parseMode(value, mode) )
+        {
+            std::cerr << "[ModularRobot] Error: unknown value for property \"interpolation\": " << value << std::endl;
+            return false;
+        }
+
+        interpolator.setMode(mode);
+        return true;
+    }
+
+    if ( property.compare("pipeline") == 0)
+    {
+        int latency = 0;
+        if ( value.compare("disabled") != 0)
+        {
+            latency = atoi(value.c_str());
+            if ( latency < 1 )
+            {
+                std::cerr << "[ModularRobot] Error: unknown value for property \"pipeline\": " << value << std::endl;
+                return false;
+            }
+        }
+
+        if ( pipeline )
+        {
+            robotInterface = pipeline->release();
+            delete pipeline;
+            pipeline = NULL;
+        }
+
+        if ( latency > 0 )
+        {
+            pipeline = new PipelinedModularRobotInterface(robotInterface, latency);
+            robotInterface = pipeline;
+        }
+
+        return true;
+    }
+
+    if ( property.compare("realtime") == 0)
+    {
+        if ( value.compare("enabled") != 0 && value.compare("disabled") != 0)
+        {
+            std::cerr << "[ModularRobot] Error: unknown value for property \"realtime\": " << value << std::endl;
+            return false;
+        }
+
+        if ( !robotInterface->setProperty(property, value) )
+            return false;
+
+        realtime = value.compare("enabled") == 0;
+        return true;
+    }
+
+    if ( property.compare("viewer") == 0 || property.compare("substeps") == 0)
         return robotInterface->setProperty(property, value);
 
     return false;
@@ -148,33 +403,75 @@ float hormodular::ModularRobot::getTravelledDistance()
     return robotInterface->getTravelledDistance();
 }
 
+unsigned long hormodular::ModularRobot::getElapsedTime()
+{
+    return elapsed_time;
+}
+
+std::vector<int> hormodular::ModularRobot::getRecomputedModulesPerPeriod()
+{
+    return recomputed_modules;
+}
+
+std::vector<unsigned long> hormodular::ModularRobot::getModuleIDs()
+{
+    std::vector<unsigned long> ids(modules.size());
+    for (int i = 0; i < (int) modules.size(); i++)
+        ids[i] = modules[i]->getID();
+
+    return ids;
+}
+
+const hormodular::JitterStats &hormodular::ModularRobot::getJitterStats() const
+{
+    return jitter_stats;
+}
+
 bool hormodular::ModularRobot::attachModules()
 {
     //-- Attach the modules to the other modules
     for(int i = 0; i < (int) modules.size(); i++)
-    {
-        std::vector< std::vector<int> > connectorConfig = configParser.getConnectorInfo(i);
-
-        if (connectorConfig.size() == 0)
+        for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
         {
-            std::cerr << "[ModularRobot] Error: no connector info was found!" << std::endl;
-            return false;
-        }
-
-        for (int j = 0; j < (int) connectorConfig.size(); j++)
-        {
-            if ( connectorConfig[j].size() != 0 )
-            {
-                int moduleConnectedTo = connectorConfig[j][0];
-                int connectorConnectedTo = connectorConfig[j][1];
-                int orientation = connectorConfig[j][2];
+            const RobotDescription::Connection& connection = robotDescription->getConnection(i, j);
+            if ( connection.isConnected() )
                 modules[i]->attach( j,
-                                    modules[moduleConnectedTo]->getConnector(connectorConnectedTo),
-                                    orientation);
-            }
+                                    modules[connection.module]->getConnector(connection.connector),
+                                    connection.orientation);
             else
                 modules[i]->attach(j, NULL);
         }
-    }
+
     return true;
 }
+
+bool hormodular::ModularRobot::warmStartModules()
+{
+    if ( modules.empty() )
+        return true;
+
+    IdSolver idSolver(robotDescription);
+    if ( !idSolver.solve(modules[0]->getIdEncoding(), modules[0]->getDescriptorDepth()) )
+        return false;
+
+    std::vector<unsigned long> ids = idSolver.getIDs();
+    std::vector<int> configurationIds = idSolver.getConfigurationIds();
+    for (int i = 0; i < (int) modules.size(); i++)
+        modules[i]->setWarmStart(ids[i], configurationIds[i], idSolver.getWarmUpPeriods());
+
+    return true;
+}
+
+void hormodular::ModularRobot::recordModules()
+{
+    std::vector<uint64_t> ids(modules.size());
+    std::vector<int32_t> configuration_ids(modules.size());
+
+    for (int i = 0; i < (int) modules.size(); i++)
+    {
+        ids[i] = modules[i]->getID();
+        configuration_ids[i] = modules[i]->getConfigurationId();
+    }
+
+    recorder.recordModules(elapsed_time, ids, configuration_ids);
+}
@@ -26,8 +26,14 @@
 
 #include "ConfigParser.h"
 #include "Module.hpp"
+#include "IdSolver.hpp"
+#include "JointInterpolator.h"
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
+#include "PipelinedModularRobotInterface.hpp"
+#include "Profiler.hpp"
+#include "JitterStats.hpp"
+#include "Recorder.hpp"
 
 namespace hormodular {
 
@@ -45,12 +51,12 @@ class ModularRobot
     public:
         /*!
          * \brief Creates a ModularRobot, specifying the type of robot to be created
-         * \param configParser ConfigParser object containing the robot configuration
+         * \param robotDescription Description of the robot, shared with its modules and robot interface
          * \param robotInterfaceType Optional parameter specifying the type of robot to
          * which the ModularRobot will be connected, either a simulated robot (default)
          * or a real robot connected via serial port.
          */
-        ModularRobot(ConfigParser configParser, std::string robotInterfaceType="simulated");
+        ModularRobot(RobotDescriptionPtr robotDescription, std::string robotInterfaceType="simulated");
         ~ModularRobot();
 
 
@@ -62,6 +68,13 @@ class ModularRobot
          */
         bool run(unsigned long runTime);
 
+        /*!
+         * \brief Runs a single control step of step_ms: hormone processing (once every communication
+         * period), joint update and joint send.
+         * \return True if the joint values were sent successfully, false otherwise
+         */
+        bool step();
+
         /*!
          * \brief Resets the initial state of the robot.
          *
@@ -73,10 +86,58 @@ class ModularRobot
 
 
         bool setTimeStep(float step_ms);
+
+        /*!
+         * \brief Sets a property of the robot
+         *
+         * Supported properties:
+         *  - "incremental": "enabled" / "disabled", to only recompute the modules whose incoming hormones
+         *    changed since the previous communication period
+         *  - "recording": path of a file where the joint values sent (every step), the module IDs
+         *    (every communication period) and the time spent sending the joint values are recorded.
+         *    Files ending in ".gz" are compressed. "disabled" closes the current recording. The time
+         *    step stored on the recording is the one set when it is enabled.
+         *  - "ids": "base17" (default) / "descriptor", encoding of the module IDs (see Module::IdEncoding).
+         *    Descriptor IDs require gait tables indexed by descriptor (see generate-descriptor-gait-table)
+         *  - "descriptor_depth": number of hops hashed on the descriptor IDs (default 4)
+         *  - "warm_start": "enabled" / "disabled" (default), to start the modules with the IDs they converge
+         *    to, computed offline with IdSolver, instead of running with wrong IDs until they are discovered
+         *  - "control_rate": frequency (in Hz) at which the joint targets are computed from the oscillators,
+         *    or "disabled" (default) to compute them on every step. The joint values sent on the steps
+         *    in between are interpolated from the last targets, with a delay of one control period
+         *    (two with cubic interpolation)
+         *  - "interpolation": "linear" (default) / "cubic", interpolation used with "control_rate"
+         *  - "pipeline": number of steps (at least 1) the controller can be ahead of the robot interface,
+         *    that is sent the joint values from its own thread (see PipelinedModularRobotInterface), or
+         *    "disabled" (default) to send them from the control loop. With the pipeline enabled, the
+         *    time recorded for each step is the time spent waiting for a free frame
+         *  - "realtime": "enabled" / "disabled" (default), forwarded to the robot interface (see
+         *    SerialModularRobotInterface). When enabled, run() also measures the period of the steps
+         *    (see getJitterStats()) and loads all the gait tables before the loop starts. In incremental
+         *    mode the loop does not allocate memory once the module IDs have converged
+         *  - "viewer", "substeps": forwarded to the robot interface (see SimulatedModularRobotInterface)
+         *
+         * \return True if completed successfully, false otherwise
+         */
         bool setProperty(std::string property, std::string value);
 
         float getTravelledDistance();
 
+        //! \brief Returns the time elapsed since the last reset(), in us
+        unsigned long getElapsedTime();
+
+        /*!
+         * \brief Returns the number of modules that recomputed their ID and role on each communication
+         * period since the last reset()
+         */
+        std::vector<int> getRecomputedModulesPerPeriod();
+
+        //! \brief Returns the current ID of each module
+        std::vector<unsigned long> getModuleIDs();
+
+        //! \brief Returns the statistics of the period of the steps of the last run(), if "realtime" is enabled
+        const JitterStats& getJitterStats() const;
+
         static const int COMMUNICATION_PERIOD_MS = 100;
 
    private:
@@ -84,15 +145,31 @@ class ModularRobot
          * \brief Function that performs the connections between the different connectors of the
          * different modules.
          *
-         * These connections are based on the configuration from the ConfigParser.
+         * These connections are based on the robot description.
          *
          * \return True if completed successfully, false otherwise
          */
         bool attachModules();
 
-        ConfigParser configParser;
+        /*!
+         * \brief Computes the final IDs of the modules with the current ID encoding and sets them as
+         * warm start of the modules
+         * \return True if completed successfully, false otherwise
+         */
+        bool warmStartModules();
+
+        //! \brief True if the modules are warm-started with the IDs computed offline
+        bool warm_start;
+
+        RobotDescriptionPtr robotDescription;
+
+        //! \brief State of all the modules, whose joint positions are swept linearly on each step
+        ModuleArray * moduleArray;
+        //! \brief Views of the modules on moduleArray, whose connectors exchange the hormones
         std::vector<Module *> modules;
         ModularRobotInterface * robotInterface;
+        //! \brief Pipeline wrapping the robot interface (same as robotInterface), NULL if disabled
+        PipelinedModularRobotInterface * pipeline;
 
         //! \brief Time elapsed, expressed in us
         unsigned long elapsed_time;
@@ -101,6 +178,26 @@ class ModularRobot
         float step_ms;
 
         std::vector<float> joint_values;
+
+        //! \brief Time between two joint target computations, in us (0 to compute them on every step)
+        unsigned long control_period_us;
+        //! \brief Time at which the last joint targets were due (multiple of the control period), in us
+        unsigned long last_control_time;
+        std::vector<float> joint_targets;
+        JointInterpolator interpolator;
+
+        //! \brief Number of modules recomputed on each communication period
+        std::vector<int> recomputed_modules;
+
+        //! \brief Period of the steps, measured if enabled with the "realtime" property
+        bool realtime;
+        JitterStats jitter_stats;
+
+        //! \brief Records the robot execution, if enabled with the "recording" property
+        Recorder recorder;
+
+        //! \brief Records the IDs and configuration IDs of all the modules
+        void recordModules();
 };
 }
 #endif //-- MODULAR_ROBOT_H
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+//-- DummyModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Headless interface that does not drive any robot
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "DummyModularRobotInterface.hpp"
+
+hormodular::DummyModularRobotInterface::DummyModularRobotInterface(hormodular::RobotDescriptionPtr robotDescription)
+{
+    num_modules = robotDescription->getNumModules();
+    reset();
+}
+
+bool hormodular::DummyModularRobotInterface::start()
+{
+    return true;
+}
+
+bool hormodular::DummyModularRobotInterface::stop()
+{
+    return true;
+}
+
+bool hormodular::DummyModularRobotInterface::destroy()
+{
+    return true;
+}
+
+bool hormodular::DummyModularRobotInterface::reset()
+{
+    joint_values.assign(num_modules, 0);
+    return true;
+}
+
+bool hormodular::DummyModularRobotInterface::setProperty(std::string property, std::string value)
+{
+    return property.compare("realtime") == 0 && (value.compare("enabled") == 0 || value.compare("disabled") == 0);
+}
+
+float hormodular::DummyModularRobotInterface::getTravelledDistance()
+{
+    return 0;
+}
+
+bool hormodular::DummyModularRobotInterface::sendJointValues(const std::vector<float>& joint_values, float step_ms)
+{
+    if ((int) joint_values.size() != num_modules)
+    {
+        std::cerr << "[DummyModRobInterface] Error: input joint values size differs with number of modules in robot"
+                  << std::endl;
+        return false;
+    }
+
+    this->joint_values = joint_values;
+    return true;
+}
+
+std::vector<float> hormodular::DummyModularRobotInterface::getJointValues()
+{
+    return joint_values;
+}
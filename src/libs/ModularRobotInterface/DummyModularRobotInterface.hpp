@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+//-- DummyModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Headless interface that does not drive any robot
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file DummyModularRobotInterface.hpp
+ *  \brief Headless interface that does not drive any robot
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef DUMMY_MODULAR_ROBOT_INTERFACE_H
+#define DUMMY_MODULAR_ROBOT_INTERFACE_H
+
+#include "ModularRobotInterface.hpp"
+#include "RobotDescription.hpp"
+#include <string>
+#include <vector>
+
+namespace hormodular {
+
+/*!
+ *  \class DummyModularRobotInterface
+ *  \brief Headless interface that does not drive any robot
+ *
+ *  It only stores the last joint values received, so that the controller can be run
+ *  (and benchmarked) without a simulator or a real robot attached.
+ */
+class DummyModularRobotInterface : public ModularRobotInterface
+{
+    public:
+        DummyModularRobotInterface(RobotDescriptionPtr robotDescription);
+
+        //! \brief Does nothing, always returns true
+        virtual bool start();
+
+        //! \brief Does nothing, always returns true
+        virtual bool stop();
+
+        //! \brief Does nothing, always returns true
+        virtual bool destroy();
+
+        //! \brief Sets the stored joint values to 0
+        virtual bool reset();
+
+        /*!
+         * \brief Accepts "realtime" ("enabled" / "disabled"), that does nothing since the steps are
+         * not waited, so that real-time runs of the controller can be done without a robot
+         */
+        virtual bool setProperty(std::string property, std::string value);
+
+        //! \brief Returns 0, since there is no robot to move
+        virtual float getTravelledDistance();
+
+        //! \brief Stores the joint values, without waiting step_ms
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0);
+
+        //! \brief Returns the last joint values stored
+        virtual std::vector<float> getJointValues();
+
+    private:
+        int num_modules;
+        std::vector<float> joint_values;
+};
+
+}
+
+#endif //-- DUMMY_MODULAR_ROBOT_INTERFACE_H
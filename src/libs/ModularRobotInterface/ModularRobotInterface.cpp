@@ -23,3 +23,26 @@ bool hormodular::ModularRobotInterface::setProperty(std::string property, std::s
     //-- By default, it does nothing
     return false;
 }
+
+bool hormodular::ModularRobotInterface::sendJointTrajectory(const Trajectory &trajectory, int first_step, int num_steps,
+                                                           float step_ms)
+{
+    std::vector<float> joint_values(trajectory.getNumJoints());
+
+    for (int step = first_step; step < first_step + num_steps; step++)
+    {
+        const float * values = trajectory.getJointValues(step);
+        if ( !values )
+        {
+            std::cerr << "[ModularRobotInterface] Error: the trajectory is empty" << std::endl;
+            return false;
+        }
+
+        joint_values.assign(values, values + trajectory.getNumJoints());
+
+        if ( !sendJointValues(joint_values, step_ms) )
+            return false;
+    }
+
+    return true;
+}
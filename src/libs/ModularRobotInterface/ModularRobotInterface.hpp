@@ -24,6 +24,11 @@
 #ifndef MODULAR_ROBOT_INTERFACE_H
 #define MODULAR_ROBOT_INTERFACE_H
 
+#include <string>
+#include <vector>
+
+#include "Trajectory.h"
+
 namespace hormodular {
 
 /*!
@@ -33,6 +38,9 @@ namespace hormodular {
 class ModularRobotInterface
 {
 public:
+    //! \brief Virtual, so that the interfaces can be deleted through a ModularRobotInterface pointer
+    virtual ~ModularRobotInterface() {}
+
     /*!
      * \brief Initialize the robot interface
      * \return True if completed successfully, false otherwise
@@ -70,8 +78,27 @@ public:
     //! \brief Returns the distance travelled my the modular robot in meters
     virtual float getTravelledDistance() = 0;
 
-    //! \brief Sends the joint position values to the robot
-    virtual bool sendJointValues(std::vector<float> joint_values, float step_ms=0) = 0;
+    /*!
+     * \brief Sends the joint position values to the robot
+     *
+     * The values are passed by reference, so that the control loop does not copy (and allocate)
+     * them on every step.
+     */
+    virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0) = 0;
+
+    /*!
+     * \brief Streams a batch of steps of a precomputed trajectory to the robot
+     *
+     * By default, each step is sent with sendJointValues(). Interfaces can override it
+     * to send the values directly from the trajectory buffer.
+     *
+     * \param trajectory Precomputed trajectory
+     * \param first_step First step of the trajectory to be sent
+     * \param num_steps Number of steps to be sent
+     * \param step_ms Time to advance after each step (as in sendJointValues())
+     * \return True if completed successfully, false otherwise
+     */
+    virtual bool sendJointTrajectory(const Trajectory& trajectory, int first_step, int num_steps, float step_ms=0);
 
     //! \brief Queries the robot for its joint position values
     virtual std::vector<float> getJointValues() = 0;
@@ -18,12 +18,16 @@
 
 #include "ModularRobotInterfaceFactory.hpp"
 
-hormodular::ModularRobotInterface *hormodular::createModularRobotInterface(std::string type, ConfigParser configParser)
+hormodular::ModularRobotInterface *hormodular::createModularRobotInterface(std::string type, RobotDescriptionPtr robotDescription)
 {
     if ( type == "simulated")
-        return (ModularRobotInterface*) new SimulatedModularRobotInterface(configParser);
+        return (ModularRobotInterface*) new SimulatedModularRobotInterface(robotDescription);
     else if (type == "serial")
-        return (ModularRobotInterface*) new SerialModularRobotInterface(configParser);
+        return (ModularRobotInterface*) new SerialModularRobotInterface(robotDescription);
+    else if (type == "multiserial")
+        return (ModularRobotInterface*) new MultiSerialModularRobotInterface(robotDescription);
+    else if (type == "dummy")
+        return (ModularRobotInterface*) new DummyModularRobotInterface(robotDescription);
     else
     {
         std::cerr << "[Error][ModularRobotInterface] Could not create robot with type: \"" << type << "\"" << std::endl;
@@ -31,18 +31,21 @@
 #include "ModularRobotInterface.hpp"
 #include "SimulatedModularRobotInterface.hpp"
 #include "SerialModularRobotInterface.hpp"
-#include "ConfigParser.h"
+#include "MultiSerialModularRobotInterface.hpp"
+#include "DummyModularRobotInterface.hpp"
+#include "RobotDescription.hpp"
 
 namespace hormodular {
 
 /*!
  * \brief Creates different modular robot interfaces that follow the ModularRobotInterface interface
- * \param type Type of ModularRobotInterface to be created. Currently, only "simulated" or "serial"
- * are supported.
- * \param configParser ConfigParser containing the ModularRobotInterface configuration.
+ * \param type Type of ModularRobotInterface to be created. Currently, "simulated", "serial",
+ * "multiserial" (serial port handled by the SerialPortManager shared by the process) or "dummy"
+ * (headless, no robot attached) are supported.
+ * \param robotDescription Description of the robot containing the ModularRobotInterface configuration.
  * \return Pointer to the new ModularRobotInterface created.
  */
-ModularRobotInterface * createModularRobotInterface( std::string type, ConfigParser configParser);
+ModularRobotInterface * createModularRobotInterface( std::string type, RobotDescriptionPtr robotDescription);
 
 }
 
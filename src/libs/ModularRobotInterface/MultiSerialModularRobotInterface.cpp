@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+//-- MultiSerialModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Interface to a modular robot via serial port, sharing a single event loop
+//-- with the rest of the robots of the process
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "MultiSerialModularRobotInterface.hpp"
+#include "Profiler.hpp"
+
+#include <iostream>
+
+hormodular::MultiSerialModularRobotInterface::MultiSerialModularRobotInterface(RobotDescriptionPtr robotDescription,
+                                                                               SerialPortManager * manager)
+{
+    this->manager = manager ? manager : &SerialPortManager::getSharedManager();
+    port_name = robotDescription->getSerialPort();
+    port = -1;
+
+    num_modules = robotDescription->getNumModules();
+    joint_values.resize(num_modules, 0);
+
+    //-- Command and one byte per joint (at most 8)
+    output_buffer.reserve(9);
+}
+
+bool hormodular::MultiSerialModularRobotInterface::start()
+{
+    if ( port >= 0 )
+        return true;
+
+    port = manager->open(port_name);
+    if ( port < 0 )
+        return false;
+
+    if ( !checkConnection() )
+    {
+        std::cerr << "[MultiSerialModRobInterface] Error communicating with the robot on " << port_name << std::endl;
+        manager->close(port);
+        port = -1;
+        return false;
+    }
+
+    return true;
+}
+
+bool hormodular::MultiSerialModularRobotInterface::stop()
+{
+    if ( port < 0 )
+        return true;
+
+    bool flushed = manager->flush(port, 1000);
+    manager->close(port);
+    port = -1;
+
+    return flushed;
+}
+
+bool hormodular::MultiSerialModularRobotInterface::destroy()
+{
+    stop();
+    return true;
+}
+
+bool hormodular::MultiSerialModularRobotInterface::reset()
+{
+    stop();
+
+    for (int i = 0; i < num_modules; i++)
+        joint_values[i] = 0;
+    pacing.reset();
+
+    return start();
+}
+
+bool hormodular::MultiSerialModularRobotInterface::setProperty(std::string property, std::string value)
+{
+    if ( property.compare("LED") == 0 && value.compare("toggle") == 0)
+    {
+        std::vector<unsigned char> toggle(1, 0x5F); //-- 0x5F -> Toggle LED
+        return manager->send(port, toggle);
+    }
+    else if ( property.compare("realtime") == 0 && (value.compare("enabled") == 0 || value.compare("disabled") == 0))
+    {
+        pacing.setAbsolute(value.compare("enabled") == 0);
+        return true;
+    }
+
+    std::cerr << "[MultiSerialModRobInterface] Error: value: " << value << " for property: " << property
+              << " does not exist" << std::endl;
+    return false;
+}
+
+float hormodular::MultiSerialModularRobotInterface::getTravelledDistance()
+{
+    std::cerr << "[MultiSerialModularRobotInterface] Warning: travelled distance is not implemented yet. Returning -1."
+              << std::endl;
+    return -1;
+}
+
+bool hormodular::MultiSerialModularRobotInterface::sendJointValues(const std::vector<float>& joint_values, float step_ms)
+{
+    //-- Check number of input values:
+    if ( (int) joint_values.size() != num_modules )
+    {
+        std::cerr << "[MultiSerialModRobInterface] Error: input joint values size differs with number of modules in robot"
+                  << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < num_modules; i++)
+        this->joint_values[i] = joint_values[i];
+
+    //-- More than 8 joints are not supported by the current architecture
+    int num_joints = num_modules <= 8 ? num_modules : 8;
+
+    output_buffer.clear();
+    output_buffer.push_back(0x50); //-- 0x50 -> Set pos to all joints
+
+    //-- Convert joint position to servo values [0-180]
+    for (int i = 0; i < num_joints; i++)
+    {
+        float servo_value = joint_values[i] + 90;
+        if (servo_value < 0) servo_value = 0;
+        if (servo_value > 180) servo_value = 180;
+
+        output_buffer.push_back( (unsigned char)( (int) (servo_value)));
+    }
+
+    bool result;
+    {
+        HORMODULAR_PROFILE_SCOPE(Profiler::JOINT_SEND);
+        result = manager->send(port, output_buffer) && num_joints == num_modules;
+    }
+    pacing.waitStep(step_ms);
+
+    return result;
+}
+
+std::vector<float> hormodular::MultiSerialModularRobotInterface::getJointValues()
+{
+    return joint_values;
+}
+
+hormodular::SerialPortManager::PortStats hormodular::MultiSerialModularRobotInterface::getStats()
+{
+    return manager->getStats(port);
+}
+
+bool hormodular::MultiSerialModularRobotInterface::checkConnection()
+{
+    //-- Read welcome message to check if connected to the robot
+    std::string welcomeMessage = "[Debug] Ok!\r\n";
+
+    std::vector<unsigned char> buffer;
+    if ( !manager->receive(port, buffer, welcomeMessage.size(), 1500) )
+    {
+        std::cerr << "[MultiSerialModRobInterface] Error: timeout waiting for the robot on " << port_name << std::endl;
+        return false;
+    }
+
+    return std::string(buffer.begin(), buffer.end()) == welcomeMessage;
+}
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//-- MultiSerialModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Interface to a modular robot via serial port, sharing a single event loop
+//-- with the rest of the robots of the process
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file MultiSerialModularRobotInterface.hpp
+ *  \brief Interface to a modular robot via serial port, sharing a single event loop with the rest
+ *  of the robots of the process
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef MULTI_SERIAL_MODULAR_ROBOT_INTERFACE_H
+#define MULTI_SERIAL_MODULAR_ROBOT_INTERFACE_H
+
+#include "ModularRobotInterface.hpp"
+#include "RobotDescription.hpp"
+#include "SerialPortManager.hpp"
+#include "PeriodicDeadline.hpp"
+#include <string>
+#include <vector>
+
+namespace hormodular {
+
+/*!
+ *  \class MultiSerialModularRobotInterface
+ *  \brief Interface to a modular robot via serial port, sharing a single event loop with the rest
+ *  of the robots of the process
+ *
+ *  Speaks the same protocol as SerialModularRobotInterface, but the port is handled by a
+ *  SerialPortManager: sendJointValues() queues the frame and returns without waiting for the
+ *  port, so several robots (each one controlled from its own thread) can be driven from one
+ *  process, and a slow or disconnected robot does not stall the others.
+ */
+class MultiSerialModularRobotInterface : public ModularRobotInterface
+{
+    public:
+        /*!
+         * \brief Creates the interface
+         * \param robotDescription Description of the robot, with the serial port to use
+         * \param manager Manager of the port, or NULL to use the one shared by the process
+         */
+        MultiSerialModularRobotInterface(RobotDescriptionPtr robotDescription, SerialPortManager * manager = NULL);
+
+        //! \brief Opens the serial port and checks the welcome message of the robot
+        virtual bool start();
+
+        //! \brief Waits for the queued frames and closes the serial port
+        virtual bool stop();
+
+        virtual bool destroy();
+
+        //! \brief Closes the serial port and connects again to the robot
+        virtual bool reset();
+
+        /*!
+         * \brief Configure a property or parameter of the interface
+         * \param property Property to be changed:
+         *  - "LED": controls the onboard LED. The only available value is "toggle".
+         *  - "realtime": "enabled" / "disabled" (default), as in SerialModularRobotInterface
+         * \param value Value to be set on the property
+         * \return True if completed successfully, false otherwise
+         */
+        virtual bool setProperty(std::string property, std::string value);
+
+        //! \brief Not implemented for real robots, returns -1
+        virtual float getTravelledDistance();
+
+        /*!
+         * \brief Queues the joint values to be sent to the robot and waits until the end of the step
+         * \return False if the robot is not connected or the port failed, true otherwise
+         */
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0);
+
+        //! \brief Returns the last joint values sent (the robot has no sensors to measure them)
+        virtual std::vector<float> getJointValues();
+
+        //! \brief Returns the statistics of the serial port of the robot
+        SerialPortManager::PortStats getStats();
+
+    private:
+        //! \brief Checks that the modular robot is connected by checking the initial message from the robot
+        bool checkConnection();
+
+        SerialPortManager * manager;
+        std::string port_name;
+        int port;
+
+        int num_modules;
+        std::vector<float> joint_values;
+
+        //! \brief Message sent to the robot, reused on every step to avoid allocating memory
+        std::vector<unsigned char> output_buffer;
+
+        //! \brief Waits for each step, with absolute deadlines in real-time mode
+        PeriodicDeadline pacing;
+};
+
+}
+
+#endif //-- MULTI_SERIAL_MODULAR_ROBOT_INTERFACE_H
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//-- PipelinedModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Interface that sends the joint values to another robot interface on its
+//-- own thread, while the controller computes the next ones
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "PipelinedModularRobotInterface.hpp"
+
+#include <iostream>
+
+hormodular::PipelinedModularRobotInterface::PipelinedModularRobotInterface(ModularRobotInterface *target,
+                                                                           int latency)
+{
+    this->target = target;
+    this->latency = latency > 0 ? latency : 1;
+
+    frames.resize(this->latency + 1);
+    frame_steps.resize(this->latency + 1, 0);
+    first_frame = 0;
+    queued_frames = 0;
+
+    stopping = false;
+    send_failed = false;
+    running = true;
+    sender = boost::thread(&PipelinedModularRobotInterface::senderLoop, this);
+}
+
+hormodular::PipelinedModularRobotInterface::~PipelinedModularRobotInterface()
+{
+    stopSender();
+}
+
+bool hormodular::PipelinedModularRobotInterface::start()
+{
+    return flush() && target && target->start();
+}
+
+bool hormodular::PipelinedModularRobotInterface::stop()
+{
+    flush();
+    return target && target->stop();
+}
+
+bool hormodular::PipelinedModularRobotInterface::destroy()
+{
+    stopSender();
+
+    if ( !target )
+        return false;
+
+    target->destroy();
+    delete target;
+    target = NULL;
+    return true;
+}
+
+bool hormodular::PipelinedModularRobotInterface::reset()
+{
+    flush();
+
+    //-- Errors of the frames sent before the reset are discarded
+    {
+        boost::mutex::scoped_lock lock(frames_mutex);
+        send_failed = false;
+    }
+
+    return target && target->reset();
+}
+
+bool hormodular::PipelinedModularRobotInterface::setProperty(std::string property, std::string value)
+{
+    flush();
+    return target && target->setProperty(property, value);
+}
+
+float hormodular::PipelinedModularRobotInterface::getTravelledDistance()
+{
+    flush();
+    return target ? target->getTravelledDistance() : 0;
+}
+
+bool hormodular::PipelinedModularRobotInterface::sendJointValues(const std::vector<float>& joint_values, float step_ms)
+{
+    if ( !running )
+    {
+        std::cerr << "[PipelinedModRobInterface] Error: the pipeline is stopped" << std::endl;
+        return false;
+    }
+
+    boost::mutex::scoped_lock lock(frames_mutex);
+
+    //-- Wait until the target has executed the frame sent latency + 1 frames ago
+    while ( queued_frames == (int) frames.size() )
+        frames_condition.wait(lock);
+
+    int frame = (first_frame + queued_frames) % frames.size();
+    frames[frame].assign(joint_values.begin(), joint_values.end());
+    frame_steps[frame] = step_ms;
+    queued_frames++;
+
+    frames_condition.notify_all();
+    return !send_failed;
+}
+
+std::vector<float> hormodular::PipelinedModularRobotInterface::getJointValues()
+{
+    flush();
+    return target ? target->getJointValues() : std::vector<float>();
+}
+
+bool hormodular::PipelinedModularRobotInterface::flush()
+{
+    boost::mutex::scoped_lock lock(frames_mutex);
+
+    while ( queued_frames > 0 )
+        frames_condition.wait(lock);
+
+    return !send_failed;
+}
+
+int hormodular::PipelinedModularRobotInterface::getLatency() const
+{
+    return latency;
+}
+
+hormodular::ModularRobotInterface *hormodular::PipelinedModularRobotInterface::release()
+{
+    stopSender();
+
+    ModularRobotInterface * released = target;
+    target = NULL;
+    return released;
+}
+
+void hormodular::PipelinedModularRobotInterface::senderLoop()
+{
+    boost::mutex::scoped_lock lock(frames_mutex);
+
+    while ( true )
+    {
+        while ( queued_frames == 0 && !stopping )
+            frames_condition.wait(lock);
+
+        if ( queued_frames == 0 )
+            break;
+
+        //-- The first frame is not reused by sendJointValues() until it is dequeued
+        std::vector<float>& joint_values = frames[first_frame];
+        float step_ms = frame_steps[first_frame];
+
+        lock.unlock();
+        bool ok = target->sendJointValues(joint_values, step_ms);
+        lock.lock();
+
+        if ( !ok )
+            send_failed = true;
+
+        first_frame = (first_frame + 1) % frames.size();
+        queued_frames--;
+        frames_condition.notify_all();
+    }
+}
+
+void hormodular::PipelinedModularRobotInterface::stopSender()
+{
+    if ( !running )
+        return;
+
+    {
+        boost::mutex::scoped_lock lock(frames_mutex);
+        stopping = true;
+    }
+    frames_condition.notify_all();
+    sender.join();
+
+    running = false;
+}
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//-- PipelinedModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Interface that sends the joint values to another robot interface on its
+//-- own thread, while the controller computes the next ones
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file PipelinedModularRobotInterface.hpp
+ *  \brief Interface that sends the joint values to another robot interface on its own thread
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef PIPELINED_MODULAR_ROBOT_INTERFACE_H
+#define PIPELINED_MODULAR_ROBOT_INTERFACE_H
+
+#include <string>
+#include <vector>
+#include <boost/thread.hpp>
+
+#include "ModularRobotInterface.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class PipelinedModularRobotInterface
+ *  \brief Interface that sends the joint values to another robot interface on its own thread
+ *
+ *  sendJointValues() copies the joint values to a free frame of a ring buffer and returns, and a
+ *  sender thread sends the queued frames to the target interface (i.e. stepping the simulation)
+ *  in order. The controller can then compute step k+1 while the target executes step k.
+ *
+ *  The latency is the number of frames the controller can be ahead of the frame being executed
+ *  by the target: with a latency of 1 (double-buffered frames) sendJointValues() for step k+2
+ *  waits until step k has been executed. As the controller is open-loop, the latency only delays
+ *  the moment the values reach the target, not the values themselves.
+ *
+ *  The rest of the calls (reset(), getJointValues(), getTravelledDistance()...) wait until all
+ *  the queued frames have been sent, so the target is never used from two threads at once.
+ *  Errors of the target when sending a frame are returned by the next call to sendJointValues()
+ *  or flush().
+ */
+class PipelinedModularRobotInterface : public ModularRobotInterface
+{
+    public:
+        /*!
+         * \brief Creates the pipeline and starts its sender thread
+         * \param target Interface driven, owned (and destroyed) by the pipeline
+         * \param latency Number of frames the controller can be ahead of the target (at least 1)
+         */
+        PipelinedModularRobotInterface(ModularRobotInterface * target, int latency = 1);
+        ~PipelinedModularRobotInterface();
+
+        virtual bool start();
+        virtual bool stop();
+
+        //! \brief Stops the sender thread and destroys the target interface
+        virtual bool destroy();
+
+        virtual bool reset();
+
+        //! \brief Forwards the property to the target interface, once the queued frames are sent
+        virtual bool setProperty(std::string property, std::string value);
+
+        virtual float getTravelledDistance();
+
+        /*!
+         * \brief Queues the joint values to be sent to the target interface, waiting for a free frame
+         * \return False if the target failed to send a previous frame, true otherwise
+         */
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0);
+
+        virtual std::vector<float> getJointValues();
+
+        /*!
+         * \brief Waits until all the queued frames have been sent to the target interface
+         * \return False if the target failed to send any of them, true otherwise
+         */
+        bool flush();
+
+        int getLatency() const;
+
+        /*!
+         * \brief Stops the sender thread, once the queued frames are sent, and returns the target
+         * interface, that is no longer owned by the pipeline
+         */
+        ModularRobotInterface * release();
+
+    private:
+        //! \brief Sends the queued frames to the target until the pipeline is stopped
+        void senderLoop();
+
+        //! \brief Waits for the queued frames and stops the sender thread
+        void stopSender();
+
+        ModularRobotInterface * target;
+        int latency;
+
+        //! \brief Ring buffer of latency + 1 frames, the first one being sent by the sender thread
+        std::vector< std::vector<float> > frames;
+        std::vector<float> frame_steps;
+        int first_frame;
+        int queued_frames;
+
+        //-- Sender thread
+        boost::thread sender;
+        boost::mutex frames_mutex;
+        boost::condition_variable frames_condition;
+        bool running;
+        bool stopping;
+        bool send_failed;
+};
+
+}
+
+#endif //-- PIPELINED_MODULAR_ROBOT_INTERFACE_H
@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+//-- ReplayModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Interface that drives another robot interface with a recorded trajectory
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "ReplayModularRobotInterface.hpp"
+
+#include "ModularRobotInterfaceFactory.hpp"
+#include "Profiler.hpp"
+#include "RealTime.hpp"
+
+hormodular::ReplayModularRobotInterface::ReplayModularRobotInterface(hormodular::RobotDescriptionPtr robotDescription,
+                                                                     std::string recording_file,
+                                                                     std::string target_type)
+{
+    target = createModularRobotInterface(target_type, robotDescription);
+    simulated_target = target_type.compare("simulated") == 0;
+
+    init(robotDescription, recording_file);
+}
+
+hormodular::ReplayModularRobotInterface::ReplayModularRobotInterface(hormodular::RobotDescriptionPtr robotDescription,
+                                                                     std::string recording_file,
+                                                                     ModularRobotInterface * target,
+                                                                     bool simulated_target)
+{
+    this->target = target;
+    this->simulated_target = simulated_target;
+
+    init(robotDescription, recording_file);
+}
+
+void hormodular::ReplayModularRobotInterface::init(hormodular::RobotDescriptionPtr robotDescription,
+                                                   std::string recording_file)
+{
+    this->recording_file = recording_file;
+    num_modules = robotDescription->getNumModules();
+    realtime = false;
+
+    openRecording();
+}
+
+bool hormodular::ReplayModularRobotInterface::start()
+{
+    return target && target->start();
+}
+
+bool hormodular::ReplayModularRobotInterface::stop()
+{
+    return target && target->stop();
+}
+
+bool hormodular::ReplayModularRobotInterface::destroy()
+{
+    reader.close();
+
+    if ( !target )
+        return false;
+
+    target->destroy();
+    delete target;
+    target = NULL;
+    return true;
+}
+
+bool hormodular::ReplayModularRobotInterface::reset()
+{
+    if ( !target || !target->reset() )
+        return false;
+
+    return openRecording();
+}
+
+bool hormodular::ReplayModularRobotInterface::setProperty(std::string property, std::string value)
+{
+    if ( property.compare("realtime") == 0)
+    {
+        if ( value.compare("enabled") == 0)
+            realtime = true;
+        else if ( value.compare("disabled") == 0)
+            realtime = false;
+        else
+        {
+            std::cerr << "[ReplayModRobInterface] Error: unknown value for property \"realtime\": " << value
+                      << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    return target && target->setProperty(property, value);
+}
+
+float hormodular::ReplayModularRobotInterface::getTravelledDistance()
+{
+    return target ? target->getTravelledDistance() : 0;
+}
+
+bool hormodular::ReplayModularRobotInterface::sendJointValues(const std::vector<float>& joint_values, float step_ms)
+{
+    return replayStep();
+}
+
+std::vector<float> hormodular::ReplayModularRobotInterface::getJointValues()
+{
+    return target ? target->getJointValues() : std::vector<float>();
+}
+
+bool hormodular::ReplayModularRobotInterface::replayStep()
+{
+    if ( finished || !target )
+        return false;
+
+    //-- Find the next joint values record
+    Recorder::Record record;
+    do
+    {
+        if ( !reader.readNext(record) )
+        {
+            finished = true;
+            return false;
+        }
+    }
+    while ( record.type != Recorder::JOINT_VALUES );
+
+    //-- Recording time restarts when the recorded robot is reset: replay it as the step that follows
+    uint64_t step_us = (uint64_t) (reader.getStepTime() * 1000);
+    if ( replayed_steps == 0 )
+        time_offset_us = 0;
+    else if ( record.time_us + time_offset_us < recorded_time_us + step_us )
+        time_offset_us = recorded_time_us + step_us - record.time_us;
+    recorded_time_us = record.time_us + time_offset_us;
+
+    //-- Wait until the time the step was recorded (the only place where the replay is paced)
+    last_lateness_ns = 0;
+    if ( realtime )
+    {
+        if ( replayed_steps == 0 )
+            start_time_ns = Profiler::now() - recorded_time_us * 1000;
+
+        uint64_t send_time_ns = start_time_ns + recorded_time_us * 1000;
+        RealTime::sleepUntil(send_time_ns);
+
+        last_lateness_ns = (int64_t) (Profiler::now() - send_time_ns);
+    }
+
+    replayed_steps++;
+
+    //-- Only a simulation needs the step (as the time to simulate), the rest of targets would wait it
+    float target_step_ms = simulated_target ? reader.getStepTime() : 0;
+
+    uint64_t send_start = Profiler::now();
+    bool ok = target->sendJointValues(record.joint_values, target_step_ms);
+    last_send_time_ns = Profiler::now() - send_start;
+
+    return ok;
+}
+
+bool hormodular::ReplayModularRobotInterface::isFinished() const
+{
+    return finished;
+}
+
+bool hormodular::ReplayModularRobotInterface::isReady() const
+{
+    return target != NULL && !finished;
+}
+
+unsigned long hormodular::ReplayModularRobotInterface::getReplayedSteps() const
+{
+    return replayed_steps;
+}
+
+uint64_t hormodular::ReplayModularRobotInterface::getRecordedTime() const
+{
+    return recorded_time_us;
+}
+
+float hormodular::ReplayModularRobotInterface::getStepTime() const
+{
+    return reader.getStepTime();
+}
+
+int64_t hormodular::ReplayModularRobotInterface::getLastLateness() const
+{
+    return last_lateness_ns;
+}
+
+uint64_t hormodular::ReplayModularRobotInterface::getLastSendTime() const
+{
+    return last_send_time_ns;
+}
+
+bool hormodular::ReplayModularRobotInterface::openRecording()
+{
+    replayed_steps = 0;
+    start_time_ns = 0;
+    recorded_time_us = 0;
+    time_offset_us = 0;
+    last_lateness_ns = 0;
+    last_send_time_ns = 0;
+
+    finished = true;
+    if ( !reader.open(recording_file) )
+        return false;
+
+    if ( reader.getNumModules() != num_modules )
+    {
+        std::cerr << "[ReplayModRobInterface] Error: recording has " << reader.getNumModules()
+                  << " modules, robot has " << num_modules << std::endl;
+        reader.close();
+        return false;
+    }
+
+    finished = false;
+    return true;
+}
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+//-- ReplayModularRobotInterface
+//------------------------------------------------------------------------------
+//--
+//-- Interface that drives another robot interface with a recorded trajectory
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file ReplayModularRobotInterface.hpp
+ *  \brief Interface that drives another robot interface with a recorded trajectory
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef REPLAY_MODULAR_ROBOT_INTERFACE_H
+#define REPLAY_MODULAR_ROBOT_INTERFACE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "ModularRobotInterface.hpp"
+#include "RobotDescription.hpp"
+#include "RecordingReader.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class ReplayModularRobotInterface
+ *  \brief Interface that drives another robot interface with a recorded trajectory
+ *
+ *  The joint values recorded by a ModularRobot (see Recorder) are sent, step by step,
+ *  to a target interface ("simulated", "serial" or "dummy"). Simulated targets get the
+ *  time step stored on the recording, as the time to be simulated. The rest of the targets
+ *  would wait for the time step (the serial ones sleep it), so they get a step of 0 and the
+ *  replay is paced only here: in real-time mode, each step is sent at the time it was
+ *  recorded (relative to the first one), so runs of the real robot can be reproduced, and
+ *  otherwise the steps are sent as fast as the target accepts them.
+ */
+class ReplayModularRobotInterface : public ModularRobotInterface
+{
+    public:
+        /*!
+         * \brief Creates the replay interface and its target interface
+         * \param robotDescription Description of the robot, used to create the target interface
+         * \param recording_file Recording containing the joint values to be replayed
+         * \param target_type Type of the interface driven: "simulated", "serial" or "dummy"
+         */
+        ReplayModularRobotInterface(RobotDescriptionPtr robotDescription, std::string recording_file,
+                                    std::string target_type = "simulated");
+
+        /*!
+         * \brief Creates the replay interface driving an existing target interface
+         * \param target Interface driven, destroyed and deleted by destroy()
+         * \param simulated_target True if the target simulates the robot, and thus needs the
+         * recorded time step to advance the simulation. Other targets get a step of 0
+         */
+        ReplayModularRobotInterface(RobotDescriptionPtr robotDescription, std::string recording_file,
+                                    ModularRobotInterface * target, bool simulated_target);
+
+        //! \brief Starts the target interface
+        virtual bool start();
+
+        //! \brief Stops the target interface
+        virtual bool stop();
+
+        //! \brief Destroys the target interface
+        virtual bool destroy();
+
+        //! \brief Resets the target interface and rewinds the recording
+        virtual bool reset();
+
+        /*!
+         * \brief Configure a property or parameter of the interface
+         * \param property "realtime" ("enabled" / "disabled") to send each step at its recorded time.
+         * Other properties are forwarded to the target interface.
+         * \return True if completed successfully, false otherwise
+         */
+        virtual bool setProperty(std::string property, std::string value);
+
+        //! \brief Returns the distance travelled by the target interface
+        virtual float getTravelledDistance();
+
+        /*!
+         * \brief Replays the next recorded step. The values and step given are ignored, the recorded
+         * ones are sent instead
+         */
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0);
+
+        //! \brief Returns the joint values of the target interface
+        virtual std::vector<float> getJointValues();
+
+        /*!
+         * \brief Sends the joint values of the next recorded step to the target interface
+         * \return True if completed successfully, false at the end of the recording or on error
+         */
+        bool replayStep();
+
+        //! \brief Returns true once all the recorded steps have been replayed
+        bool isFinished() const;
+
+        //! \brief Returns true if the recording and the target interface were loaded correctly
+        bool isReady() const;
+
+        //! \brief Returns the number of steps replayed since the last reset()
+        unsigned long getReplayedSteps() const;
+
+        //! \brief Returns the time (in us) at which the last replayed step was recorded
+        uint64_t getRecordedTime() const;
+
+        //! \brief Returns the control step (in ms) of the recording
+        float getStepTime() const;
+
+        /*!
+         * \brief Returns how late (in ns) the last step was sent with respect to its recorded time,
+         * in real-time mode
+         */
+        int64_t getLastLateness() const;
+
+        //! \brief Returns the time (in ns) spent by the target interface writing the last step
+        uint64_t getLastSendTime() const;
+
+    private:
+        //! \brief Initializes the replay state and opens the recording
+        void init(RobotDescriptionPtr robotDescription, std::string recording_file);
+
+        //! \brief Opens the recording from the beginning
+        bool openRecording();
+
+        ModularRobotInterface * target;
+        //! \brief True if the recorded time step is sent to the target (to advance the simulation)
+        bool simulated_target;
+        RecordingReader reader;
+        std::string recording_file;
+        int num_modules;
+
+        bool finished;
+        bool realtime;
+        unsigned long replayed_steps;
+
+        //-- Replay timing
+        uint64_t start_time_ns;
+        uint64_t recorded_time_us;
+        uint64_t time_offset_us;
+        int64_t last_lateness_ns;
+        uint64_t last_send_time_ns;
+};
+
+}
+
+#endif //-- REPLAY_MODULAR_ROBOT_INTERFACE_H
@@ -18,10 +18,10 @@
 #include "SerialModularRobotInterface.hpp"
 
 
-hormodular::SerialModularRobotInterface::SerialModularRobotInterface(hormodular::ConfigParser configParser)
+hormodular::SerialModularRobotInterface::SerialModularRobotInterface(hormodular::RobotDescriptionPtr robotDescription)
 {
-    port_name = configParser.getSerialPort();
-    num_modules = configParser.getNumModules();
+    port_name = robotDescription->getSerialPort();
+    num_modules = robotDescription->getNumModules();
 
     for (int i = 0; i < num_modules; i++)
     {
@@ -29,6 +29,9 @@ hormodular::SerialModularRobotInterface::SerialModularRobotInterface(hormodular:
     }
 
     serialPort = NULL;
+
+    //-- Command and one byte per joint (at most 8)
+    output_buffer.reserve(9);
 }
 
 bool hormodular::SerialModularRobotInterface::start()
@@ -65,6 +68,8 @@ bool hormodular::SerialModularRobotInterface::reset()
         for (int i = 0; i < num_modules; i++)
             joint_values.push_back(0);
 
+        pacing.reset();
+
         return start();
     }
     else
@@ -84,6 +89,19 @@ bool hormodular::SerialModularRobotInterface::setProperty(std::string property,
             return false;
         }
     }
+    else if ( property.compare("realtime") == 0)
+    {
+        if ( value.compare("enabled") == 0)
+            pacing.setAbsolute(true);
+        else if ( value.compare("disabled") == 0)
+            pacing.setAbsolute(false);
+        else
+        {
+            std::cerr << "[SerialModRobInterface] Error: value: " << value << " for property: " << property
+                      << " does not exist" << std::endl;
+            return false;
+        }
+    }
     return true;
 }
 
@@ -94,7 +112,7 @@ float hormodular::SerialModularRobotInterface::getTravelledDistance()
     return -1;
 }
 
-bool hormodular::SerialModularRobotInterface::sendJointValues(std::vector<float> joint_values, float step_ms)
+bool hormodular::SerialModularRobotInterface::sendJointValues(const std::vector<float>& joint_values, float step_ms)
 {
     //-- Check number of input values:
     if (joint_values.size() != num_modules)
@@ -109,8 +127,12 @@ bool hormodular::SerialModularRobotInterface::sendJointValues(std::vector<float>
         this->joint_values[i] = joint_values[i];
 
     //-- Send actual values:
-    bool result = sendJointValuesSerial(joint_values);
-    usleep(step_ms * 1000);
+    bool result;
+    {
+        HORMODULAR_PROFILE_SCOPE(Profiler::JOINT_SEND);
+        result = sendJointValuesSerial(joint_values);
+    }
+    pacing.waitStep(step_ms);
 
     return result;
 }
@@ -190,28 +212,26 @@ bool hormodular::SerialModularRobotInterface::toggleLED()
     }
 }
 
-bool hormodular::SerialModularRobotInterface::sendJointValuesSerial(std::vector<float> joint_values)
+bool hormodular::SerialModularRobotInterface::sendJointValuesSerial(const std::vector<float>& joint_values)
 {
     if ( serialPort && serialPort->IsOpen() )
     {
+        output_buffer.clear();
+        output_buffer.push_back(0x50); //-- 0x50 -> Set pos to all joints
+
         if ( joint_values.size() <= 8)
         {
             //-- Convert joint position to servo values [0-180]
             for (int i = 0; i < joint_values.size(); i++)
             {
-                joint_values[i]+=90;
-                if (joint_values[i] < 0) joint_values[i] = 0;
-                if (joint_values[i] > 180) joint_values[i] = 180;
-            }
-
+                float servo_value = joint_values[i] + 90;
+                if (servo_value < 0) servo_value = 0;
+                if (servo_value > 180) servo_value = 180;
 
-            SerialPort::DataBuffer outputBuff;
-            outputBuff.push_back(0x50); //-- 0x50 -> Set pos to all joints
-
-            for (int i = 0; i < joint_values.size(); i++)
-                outputBuff.push_back( (char)( (int) (joint_values[i])));
+                output_buffer.push_back( (char)( (int) (servo_value)));
+            }
 
-            serialPort->Write( outputBuff );
+            serialPort->Write( output_buffer );
 
             return true;
         }
@@ -221,13 +241,10 @@ bool hormodular::SerialModularRobotInterface::sendJointValuesSerial(std::vector<
             std::cerr << "[SerialModRobInterface] Error: more than 8 joints are not supported by "
                       << "the current architecture. Sending just 8 values..." << std::endl;
 
-            SerialPort::DataBuffer outputBuff;
-            outputBuff.push_back(0x50); //-- 0x50 -> Set pos to all joints
-
             for (int i = 0; i < 8; i++)
-                outputBuff.push_back( (char)( (int) (joint_values[i])));
+                output_buffer.push_back( (char)( (int) (joint_values[i])));
 
-            serialPort->Write( outputBuff );
+            serialPort->Write( output_buffer );
 
             return false;
         }
@@ -26,7 +26,9 @@
 #define SERIAL_MODULAR_ROBOT_INTERFACE_H
 
 #include "ModularRobotInterface.hpp"
-#include "ConfigParser.h"
+#include "RobotDescription.hpp"
+#include "Profiler.hpp"
+#include "PeriodicDeadline.hpp"
 #include <string>
 #include <vector>
 #include <iostream>
@@ -41,7 +43,7 @@ namespace hormodular {
 class SerialModularRobotInterface : public ModularRobotInterface
 {
     public:
-        SerialModularRobotInterface(ConfigParser configParser);
+        SerialModularRobotInterface(RobotDescriptionPtr robotDescription);
 
 
         /*!
@@ -74,10 +76,12 @@ class SerialModularRobotInterface : public ModularRobotInterface
 
         /*!
          * \brief Configure a property or parameter of the interface
-         * \param property Property to be changed. Currently, only the "LED" property
-         * is available, which controls the onboard LED.
-         * \param value Value to be set on the property. For "LED", the only
-         * available value is "toggle".
+         * \param property Property to be changed:
+         *  - "LED": controls the onboard LED. The only available value is "toggle".
+         *  - "realtime": "enabled" / "disabled" (default). When enabled, each step waits until an
+         *    absolute deadline (one step_ms after the previous one) instead of sleeping step_ms after
+         *    sending the values, so the delays of each step do not accumulate.
+         * \param value Value to be set on the property
          * \return True if completed successfully, false otherwise
          */
         virtual bool setProperty(std::string property, std::string value);
@@ -95,7 +99,7 @@ class SerialModularRobotInterface : public ModularRobotInterface
         virtual float getTravelledDistance();
 
         //! \brief Sends the specified joint position values to the modular robot through the serial connection
-        virtual bool sendJointValues(std::vector<float> joint_values, float step_ms=0);
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0);
 
         /*!
          * \brief Returns the joint position values stored in this class.
@@ -114,6 +118,12 @@ class SerialModularRobotInterface : public ModularRobotInterface
         int num_modules;
         std::vector<float> joint_values;
 
+        //! \brief Message sent to the robot, reused on every step to avoid allocating memory
+        SerialPort::DataBuffer output_buffer;
+
+        //! \brief Waits for each step, with absolute deadlines in real-time mode
+        PeriodicDeadline pacing;
+
         //-- Serial port related functions:
         //! \brief Configures and opens the serial port
         bool initSerialPort();
@@ -125,7 +135,7 @@ class SerialModularRobotInterface : public ModularRobotInterface
         bool toggleLED();
 
         //! \brief Sends the commands required for setting the joint position values on the modular robots
-        bool sendJointValuesSerial(std::vector<float> joint_values);
+        bool sendJointValuesSerial(const std::vector<float>& joint_values);
 };
 
 }
@@ -0,0 +1,495 @@
+//------------------------------------------------------------------------------
+//-- SerialPortManager
+//------------------------------------------------------------------------------
+//--
+//-- Driver for several serial ports, handled by a single epoll loop with
+//-- non-blocking writes and an outgoing frame queue per port
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "SerialPortManager.hpp"
+#include "Profiler.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+//-- epoll identifier of the wakeup eventfd (ports use their index)
+static const uint32_t WAKEUP_ID = 0xFFFFFFFF;
+static const int MAX_EVENTS = 16;
+
+const int hormodular::SerialPortManager::DEFAULT_BAUD_RATE;
+const int hormodular::SerialPortManager::DEFAULT_QUEUE_CAPACITY;
+const int hormodular::SerialPortManager::RECEIVE_BUFFER_SIZE;
+
+hormodular::SerialPortManager::SerialPortManager()
+{
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if ( epoll_fd < 0 || wakeup_fd < 0 )
+    {
+        std::cerr << "[SerialPortManager] Error: could not create the event loop (" << strerror(errno) << ")"
+                  << std::endl;
+        running = false;
+        return;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = WAKEUP_ID;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &event);
+
+    running = true;
+    loop = boost::thread(&SerialPortManager::eventLoop, this);
+}
+
+hormodular::SerialPortManager::~SerialPortManager()
+{
+    if ( running )
+    {
+        {
+            boost::mutex::scoped_lock lock(ports_mutex);
+            running = false;
+        }
+
+        uint64_t value = 1;
+        if ( write(wakeup_fd, &value, sizeof(value)) < 0 )
+            std::cerr << "[SerialPortManager] Error: could not stop the event loop" << std::endl;
+        loop.join();
+    }
+
+    for (int i = 0; i < (int) ports.size(); i++)
+        close(i);
+
+    if ( wakeup_fd >= 0 )
+        ::close(wakeup_fd);
+    if ( epoll_fd >= 0 )
+        ::close(epoll_fd);
+}
+
+hormodular::SerialPortManager &hormodular::SerialPortManager::getSharedManager()
+{
+    static SerialPortManager manager;
+    return manager;
+}
+
+int hormodular::SerialPortManager::open(const std::string &port_name, int baud_rate, int queue_capacity)
+{
+    speed_t speed;
+    switch ( baud_rate )
+    {
+        case 9600:   speed = B9600;   break;
+        case 19200:  speed = B19200;  break;
+        case 38400:  speed = B38400;  break;
+        case 57600:  speed = B57600;  break;
+        case 115200: speed = B115200; break;
+        case 230400: speed = B230400; break;
+        default:
+            std::cerr << "[SerialPortManager] Error: baud rate " << baud_rate << " not supported" << std::endl;
+            return -1;
+    }
+
+    if ( epoll_fd < 0 )
+        return -1;
+
+    int fd = ::open(port_name.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if ( fd < 0 )
+    {
+        std::cerr << "[SerialPortManager] Error opening the serial port " << port_name << " ("
+                  << strerror(errno) << ")" << std::endl;
+        return -1;
+    }
+
+    //-- Raw mode, 8N1, no flow control
+    struct termios options;
+    if ( tcgetattr(fd, &options) < 0 )
+    {
+        std::cerr << "[SerialPortManager] Error: " << port_name << " is not a serial port" << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    cfmakeraw(&options);
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    options.c_cflag &= ~(CSTOPB | CRTSCTS | PARENB);
+    options.c_cflag |= CS8 | CLOCAL | CREAD;
+    options.c_iflag &= ~(IXON | IXOFF | IXANY);
+
+    if ( tcsetattr(fd, TCSANOW, &options) < 0 )
+    {
+        std::cerr << "[SerialPortManager] Error configuring the serial port " << port_name << " ("
+                  << strerror(errno) << ")" << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    Port * port = new Port;
+    port->fd = fd;
+    port->name = port_name;
+    port->frames.resize(queue_capacity < 2 ? 2 : queue_capacity);
+    port->frame_times.resize(port->frames.size(), 0);
+    port->first_frame = 0;
+    port->queued_frames = 0;
+    port->write_offset = 0;
+    port->waiting_output = false;
+    port->received.reserve(RECEIVE_BUFFER_SIZE);
+    port->failed = false;
+    memset(&port->stats, 0, sizeof(port->stats));
+
+    boost::mutex::scoped_lock lock(ports_mutex);
+    int id = ports.size();
+
+    if ( !updateEvents(id, port, EPOLL_CTL_ADD) )
+    {
+        ::close(fd);
+        delete port;
+        return -1;
+    }
+
+    ports.push_back(port);
+    return id;
+}
+
+bool hormodular::SerialPortManager::close(int port)
+{
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    Port * p = getPort(port);
+    if ( !p )
+        return false;
+
+    if ( !p->failed )
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, p->fd, NULL);
+    ::close(p->fd);
+
+    delete p;
+    ports[port] = NULL;
+
+    //-- Wake up the threads waiting for the port
+    ports_condition.notify_all();
+    return true;
+}
+
+bool hormodular::SerialPortManager::send(int port, const std::vector<unsigned char> &frame)
+{
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    Port * p = getPort(port);
+    if ( !p || p->failed )
+        return false;
+
+    int capacity = p->frames.size();
+
+    //-- Queue full: drop the oldest frame not started yet
+    if ( p->queued_frames == capacity )
+    {
+        if ( p->write_offset > 0 )
+        {
+            //-- The first frame is being written, the second one is dropped
+            int second = (p->first_frame + 1) % capacity;
+            p->frames[p->first_frame].swap(p->frames[second]);
+            std::swap(p->frame_times[p->first_frame], p->frame_times[second]);
+        }
+
+        p->first_frame = (p->first_frame + 1) % capacity;
+        p->queued_frames--;
+        p->stats.frames_dropped++;
+    }
+
+    int last = (p->first_frame + p->queued_frames) % capacity;
+    p->frames[last].assign(frame.begin(), frame.end());
+    p->frame_times[last] = Profiler::now();
+    p->queued_frames++;
+
+    p->stats.frames_queued++;
+    if ( p->queued_frames > p->stats.max_queue_depth )
+        p->stats.max_queue_depth = p->queued_frames;
+
+    //-- Write what the port accepts now, the event loop writes the rest
+    writeQueued(port, p);
+
+    return !p->failed;
+}
+
+bool hormodular::SerialPortManager::receive(int port, std::vector<unsigned char> &data, int size, int timeout_ms)
+{
+    boost::system_time timeout = boost::get_system_time() + boost::posix_time::milliseconds(timeout_ms);
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    data.clear();
+
+    Port * p = getPort(port);
+    while ( p && !p->failed && (int) p->received.size() < size )
+    {
+        if ( !ports_condition.timed_wait(lock, timeout) )
+            break;
+        p = getPort(port);
+    }
+
+    if ( !p || (int) p->received.size() < size )
+        return false;
+
+    data.assign(p->received.begin(), p->received.begin() + size);
+    p->received.erase(p->received.begin(), p->received.begin() + size);
+    return true;
+}
+
+bool hormodular::SerialPortManager::flush(int port, int timeout_ms)
+{
+    boost::system_time timeout = boost::get_system_time() + boost::posix_time::milliseconds(timeout_ms);
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    Port * p = getPort(port);
+    while ( p && !p->failed && p->queued_frames > 0 )
+    {
+        if ( !ports_condition.timed_wait(lock, timeout) )
+            break;
+        p = getPort(port);
+    }
+
+    return p && !p->failed && p->queued_frames == 0;
+}
+
+hormodular::SerialPortManager::PortStats hormodular::SerialPortManager::getStats(int port)
+{
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    Port * p = getPort(port);
+    if ( p )
+        return p->stats;
+
+    PortStats empty;
+    memset(&empty, 0, sizeof(empty));
+    return empty;
+}
+
+void hormodular::SerialPortManager::printStats(int port, std::ostream &out)
+{
+    std::string name = getPortName(port);
+    PortStats stats = getStats(port);
+
+    out << "Port " << name << ":" << std::endl
+        << "  Frames queued / sent / dropped: " << stats.frames_queued << " / " << stats.frames_sent << " / "
+        << stats.frames_dropped << std::endl
+        << "  Bytes written / read: " << stats.bytes_written << " / " << stats.bytes_read << std::endl
+        << "  Partial writes: " << stats.partial_writes << ", errors: " << stats.errors << std::endl
+        << "  Max queue depth: " << stats.max_queue_depth << std::endl;
+
+    if ( stats.frames_sent > 0 )
+        out << "  Latency mean / max: " << stats.total_latency_ns / stats.frames_sent / 1000.0 << "us / "
+            << stats.max_latency_ns / 1000.0 << "us" << std::endl;
+}
+
+void hormodular::SerialPortManager::printStats(std::ostream &out)
+{
+    int num_ids;
+    {
+        boost::mutex::scoped_lock lock(ports_mutex);
+        num_ids = ports.size();
+    }
+
+    for (int i = 0; i < num_ids; i++)
+        if ( !getPortName(i).empty() )
+            printStats(i, out);
+}
+
+std::string hormodular::SerialPortManager::getPortName(int port)
+{
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    Port * p = getPort(port);
+    return p ? p->name : "";
+}
+
+int hormodular::SerialPortManager::getNumPorts()
+{
+    boost::mutex::scoped_lock lock(ports_mutex);
+
+    int num_ports = 0;
+    for (int i = 0; i < (int) ports.size(); i++)
+        if ( ports[i] )
+            num_ports++;
+
+    return num_ports;
+}
+
+void hormodular::SerialPortManager::writeQueued(int id, Port * port)
+{
+    int capacity = port->frames.size();
+
+    while ( port->queued_frames > 0 )
+    {
+        std::vector<unsigned char>& frame = port->frames[port->first_frame];
+        int remaining = frame.size() - port->write_offset;
+
+        ssize_t written = remaining > 0 ? write(port->fd, &frame[port->write_offset], remaining) : 0;
+        if ( written < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+
+            if ( errno == EAGAIN || errno == EWOULDBLOCK )
+            {
+                port->stats.partial_writes++;
+                break;
+            }
+
+            fail(id, port, strerror(errno));
+            return;
+        }
+
+        port->stats.bytes_written += written;
+        port->write_offset += written;
+
+        if ( written < remaining )
+        {
+            //-- The port did not accept the whole frame
+            port->stats.partial_writes++;
+            break;
+        }
+
+        //-- Frame written
+        uint64_t latency = Profiler::now() - port->frame_times[port->first_frame];
+        port->stats.total_latency_ns += latency;
+        if ( latency > port->stats.max_latency_ns )
+            port->stats.max_latency_ns = latency;
+        port->stats.frames_sent++;
+
+        port->first_frame = (port->first_frame + 1) % capacity;
+        port->queued_frames--;
+        port->write_offset = 0;
+    }
+
+    //-- Wait for the port to be writable only while there are frames queued
+    if ( port->waiting_output != (port->queued_frames > 0) )
+        updateEvents(id, port, EPOLL_CTL_MOD);
+
+    if ( port->queued_frames == 0 )
+        ports_condition.notify_all();
+}
+
+void hormodular::SerialPortManager::readAvailable(Port * port)
+{
+    unsigned char buffer[256];
+
+    while ( true )
+    {
+        ssize_t bytes = read(port->fd, buffer, sizeof(buffer));
+        if ( bytes > 0 )
+        {
+            port->received.insert(port->received.end(), buffer, buffer + bytes);
+            port->stats.bytes_read += bytes;
+            continue;
+        }
+
+        if ( bytes < 0 && errno == EINTR )
+            continue;
+        break;
+    }
+
+    //-- Only the newest bytes are kept if nobody reads them
+    if ( (int) port->received.size() > RECEIVE_BUFFER_SIZE )
+        port->received.erase(port->received.begin(), port->received.end() - RECEIVE_BUFFER_SIZE);
+
+    ports_condition.notify_all();
+}
+
+void hormodular::SerialPortManager::fail(int id, Port * port, const std::string& reason)
+{
+    if ( port->failed )
+        return;
+
+    std::cerr << "[SerialPortManager] Error: port " << port->name << " failed (" << reason << ")" << std::endl;
+
+    port->failed = true;
+    port->stats.errors++;
+    port->queued_frames = 0;
+    port->write_offset = 0;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, port->fd, NULL);
+
+    ports_condition.notify_all();
+}
+
+bool hormodular::SerialPortManager::updateEvents(int id, Port * port, int operation)
+{
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | (port->queued_frames > 0 ? EPOLLOUT : 0);
+    event.data.u32 = id;
+
+    if ( epoll_ctl(epoll_fd, operation, port->fd, &event) < 0 )
+    {
+        std::cerr << "[SerialPortManager] Error: could not register the port " << port->name << " on epoll ("
+                  << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+
+    port->waiting_output = port->queued_frames > 0;
+    return true;
+}
+
+hormodular::SerialPortManager::Port * hormodular::SerialPortManager::getPort(int port)
+{
+    if ( port < 0 || port >= (int) ports.size() )
+        return NULL;
+
+    return ports[port];
+}
+
+void hormodular::SerialPortManager::eventLoop()
+{
+    struct epoll_event events[MAX_EVENTS];
+
+    while ( true )
+    {
+        int num_events = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if ( num_events < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+
+            std::cerr << "[SerialPortManager] Error: event loop stopped (" << strerror(errno) << ")" << std::endl;
+            return;
+        }
+
+        boost::mutex::scoped_lock lock(ports_mutex);
+        if ( !running )
+            return;
+
+        for (int i = 0; i < num_events; i++)
+        {
+            if ( events[i].data.u32 == WAKEUP_ID )
+                continue;
+
+            int id = events[i].data.u32;
+            Port * port = getPort(id);
+            if ( !port || port->failed )
+                continue;
+
+            if ( events[i].events & EPOLLIN )
+                readAvailable(port);
+
+            if ( events[i].events & EPOLLOUT )
+                writeQueued(id, port);
+
+            if ( events[i].events & (EPOLLERR | EPOLLHUP) )
+                fail(id, port, "device disconnected");
+        }
+    }
+}
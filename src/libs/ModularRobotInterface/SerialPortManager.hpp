@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//-- SerialPortManager
+//------------------------------------------------------------------------------
+//--
+//-- Driver for several serial ports, handled by a single epoll loop with
+//-- non-blocking writes and an outgoing frame queue per port
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file SerialPortManager.hpp
+ *  \brief Driver for several serial ports, handled by a single epoll loop
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef SERIAL_PORT_MANAGER_H
+#define SERIAL_PORT_MANAGER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <boost/thread.hpp>
+
+namespace hormodular {
+
+/*!
+ *  \class SerialPortManager
+ *  \brief Driver for several serial ports, handled by a single epoll loop
+ *
+ *  Each port is opened non-blocking and has a queue of outgoing frames. send() queues a frame and
+ *  writes as much of the queue as the port accepts without blocking; whatever is left is written
+ *  by the event loop thread when epoll reports the port as writable. The same thread reads the
+ *  incoming bytes of all the ports into a receive buffer per port, that is consumed by receive().
+ *
+ *  When the queue of a port is full (the device does not read as fast as the frames are sent),
+ *  the oldest frame not yet started is dropped: for joint targets only the latest ones matter, and
+ *  a slow robot never blocks the controller or the rest of the robots. Frames are never split, so
+ *  the byte stream of each port is always a sequence of whole frames.
+ *
+ *  The frames of each port reuse the memory of the queue, so sending does not allocate memory once
+ *  each slot of the queue has held a frame of the largest size.
+ */
+class SerialPortManager
+{
+    public:
+        //! \brief Statistics of a port
+        struct PortStats
+        {
+            unsigned long frames_queued;
+            unsigned long frames_sent;
+            //! \brief Frames dropped because the queue was full
+            unsigned long frames_dropped;
+            unsigned long bytes_written;
+            unsigned long bytes_read;
+            //! \brief Writes that could not send the whole queue (the port did not accept more data)
+            unsigned long partial_writes;
+            unsigned long errors;
+            int max_queue_depth;
+            //! \brief Time from queuing a frame to writing its last byte (in ns)
+            uint64_t total_latency_ns;
+            uint64_t max_latency_ns;
+        };
+
+        static const int DEFAULT_BAUD_RATE = 57600;
+        static const int DEFAULT_QUEUE_CAPACITY = 8;
+        static const int RECEIVE_BUFFER_SIZE = 4096;
+
+        //! \brief Creates the epoll instance and starts the event loop thread
+        SerialPortManager();
+
+        //! \brief Stops the event loop and closes all the ports
+        ~SerialPortManager();
+
+        //! \brief Returns the manager shared by all the robots of the process
+        static SerialPortManager& getSharedManager();
+
+        /*!
+         * \brief Opens a serial port (raw mode, 8N1, no flow control) and adds it to the event loop
+         * \param port_name Device of the port (i.e. "/dev/ttyUSB0")
+         * \param baud_rate One of 9600, 19200, 38400, 57600, 115200 or 230400
+         * \param queue_capacity Maximum number of frames waiting to be written (at least 2)
+         * \return Identifier of the port, or -1 if it could not be opened
+         */
+        int open(const std::string& port_name, int baud_rate = DEFAULT_BAUD_RATE,
+                 int queue_capacity = DEFAULT_QUEUE_CAPACITY);
+
+        //! \brief Removes the port from the event loop and closes it, discarding the frames not written
+        bool close(int port);
+
+        /*!
+         * \brief Queues a frame to be written to the port, without blocking
+         * \return False if the port is not open or has failed, true otherwise (even if an older frame
+         * had to be dropped)
+         */
+        bool send(int port, const std::vector<unsigned char>& frame);
+
+        /*!
+         * \brief Waits until the given number of bytes have been received from the port
+         * \param data Bytes received, removed from the receive buffer of the port
+         * \param size Number of bytes to be received
+         * \param timeout_ms Maximum time to wait
+         * \return True if the bytes were received, false on timeout (the bytes are kept) or error
+         */
+        bool receive(int port, std::vector<unsigned char>& data, int size, int timeout_ms);
+
+        /*!
+         * \brief Waits until all the frames queued for the port have been written
+         * \return True if the queue was emptied before the timeout, false otherwise
+         */
+        bool flush(int port, int timeout_ms);
+
+        //! \brief Returns the statistics of a port (all zero if it is not open)
+        PortStats getStats(int port);
+
+        //! \brief Prints the statistics of a port
+        void printStats(int port, std::ostream& out = std::cout);
+
+        //! \brief Prints the statistics of all the ports open
+        void printStats(std::ostream& out = std::cout);
+
+        //! \brief Returns the device of the port, or "" if it is not open
+        std::string getPortName(int port);
+
+        //! \brief Returns the number of ports open
+        int getNumPorts();
+
+    private:
+        struct Port
+        {
+            int fd;
+            std::string name;
+
+            //-- Ring buffer of outgoing frames, and the time they were queued
+            std::vector< std::vector<unsigned char> > frames;
+            std::vector<uint64_t> frame_times;
+            int first_frame;
+            int queued_frames;
+            //! \brief Bytes of the first frame already written
+            int write_offset;
+            //! \brief True while the port is registered on epoll for writing
+            bool waiting_output;
+
+            std::vector<unsigned char> received;
+            bool failed;
+
+            PortStats stats;
+        };
+
+        //! \brief Sends the queued frames of the port until it does not accept more data (with the mutex locked)
+        void writeQueued(int id, Port * port);
+
+        //! \brief Reads all the available bytes of the port (with the mutex locked)
+        void readAvailable(Port * port);
+
+        //! \brief Marks the port as failed and removes it from epoll (with the mutex locked)
+        void fail(int id, Port * port, const std::string& reason);
+
+        //! \brief Registers the port on epoll, for reading and, if there are queued frames, writing
+        bool updateEvents(int id, Port * port, int operation);
+
+        //! \brief Returns the port with that identifier, or NULL (with the mutex locked)
+        Port * getPort(int port);
+
+        //! \brief Handles the events of all the ports until the manager is destroyed
+        void eventLoop();
+
+        int epoll_fd;
+        //! \brief eventfd used to wake up the event loop when the manager is destroyed
+        int wakeup_fd;
+
+        //! \brief Ports indexed by identifier (NULL once closed, identifiers are not reused)
+        std::vector<Port *> ports;
+
+        boost::thread loop;
+        boost::mutex ports_mutex;
+        boost::condition_variable ports_condition;
+        bool running;
+};
+
+}
+
+#endif //-- SERIAL_PORT_MANAGER_H
@@ -17,15 +17,19 @@
 
 #include "SimulatedModularRobotInterface.hpp"
 
-hormodular::SimulatedModularRobotInterface::SimulatedModularRobotInterface(hormodular::ConfigParser configParser)
+hormodular::SimulatedModularRobotInterface::SimulatedModularRobotInterface(hormodular::RobotDescriptionPtr robotDescription,
+                                                                           int num_robots, double copies_gap)
 {
-    environment_file = configParser.getSimulationFile();
+    environment_file = robotDescription->getSimulationFile();
     step_ms = 1;    //!-- \todo Configure this somehow
     step_s = step_ms / (double)1000;
+    substeps = 1;
 
-    simulation = new SimulationOpenRAVE( environment_file, false);
+    this->num_robots = num_robots > 0 ? num_robots : 1;
+    this->copies_gap = copies_gap;
+    simulation = new SimulationOpenRAVE( environment_file, false, this->num_robots, copies_gap);
 
-    controller = simulation->getRobot(0)->GetController();
+    getControllers();
 
     calculatePos();
     start_pos = current_pos;
@@ -60,7 +64,7 @@ bool hormodular::SimulatedModularRobotInterface::destroy()
 bool hormodular::SimulatedModularRobotInterface::reset()
 {
     simulation->reset();
-    controller = simulation->getRobot(0)->GetController();
+    getControllers();
 
     calculatePos();
     start_pos = current_pos;
@@ -71,8 +75,19 @@ bool hormodular::SimulatedModularRobotInterface::reset()
 bool hormodular::SimulatedModularRobotInterface::setProperty(std::string property, std::string value)
 {
     if ( property.compare("viewer") == 0 && value.compare("enabled") == 0)
+        return simulation->showViewer();
+
+    if ( property.compare("substeps") == 0)
     {
-        simulation->showViewer();
+        int value_substeps = atoi(value.c_str());
+        if ( value_substeps < 1 )
+        {
+            std::cerr << "[SimModRobInterface][Error] Number of substeps must be at least 1 (Got: " << value
+                      << ")" << std::endl;
+            return false;
+        }
+
+        substeps = value_substeps;
         return true;
     }
 
@@ -80,41 +95,85 @@ bool hormodular::SimulatedModularRobotInterface::setProperty(std::string propert
 }
 
 float hormodular::SimulatedModularRobotInterface::getTravelledDistance()
+{
+    return getTravelledDistances()[0];
+}
+
+std::vector<float> hormodular::SimulatedModularRobotInterface::getTravelledDistances()
 {
     calculatePos();
-    return sqrt( pow( current_pos.first - start_pos.first, 2) +
-                 pow( current_pos.second - start_pos.second, 2));
+
+    std::vector<float> distances;
+    for (int i = 0; i < (int) current_pos.size(); i++)
+        distances.push_back( sqrt( pow( current_pos[i].first - start_pos[i].first, 2) +
+                                   pow( current_pos[i].second - start_pos[i].second, 2)));
+
+    return distances;
+}
+
+int hormodular::SimulatedModularRobotInterface::getNumRobots() const
+{
+    return num_robots;
+}
+
+double hormodular::SimulatedModularRobotInterface::getCopiesGap() const
+{
+    return copies_gap;
+}
+
+bool hormodular::SimulatedModularRobotInterface::sendJointValues(const std::vector<float>& joint_values, float step_ms)
+{
+    for (int i = 0; i < num_robots; i++)
+        if ( !sendJointValuesToRobot(i, joint_values.empty() ? NULL : &joint_values[0], joint_values.size()) )
+            return false;
+
+    stepSimulation(step_ms);
+    return true;
 }
 
-bool hormodular::SimulatedModularRobotInterface::sendJointValues(std::vector<float> joint_values, float step_ms)
+bool hormodular::SimulatedModularRobotInterface::sendJointValues(const std::vector<std::vector<float> >& joint_values,
+                                                                 float step_ms)
 {
-    if (!controller)
+    if ( (int) joint_values.size() != num_robots )
     {
-        std::cerr << "[SimModRobInterface][Error] Could not access the controller." << std::endl;
+        std::cerr << "[SimModRobInterface][Error] Expected joint values for " << num_robots << " robots, got "
+                  << joint_values.size() << std::endl;
         return false;
     }
 
-    //-- Send joint values to openRAVE:
-    std::stringstream is, os;
-    is << "setpos ";
+    for (int i = 0; i < num_robots; i++)
+        if ( !sendJointValuesToRobot(i, joint_values[i].empty() ? NULL : &joint_values[i][0], joint_values[i].size()) )
+            return false;
 
-    for (int i = 0; i < (int) joint_values.size(); i++)
-        is << joint_values[i] << " ";
+    stepSimulation(step_ms);
+    return true;
+}
 
-    //std::cout << "[Debug] Joint values sent:" << is.str() << std::endl;
-    if (!controller->SendCommand(os,is) )
-        return false;
+bool hormodular::SimulatedModularRobotInterface::sendJointTrajectory(const Trajectory& trajectory, int first_step,
+                                                                    int num_steps, float step_ms)
+{
+    for (int step = first_step; step < first_step + num_steps; step++)
+    {
+        const float * joint_values = trajectory.getJointValues(step);
+        if ( !joint_values )
+        {
+            std::cerr << "[SimModRobInterface][Error] The trajectory is empty" << std::endl;
+            return false;
+        }
 
-    if ( step_ms > 0)
-            simulation->step(step_ms / 1000);
+        for (int i = 0; i < num_robots; i++)
+            if ( !sendJointValuesToRobot(i, joint_values, trajectory.getNumJoints()) )
+                return false;
 
+        stepSimulation(step_ms);
+    }
 
     return true;
 }
 
 std::vector<float> hormodular::SimulatedModularRobotInterface::getJointValues()
 {
-    if (!controller)
+    if ( controllers.empty() || !controllers[0])
     {
         std::cerr << "[SimModRobInterface][Error] Could not access the controller." << std::endl;
         return std::vector<float>();
@@ -123,7 +182,7 @@ std::vector<float> hormodular::SimulatedModularRobotInterface::getJointValues()
     //-- Send request to get the joint values:
     std::stringstream is, os;
     is << "getpos";
-    controller->SendCommand(os,is);
+    controllers[0]->SendCommand(os,is);
 
     //-- Read the returned values:
     std::vector<float> joint_values;
@@ -138,11 +197,68 @@ std::vector<float> hormodular::SimulatedModularRobotInterface::getJointValues()
     return joint_values;
 }
 
+bool hormodular::SimulatedModularRobotInterface::getControllers()
+{
+    controllers.clear();
+
+    std::vector<OpenRAVE::RobotBasePtr> robots = simulation->getRobots();
+    if ( (int) robots.size() < num_robots )
+    {
+        std::cerr << "[SimModRobInterface][Error] Expected " << num_robots << " robots in the environment, found "
+                  << robots.size() << std::endl;
+        num_robots = robots.size();
+    }
+
+    for (int i = 0; i < num_robots; i++)
+        controllers.push_back(robots[i]->GetController());
+
+    return !controllers.empty();
+}
+
+bool hormodular::SimulatedModularRobotInterface::sendJointValuesToRobot(int robot, const float * joint_values,
+                                                                        int num_joints)
+{
+    if (!controllers[robot])
+    {
+        std::cerr << "[SimModRobInterface][Error] Could not access the controller." << std::endl;
+        return false;
+    }
+
+    //-- Send joint values to openRAVE:
+    std::stringstream is, os;
+    is << "setpos ";
+
+    for (int i = 0; i < num_joints; i++)
+        is << joint_values[i] << " ";
+
+    //std::cout << "[Debug] Joint values sent:" << is.str() << std::endl;
+    HORMODULAR_PROFILE_SCOPE(Profiler::JOINT_SEND);
+    return controllers[robot]->SendCommand(os,is);
+}
+
+void hormodular::SimulatedModularRobotInterface::stepSimulation(float step_ms)
+{
+    if ( step_ms > 0)
+    {
+        HORMODULAR_PROFILE_SCOPE(Profiler::SIMULATION_STEP);
+
+        //-- The servocontrollers keep tracking the last joint values sent on all the substeps
+        OpenRAVE::dReal substep_s = step_ms / 1000 / substeps;
+        for (int i = 0; i < substeps; i++)
+            simulation->step(substep_s);
+    }
+}
+
 void hormodular::SimulatedModularRobotInterface::calculatePos()
 {
-    //-- Get current robot position
-    OpenRAVE::Vector robot_pos = simulation->getRobot(0)->GetCenterOfMass();
+    current_pos.resize(num_robots);
+
+    for (int i = 0; i < num_robots; i++)
+    {
+        //-- Get current robot position
+        OpenRAVE::Vector robot_pos = simulation->getRobot(i)->GetCenterOfMass();
 
-    //-- Update current position stored:
-    current_pos = std::pair<float, float>( robot_pos.x, robot_pos.y );
+        //-- Update current position stored:
+        current_pos[i] = std::pair<float, float>( robot_pos.x, robot_pos.y );
+    }
 }
@@ -28,7 +28,8 @@
 
 #include "ModularRobotInterface.hpp"
 #include "SimulationOpenRAVE.hpp"
-#include "ConfigParser.h"
+#include "RobotDescription.hpp"
+#include "Profiler.hpp"
 
 namespace hormodular {
 
@@ -40,7 +41,16 @@ namespace hormodular {
 class SimulatedModularRobotInterface : public ModularRobotInterface
 {
     public:
-        SimulatedModularRobotInterface( ConfigParser configParser);
+        /*!
+         * \brief Creates the interface to the robot described in the configuration
+         * \param robotDescription Description of the robot
+         * \param num_robots Number of copies of the robot placed on the same simulation environment,
+         * that can be driven with different joint values at each step (batched evaluation)
+         * \param copies_gap Free distance (in m) between neighbouring copies of the robot. As the copies
+         * can collide, it must be larger than what two copies can travel towards each other
+         */
+        SimulatedModularRobotInterface( RobotDescriptionPtr robotDescription, int num_robots = 1,
+                                        double copies_gap = 1.0);
 
 
         /*!
@@ -71,10 +81,13 @@ class SimulatedModularRobotInterface : public ModularRobotInterface
 
         /*!
          * \brief Configure a property or parameter of the interface
-         * \param property Property to be changed. Currently, only the "viewer" property
-         * is available, which controls the visibility of the OpenRAVE viewer.
-         * \param value Value to be set on the property. For "viewer", the only
-         * available value is "enable".
+         * \param property Property to be changed:
+         *  - "viewer": controls the visibility of the OpenRAVE viewer. The only available value
+         *    is "enabled".
+         *  - "substeps": number of physics steps (1 by default) in which the simulation time of each
+         *    control step is divided. The joint values sent are held during all the substeps, so that
+         *    the controller can run at a lower rate than the one required for a stable simulation.
+         * \param value Value to be set on the property
          * \return True if completed successfully, false otherwise
          */
         virtual bool setProperty(std::string property, std::string value);
@@ -90,27 +103,61 @@ class SimulatedModularRobotInterface : public ModularRobotInterface
          */
         virtual float getTravelledDistance();
 
-        //! \brief Sends the specified joint position values to the simulated modular robot servocontroller
-        virtual bool sendJointValues(std::vector<float> joint_values, float step_ms=0);
+        //! \brief Returns the distance travelled by each of the copies of the simulated robot
+        std::vector<float> getTravelledDistances();
+
+        //! \brief Returns the number of copies of the robot being simulated
+        int getNumRobots() const;
+
+        //! \brief Returns the free distance (in m) between neighbouring copies of the robot
+        double getCopiesGap() const;
+
+        //! \brief Sends the specified joint position values to the servocontrollers of all the robot copies
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0);
+
+        /*!
+         * \brief Sends a different set of joint values to each robot copy and then steps the simulation once
+         * \param joint_values Joint values for each robot copy (one vector per robot)
+         * \param step_ms Time to advance the simulation after sending the values (if greater than 0)
+         * \return True if completed successfully, false otherwise
+         */
+        bool sendJointValues(const std::vector<std::vector<float> >& joint_values, float step_ms=0);
+
+        //! \brief Streams a batch of steps of a precomputed trajectory to all the robot copies
+        virtual bool sendJointTrajectory(const Trajectory& trajectory, int first_step, int num_steps, float step_ms=0);
 
-        //! \brief Returns the actual joint position values of the simulated modular robot
+        //! \brief Returns the actual joint position values of the simulated modular robot (first copy)
         virtual std::vector<float> getJointValues();
 
     private:
         SimulationOpenRAVE * simulation;
         std::string environment_file;
-        OpenRAVE::ControllerBasePtr controller;
+        std::vector<OpenRAVE::ControllerBasePtr> controllers;
+        int num_robots;
+        double copies_gap;
 
         int step_ms;
         double step_s;
 
+        //! \brief Number of physics steps on each control step
+        int substeps;
+
+        //! \brief Gets the servocontrollers of all the robot copies
+        bool getControllers();
+
+        //! \brief Sends the joint values to the servocontroller of a robot copy
+        bool sendJointValuesToRobot(int robot, const float * joint_values, int num_joints);
+
+        //! \brief Advances the simulation step_ms milliseconds (if greater than 0), in substeps physics steps
+        void stepSimulation(float step_ms);
+
         //-- Position-related things:
 
-        //! \brief Gets robot position and stores it on the current_pos variable
+        //! \brief Gets robot positions and stores them on the current_pos variable
         void calculatePos();
 
-        std::pair<float, float> start_pos;
-        std::pair<float, float> current_pos;
+        std::vector<std::pair<float, float> > start_pos;
+        std::vector<std::pair<float, float> > current_pos;
 };
 
 }
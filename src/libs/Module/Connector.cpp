@@ -21,6 +21,8 @@
 hormodular::Connector::Connector()
 {
     remoteConnector = NULL;
+    incrementalMode = false;
+    inputChanged = true;
 }
 
 bool hormodular::Connector::connectTo(hormodular::Connector * remoteConnector)
@@ -42,6 +44,11 @@ bool hormodular::Connector::sendHormones()
         return false;
     }
 
+    if (incrementalMode)
+    {
+        return remoteConnector->receiveHormones(takeOutputHormones());
+    }
+
     while(outputBuffer.size() > 0)
     {
         remoteConnector->addInputHormone(outputBuffer.back());
@@ -66,6 +73,18 @@ bool hormodular::Connector::clearInputBuffer()
 bool hormodular::Connector::addInputHormone(hormodular::Hormone inputHormone)
 {
     inputBuffer.push_back(inputHormone);
+    inputChanged = true;
+    return true;
+}
+
+bool hormodular::Connector::receiveHormones(const std::vector<hormodular::Hormone> &inputHormones)
+{
+    if ( inputHormones != inputBuffer )
+    {
+        inputBuffer = inputHormones;
+        inputChanged = true;
+    }
+
     return true;
 }
 
@@ -89,3 +108,26 @@ hormodular::Connector *hormodular::Connector::getRemoteConnector()
     return remoteConnector;
 }
 
+void hormodular::Connector::setIncrementalMode(bool incrementalMode)
+{
+    this->incrementalMode = incrementalMode;
+    inputChanged = true;
+}
+
+bool hormodular::Connector::hasInputChanged() const
+{
+    return inputChanged;
+}
+
+void hormodular::Connector::resetInputChanged()
+{
+    inputChanged = false;
+}
+
+std::vector<hormodular::Hormone> hormodular::Connector::takeOutputHormones()
+{
+    //-- Hormones are delivered in the same order as in the non-incremental mode
+    std::vector<Hormone> sentHormones(outputBuffer.rbegin(), outputBuffer.rend());
+    outputBuffer.clear();
+    return sentHormones;
+}
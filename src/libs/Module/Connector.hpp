@@ -48,6 +48,10 @@ class Connector
 
         /*!
          * \brief Send the hormones in the output buffer to their destination modules
+         *
+         * In incremental mode, the hormones sent replace the contents of the remote input buffer,
+         * which are kept until the next time hormones are sent, even if none are sent.
+         *
          * \return True if completed successfully, false otherwise
          */
         bool sendHormones();
@@ -83,6 +87,32 @@ class Connector
         //! \brief Returns the hormones in the input buffer
         std::vector<Hormone> getInputBuffer();
 
+        /*!
+         * \brief Enables or disables the incremental mode
+         *
+         * In incremental mode the input buffer is not cleared after being processed, and it is only
+         * marked as changed when the remote connector sends hormones different from the stored ones.
+         */
+        void setIncrementalMode(bool incrementalMode);
+
+        //! \brief Returns true if the input buffer changed since the last call to resetInputChanged()
+        bool hasInputChanged() const;
+
+        //! \brief Marks the current input buffer as already processed
+        void resetInputChanged();
+
+        /*!
+         * \brief Removes the hormones from the output buffer and returns them, in the order they would
+         * be delivered by sendHormones(). Used to deliver the hormones later on (e.g. with a latency).
+         */
+        std::vector<Hormone> takeOutputHormones();
+
+        /*!
+         * \brief Replaces the input buffer with the given hormones (incremental mode delivery)
+         * \return True if completed successfully, false otherwise
+         */
+        bool receiveHormones( const std::vector<Hormone>& inputHormones );
+
         //! \brief Returns a pointer to the remote connector
         Connector * getRemoteConnector();
 
@@ -93,6 +123,9 @@ class Connector
         Connector * remoteConnector;
         int localOrientation;
 
+        bool incrementalMode;
+        bool inputChanged;
+
         bool addInputHormone(Hormone inputHormone );
 };
 
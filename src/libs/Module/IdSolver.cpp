@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+//-- IdSolver
+//------------------------------------------------------------------------------
+//--
+//-- Computes offline the IDs that the modules of a robot discover with the
+//-- distributed (hormone-based) algorithm
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "IdSolver.hpp"
+
+const int hormodular::IdSolver::STABLE_PERIODS;
+
+hormodular::IdSolver::IdSolver(RobotDescriptionPtr robotDescription)
+{
+    this->robotDescription = robotDescription;
+    warmUpPeriods = 0;
+}
+
+bool hormodular::IdSolver::solve(Module::IdEncoding encoding, int depth)
+{
+    if ( depth < 1 )
+    {
+        std::cerr << "[IdSolver] Error: descriptor depth must be at least 1 (got " << depth << ")" << std::endl;
+        return false;
+    }
+
+    ids.clear();
+    configurationIds.clear();
+    warmUpPeriods = 0;
+
+    if ( encoding == Module::DESCRIPTOR_ID )
+    {
+        solveDescriptorIDs(depth);
+        return true;
+    }
+
+    return solveBase17IDs();
+}
+
+std::vector<unsigned long> hormodular::IdSolver::getIDs()
+{
+    return ids;
+}
+
+std::vector<int> hormodular::IdSolver::getConfigurationIds()
+{
+    return configurationIds;
+}
+
+int hormodular::IdSolver::getWarmUpPeriods()
+{
+    return warmUpPeriods;
+}
+
+std::vector<int> hormodular::IdSolver::getLocalTopology(int module)
+{
+    //-- Same digits as obtained from the ping hormones: remote connector + 4 * relative orientation
+    std::vector<int> localTopology(RobotDescription::NUM_CONNECTORS, 16);
+    const Orientation& orientation = robotDescription->getOrientation(module);
+
+    for (int i = 0; i < RobotDescription::NUM_CONNECTORS; i++)
+    {
+        const RobotDescription::Connection& connection = robotDescription->getConnection(module, i);
+        if ( connection.isConnected() )
+            localTopology[i] = connection.connector + 4 * Orientation::getRelativeOrientation(
+                        i, orientation, robotDescription->getOrientation(connection.module));
+    }
+
+    return localTopology;
+}
+
+unsigned long hormodular::IdSolver::getLocalBase17ID(int module)
+{
+    std::vector<int> localTopology = getLocalTopology(module);
+
+    unsigned long id = 0, weight = 1;
+    for (int i = 0; i < (int) localTopology.size(); i++)
+    {
+        id += localTopology[i] * weight;
+        weight *= 17;
+    }
+
+    return id;
+}
+
+std::vector<unsigned long> hormodular::IdSolver::getDescriptorIDs(int depth)
+{
+    int numModules = robotDescription->getNumModules();
+
+    //-- Depth 0: connections of each module
+    std::vector<uint32_t> localDescriptors(numModules);
+    for (int i = 0; i < numModules; i++)
+    {
+        std::vector<int> localTopology = getLocalTopology(i);
+
+        localDescriptors[i] = FNV1A_OFFSET_BASIS;
+        for (int j = 0; j < (int) localTopology.size(); j++)
+            localDescriptors[i] = hashFNV1a(localDescriptors[i], localTopology[j]);
+    }
+
+    //-- Depth k: connections of each module and descriptors of depth k-1 of its neighbours (0 if none)
+    std::vector<uint32_t> descriptors = localDescriptors;
+    for (int k = 1; k <= depth; k++)
+    {
+        std::vector<uint32_t> nextDescriptors(numModules);
+        for (int i = 0; i < numModules; i++)
+        {
+            nextDescriptors[i] = localDescriptors[i];
+            for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+            {
+                const RobotDescription::Connection& connection = robotDescription->getConnection(i, j);
+                nextDescriptors[i] = hashFNV1a(nextDescriptors[i],
+                                               connection.isConnected() ? descriptors[connection.module] : 0);
+            }
+        }
+        descriptors = nextDescriptors;
+    }
+
+    return std::vector<unsigned long>(descriptors.begin(), descriptors.end());
+}
+
+void hormodular::IdSolver::solveDescriptorIDs(int depth)
+{
+    int numModules = robotDescription->getNumModules();
+    ids = getDescriptorIDs(depth);
+
+    //-- The configuration is given by the first gait table that contains the ID. Otherwise, modules
+    //-- keep the one they start with: the first one that has a gait table
+    const std::vector<std::string>& gaitTableFiles = robotDescription->getGaitTableFiles();
+    int defaultConfigurationId = 0;
+    while ( defaultConfigurationId < (int) gaitTableFiles.size() - 1 && gaitTableFiles[defaultConfigurationId].empty() )
+        defaultConfigurationId++;
+
+    configurationIds.assign(numModules, -1);
+    for (int i = 0; i < (int) gaitTableFiles.size(); i++)
+    {
+        if ( gaitTableFiles[i].empty() )
+            continue;
+
+        GaitTable gaitTable(robotDescription->getGaitTableFolder() + gaitTableFiles[i]);
+        for (int j = 0; j < numModules; j++)
+            if ( configurationIds[j] == -1 && gaitTable.hasID(ids[j]) )
+                configurationIds[j] = i;
+    }
+
+    for (int i = 0; i < numModules; i++)
+        if ( configurationIds[i] == -1 )
+            configurationIds[i] = defaultConfigurationId;
+
+    //-- Ping hormones arrive on the second period, and each depth takes one more period
+    warmUpPeriods = depth + 1;
+}
+
+bool hormodular::IdSolver::solveBase17IDs()
+{
+    int numModules = robotDescription->getNumModules();
+
+    //-- Modules without oscillators running nor robot interface, connected as in the robot
+    ModuleArray moduleArray(robotDescription, numModules);
+    std::vector<Module *> modules;
+    for (int i = 0; i < numModules; i++)
+        modules.push_back( new Module(robotDescription, i, &moduleArray) );
+
+    for (int i = 0; i < numModules; i++)
+        for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+        {
+            const RobotDescription::Connection& connection = robotDescription->getConnection(i, j);
+            if ( connection.isConnected() )
+                modules[i]->attach( j, modules[connection.module]->getConnector(connection.connector));
+            else
+                modules[i]->attach(j, NULL);
+        }
+
+    //-- Hormones travel one module per period, so the roles are found in a number of periods
+    //-- proportional to the number of modules
+    int periods = 4 * numModules + STABLE_PERIODS;
+
+    //-- Only the IDs of the previous period are kept, and the last period in which they changed
+    std::vector<unsigned long> currentIds(numModules), previousIds(numModules);
+    std::vector<int> currentConfigurationIds(numModules), previousConfigurationIds(numModules);
+    int lastChangePeriod = 0;
+
+    for (int period = 0; period < periods; period++)
+    {
+        for (int i = 0; i < numModules; i++)
+            modules[i]->processHormones();
+
+        for (int i = 0; i < numModules; i++)
+        {
+            currentIds[i] = modules[i]->getID();
+            currentConfigurationIds[i] = modules[i]->getConfigurationId();
+            modules[i]->sendHormones();
+        }
+
+        if ( period > 0 && ( currentIds != previousIds || currentConfigurationIds != previousConfigurationIds ) )
+            lastChangePeriod = period;
+
+        previousIds.swap(currentIds);
+        previousConfigurationIds.swap(currentConfigurationIds);
+    }
+
+    for (int i = 0; i < numModules; i++)
+        delete modules[i];
+
+    ids = previousIds;
+    configurationIds = previousConfigurationIds;
+
+    //-- The IDs of the periods before the last change are different from the final ones
+    warmUpPeriods = lastChangePeriod;
+
+    if ( warmUpPeriods > periods - STABLE_PERIODS )
+    {
+        std::cerr << "[IdSolver] Error: module IDs did not converge after " << periods << " periods" << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//-- IdSolver
+//------------------------------------------------------------------------------
+//--
+//-- Computes offline the IDs that the modules of a robot discover with the
+//-- distributed (hormone-based) algorithm
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file IdSolver.hpp
+ *  \brief Computes offline the IDs that the modules of a robot discover with the distributed algorithm
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef ID_SOLVER_H
+#define ID_SOLVER_H
+
+#include <vector>
+
+#include "Module.hpp"
+#include "RobotDescription.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class IdSolver
+ *  \brief Computes offline the final ID and configuration ID of each module of a robot
+ *
+ *  The modules discover their IDs exchanging hormones with their neighbours, which takes several
+ *  communication periods. The solver obtains the IDs they converge to from the robot description,
+ *  as well as the number of periods the distributed algorithm needs to reach them, so that the
+ *  modules can be warm-started with them (see Module::setWarmStart()) and the results of the
+ *  distributed algorithm can be validated.
+ *
+ *  The local base-17 IDs and the descriptor IDs are computed directly from the connections and the
+ *  orientations of the modules. The leg and head roles of the base-17 IDs depend on the order in
+ *  which the hormones are relayed, so they are obtained running the hormone exchange (without
+ *  oscillators nor robot interface) until the IDs are stable.
+ */
+class IdSolver
+{
+    public:
+        IdSolver(RobotDescriptionPtr robotDescription);
+
+        /*!
+         * \brief Computes the final IDs of the modules
+         * \param encoding Encoding of the module IDs
+         * \param depth Descriptor depth, for descriptor IDs
+         * \return True if completed successfully, false if the IDs do not converge
+         */
+        bool solve(Module::IdEncoding encoding = Module::BASE17_ID, int depth = Module::DEFAULT_DESCRIPTOR_DEPTH);
+
+        //! \brief Returns the final ID of each module, as computed by the last call to solve()
+        std::vector<unsigned long> getIDs();
+
+        //! \brief Returns the final configuration ID of each module, as computed by the last call to solve()
+        std::vector<int> getConfigurationIds();
+
+        /*!
+         * \brief Returns the number of communication periods after which the IDs and configuration IDs
+         * obtained by the modules are not yet the final ones
+         */
+        int getWarmUpPeriods();
+
+        /*!
+         * \brief Returns the base-17 digit of each connector of a module (16 if not connected), as
+         * obtained by the module from the ping hormones
+         */
+        std::vector<int> getLocalTopology(int module);
+
+        //! \brief Returns the base-17 ID of a module, without leg and head roles
+        unsigned long getLocalBase17ID(int module);
+
+        /*!
+         * \brief Returns the descriptor ID of each module, without looking for their configuration on the
+         * gait tables (unlike solve())
+         */
+        std::vector<unsigned long> getDescriptorIDs(int depth);
+
+    private:
+        //! \brief Computes the descriptor IDs, and the configuration IDs from the gait tables
+        void solveDescriptorIDs(int depth);
+
+        //! \brief Runs the hormone exchange with base-17 IDs until the IDs are stable
+        bool solveBase17IDs();
+
+        RobotDescriptionPtr robotDescription;
+        std::vector<unsigned long> ids;
+        std::vector<int> configurationIds;
+        int warmUpPeriods;
+
+        //! \brief Periods with the same IDs required to consider that the hormone exchange converged
+        static const int STABLE_PERIODS = 10;
+};
+
+}
+
+#endif //-- ID_SOLVER_H
@@ -17,36 +17,28 @@
 
 #include "Module.hpp"
 
-hormodular::Module::Module(ConfigParser configParser, int index)
+const int hormodular::Module::DEFAULT_DESCRIPTOR_DEPTH;
+const unsigned long hormodular::Module::LEG_BASE17_ID;
+
+hormodular::Module::Module(RobotDescriptionPtr robotDescription, int index, ModuleArray *moduleArray) :
+    moduleArray( moduleArray ? moduleArray : new ModuleArray(robotDescription, 1) ),
+    ownsModuleArray( moduleArray == NULL ),
+    module_index( moduleArray ? index : 0 ),
+    id( this->moduleArray->ids[module_index] ),
+    configurationId( this->moduleArray->configurationIds[module_index] ),
+    currentJointPos( this->moduleArray->jointPositions[module_index] ),
+    elapsedTime( this->moduleArray->elapsedTimes[module_index] )
 {
-    //-- Store absolute id in the robot:
-    module_index = index;
-
     //-- Create connectors
     for(int i = 0; i < 4; i++)
         connectors.push_back(new Connector() );
 
-    //-- Create sinusoidal oscillator
-    oscillator = new SinusoidalOscillator();
-
-    //-- Create gait tables
-    //! \todo Use configParser for this:
-    //const std::string GAIT_TABLE_FILEPATH = "../../data/test/test_gait_table.txt";
-    //const std::string GAIT_TABLE_FILEPATH = "../data/test/test_gait_table.txt";
-    const std::string GAIT_TABLE_MULTIDOF_11 = "multidof-11-2-gaittable.txt";
-    const std::string GAIT_TABLE_MULTIDOF_7 = "multidof-7-tripod-gaittable.txt";
-    const std::string GAIT_TABLE_MULTIDOF_9 = "multidof-9-quad-gaittable.txt";
-
-
-    gaitTables.push_back(new GaitTable(configParser.getGaitTableFolder() + GAIT_TABLE_MULTIDOF_11));
-    gaitTables.push_back(new GaitTable(configParser.getGaitTableFolder() + GAIT_TABLE_MULTIDOF_7));
-    gaitTables.push_back(new GaitTable(configParser.getGaitTableFolder() + GAIT_TABLE_MULTIDOF_9));
-
-    //-- Load frequency table:
-    frequencyTable = new GaitTable(configParser.getFrequencyTableFile());
-
     //-- Load orientation
-    orientation = configParser.getOrientations()[index];
+    orientation = robotDescription->getOrientation(index);
+
+    incrementalMode = false;
+    warmStartPeriods = 0;
+    setIdEncoding(BASE17_ID);
 
     reset();
 }
@@ -59,26 +51,33 @@ hormodular::Module::~Module()
         connectors[i] = NULL;
     }
 
-    delete oscillator;
-    oscillator = NULL;
-
-    for(int i = 0; i < (int)gaitTables.size(); i++)
-    {
-        delete gaitTables[i];
-        gaitTables[i] = NULL;
-    }
-
-    delete frequencyTable;
-    frequencyTable = NULL;
+    if ( ownsModuleArray )
+        delete moduleArray;
+    moduleArray = NULL;
 }
 
 bool hormodular::Module::reset()
 {
    id = (unsigned long) -1;
-   configurationId = 0;
+
+   //-- Until the configuration is discovered, use the first one that has a gait table
+   configurationId = moduleArray->getDefaultConfigurationId();
+
+   //-- IDs computed offline, if any, are used until the distributed algorithm converges
+   warmStartPeriodsLeft = warmStartPeriods;
+   if ( warmStartPeriods > 0 )
+   {
+       id = warmStartID;
+       configurationId = warmStartConfigurationId;
+   }
+
    currentJointPos = 0;
    elapsedTime = 0;
 
+   forceRecompute = true;
+   recomputed = false;
+   oscillatorOutdated = true;
+
    return true;
 }
 
@@ -96,6 +95,9 @@ bool hormodular::Module::attach(int localConnector, Connector *remoteConnector,
     //! \todo I think this is already solved by using the Orientation class (no longer neeeded)
     connectors[localConnector]->setLocalOrientation(orientation);
 
+    //-- Topology may have changed
+    forceRecompute = true;
+
     return true;
 }
 
@@ -114,6 +116,30 @@ hormodular::Connector *hormodular::Module::getConnector(int localConnector)
 
 bool hormodular::Module::processHormones()
 {
+    //-- In incremental mode, skip processing if inputs did not change since last time
+    if ( incrementalMode && !forceRecompute )
+    {
+        bool inputChanged = false;
+        for (int i = 0; i < (int) connectors.size(); i++)
+            if ( connectors[i]->hasInputChanged() )
+            {
+                inputChanged = true;
+                break;
+            }
+
+        if ( !inputChanged )
+        {
+            recomputed = false;
+            return true;
+        }
+    }
+
+    forceRecompute = false;
+    recomputed = true;
+
+    unsigned long previousID = id;
+    int previousConfigurationId = configurationId;
+
     //-- Ping Hormones processing & sending
     //-----------------------------------------------------------------------------------------------------
     std::vector<Connector *> activeConnectors;
@@ -121,6 +147,7 @@ bool hormodular::Module::processHormones()
 
     //-- Find local ID from "Ping" hormones
     unsigned int tempID = 0;
+    std::vector<int> localTopology(connectors.size(), 16);
 
     for (int i = 0; i < (int) connectors.size(); i++)
         if ( connectors[i] != NULL )
@@ -133,7 +160,8 @@ bool hormodular::Module::processHormones()
                 {
                     Hormone pingHormone = connectors[i]->getInputBuffer()[j];
 
-                    tempID += (pingHormone.getSourceConnector() + Orientation::getRelativeOrientation(i, orientation, Orientation(pingHormone.getData()))* 4) * pow(17, i);
+                    localTopology[i] = pingHormone.getSourceConnector() + Orientation::getRelativeOrientation(i, orientation, Orientation(pingHormone.getData()))* 4;
+                    tempID += localTopology[i] * pow(17, i);
 
                     foundPingHormone = true;
                     activeConnectorsIndex.push_back(i);
@@ -158,6 +186,13 @@ bool hormodular::Module::processHormones()
     for (int i = 0; i < (int) connectors.size(); i++)
             connectors[i]->addOutputHormone( Hormone( i, Hormone::PING_HORMONE, orientation.str()));
 
+    //-- Descriptor IDs do not need the leg and head hormones
+    if ( idEncoding == DESCRIPTOR_ID )
+    {
+        processTopologyHormones(localTopology);
+        finishHormoneProcessing(previousID, previousConfigurationId);
+        return true;
+    }
 
     //-- Leg hormones processing & sending
     //-------------------------------------------------------------------------------------------------------
@@ -260,7 +295,7 @@ bool hormodular::Module::processHormones()
                     configurationId = atoi(splitHormoneData[0].c_str());
 
                     if (legModule)
-                        id = 83521 + atoi(splitHormoneData[1].c_str());
+                        id = LEG_BASE17_ID + atoi(splitHormoneData[1].c_str());
 
                     break;
                 }
@@ -290,17 +325,92 @@ bool hormodular::Module::processHormones()
     }
 
 
-    //-- Clean input buffers
-    for (int i = 0; i < (int) connectors.size(); i++)
-        connectors[i]->clearInputBuffer();
+    finishHormoneProcessing(previousID, previousConfigurationId);
 
     //std::cout << "[Debug] Id: " << id << "-> " << configurationId << std::endl;
 
    return true;
 }
 
+void hormodular::Module::processTopologyHormones(const std::vector<int> &localTopology)
+{
+    //-- Depth 0: connections of this module
+    uint32_t localDescriptor = FNV1A_OFFSET_BASIS;
+    for (int i = 0; i < (int) localTopology.size(); i++)
+        localDescriptor = hashFNV1a(localDescriptor, localTopology[i]);
+
+    //-- Descriptors sent by the neighbours on the previous period (none on empty connectors)
+    std::vector<std::vector<std::string> > neighbourDescriptors(connectors.size());
+    for (int i = 0; i < (int) connectors.size(); i++)
+        for (int j = 0; j < (int) connectors[i]->getInputBuffer().size(); j++)
+            if ( connectors[i]->getInputBuffer()[j].getType() == Hormone::TOPOLOGY_HORMONE )
+            {
+                neighbourDescriptors[i] = splitString(connectors[i]->getInputBuffer()[j].getData());
+                break;
+            }
+
+    //-- Depth k: connections of this module and descriptors of depth k-1 of the neighbours
+    descriptors[0] = localDescriptor;
+    for (int k = 1; k <= descriptorDepth; k++)
+    {
+        uint32_t descriptor = localDescriptor;
+        for (int i = 0; i < (int) neighbourDescriptors.size(); i++)
+        {
+            uint32_t neighbourDescriptor = 0;
+            if ( k - 1 < (int) neighbourDescriptors[i].size() )
+                neighbourDescriptor = strtoul(neighbourDescriptors[i][k-1].c_str(), NULL, 10);
+
+            descriptor = hashFNV1a(descriptor, neighbourDescriptor);
+        }
+        descriptors[k] = descriptor;
+    }
+
+    id = descriptors[descriptorDepth];
+
+    //-- Send the descriptors that the neighbours need to compute theirs
+    std::stringstream topologyStr;
+    for (int k = 0; k < descriptorDepth; k++)
+        topologyStr << (k == 0 ? "" : " ") << descriptors[k];
+
+    for (int i = 0; i < (int) connectors.size(); i++)
+        connectors[i]->addOutputHormone( Hormone( i, Hormone::TOPOLOGY_HORMONE, topologyStr.str()));
+
+    //-- The configuration is given by the gait table that contains this descriptor
+    for (int i = 0; i < moduleArray->getNumConfigurations(); i++)
+        if ( moduleArray->getGaitTable(i) && moduleArray->getGaitTable(i)->hasID(id) )
+        {
+            configurationId = i;
+            break;
+        }
+}
+
+void hormodular::Module::finishHormoneProcessing(unsigned long previousID, int previousConfigurationId)
+{
+    //-- Keep the warm start IDs while the distributed algorithm converges
+    if ( warmStartPeriodsLeft > 0 )
+    {
+        warmStartPeriodsLeft--;
+        id = warmStartID;
+        configurationId = warmStartConfigurationId;
+    }
+
+    //-- Clean input buffers (in incremental mode they are kept to be compared with the next ones)
+    for (int i = 0; i < (int) connectors.size(); i++)
+        if ( incrementalMode )
+            connectors[i]->resetInputChanged();
+        else
+            connectors[i]->clearInputBuffer();
+
+    if ( id != previousID || configurationId != previousConfigurationId )
+        oscillatorOutdated = true;
+}
+
 bool hormodular::Module::sendHormones()
 {
+    //-- In incremental mode, previously sent hormones are still valid if nothing was recomputed
+    if ( incrementalMode && !recomputed )
+        return true;
+
     for(int i = 0; i < (int) connectors.size(); i++)
         connectors[i]->sendHormones();
 
@@ -309,16 +419,40 @@ bool hormodular::Module::sendHormones()
 
 bool hormodular::Module::updateOscillatorParameters()
 {
-    std::vector<float> parameters = gaitTables[configurationId]->getParameters(id);
-    int period = (int) ( 1000.0 / frequencyTable->getParameters(configurationId)[0]);
-    oscillator->setParameters(parameters[0], parameters[1], parameters[2], period);
+    if ( incrementalMode && !oscillatorOutdated )
+        return true;
+
+    GaitTable * gaitTable = moduleArray->getGaitTable(configurationId);
+    if ( !gaitTable )
+    {
+        std::cerr << "[Module] Error: no gait table for configuration " << configurationId << std::endl;
+        return false;
+    }
+
+    //-- Rows of the tables are read without copying them
+    const std::vector<float>& parameters = gaitTable->getRow(id);
+    const std::vector<float>& frequency = moduleArray->getFrequencyTable()->getRow(configurationId);
+    if ( parameters.size() < 3 || frequency.size() < 1 )
+    {
+        std::cerr << "[Module] Error: missing parameters for configuration " << configurationId << std::endl;
+        return false;
+    }
+
+    int period = (int) ( 1000.0 / frequency[0]);
+    //-- The oscillator checks the ranges of the parameters, which are stored on the module array
+    SinusoidalOscillator oscillator(parameters[0], parameters[1], parameters[2], period);
+    moduleArray->amplitudes[module_index] = oscillator.getAmplitude();
+    moduleArray->offsets[module_index] = oscillator.getOffset();
+    moduleArray->phases[module_index] = M_PI * oscillator.getPhase() / 180;
+    moduleArray->periods[module_index] = oscillator.getPeriod();
+    oscillatorOutdated = false;
 
     return true;
 }
 
 float hormodular::Module::calculateNextJointPos()
 {
-    currentJointPos = oscillator->calculatePos(elapsedTime);
+    currentJointPos = moduleArray->calculateJointPosition(module_index);
     return currentJointPos;
 }
 
@@ -333,7 +467,80 @@ unsigned long hormodular::Module::getID()
     return id;
 }
 
+int hormodular::Module::getConfigurationId()
+{
+    return configurationId;
+}
+
 float hormodular::Module::getCurrentJointPos()
 {
     return currentJointPos;
 }
+
+void hormodular::Module::setIncrementalMode(bool incrementalMode)
+{
+    this->incrementalMode = incrementalMode;
+
+    for (int i = 0; i < (int) connectors.size(); i++)
+        connectors[i]->setIncrementalMode(incrementalMode);
+
+    forceRecompute = true;
+    oscillatorOutdated = true;
+}
+
+bool hormodular::Module::setIdEncoding(IdEncoding encoding, int depth)
+{
+    if ( depth < 1 )
+    {
+        std::cerr << "[Module] Error: descriptor depth must be at least 1 (got " << depth << ")" << std::endl;
+        return false;
+    }
+
+    idEncoding = encoding;
+    descriptorDepth = depth;
+    descriptors.assign(depth + 1, 0);
+
+    //-- IDs computed offline are no longer valid
+    warmStartPeriods = 0;
+    warmStartPeriodsLeft = 0;
+
+    forceRecompute = true;
+    oscillatorOutdated = true;
+
+    return true;
+}
+
+hormodular::Module::IdEncoding hormodular::Module::getIdEncoding()
+{
+    return idEncoding;
+}
+
+int hormodular::Module::getDescriptorDepth()
+{
+    return descriptorDepth;
+}
+
+bool hormodular::Module::getIncrementalMode()
+{
+    return incrementalMode;
+}
+
+bool hormodular::Module::wasRecomputed()
+{
+    return recomputed;
+}
+
+void hormodular::Module::setWarmStart(unsigned long id, int configurationId, int periods)
+{
+    warmStartID = id;
+    warmStartConfigurationId = configurationId;
+    warmStartPeriods = periods > 0 ? periods : 0;
+    warmStartPeriodsLeft = warmStartPeriods;
+
+    if ( warmStartPeriods > 0 )
+    {
+        this->id = id;
+        this->configurationId = configurationId;
+        oscillatorOutdated = true;
+    }
+}
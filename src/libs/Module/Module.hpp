@@ -29,8 +29,9 @@
 
 #include "Connector.hpp"
 #include "SinusoidalOscillator.h"
-#include "ConfigParser.h"
+#include "RobotDescription.hpp"
 #include "GaitTable.h"
+#include "ModuleArray.hpp"
 #include "Orientation.hpp"
 #include "Utils.hpp"
 
@@ -46,11 +47,13 @@ class Module
     public:
         /*!
          * \brief Creates a Module, indicating which position it occuppies inside the modular robot
-         * \param configParser ConfigParser object contaning the module configuration parameters
+         * \param robotDescription Description of the robot containing the module configuration parameters
          * \param index Position occupied by the module inside the modular robot, used to extract the
          *  correct configuration from the configParser, as well as for debugging purposes.
+         * \param moduleArray Storage of the state of the modules of the robot, where this module uses
+         *  position \a index. If NULL, the module creates its own storage.
          */
-        Module(ConfigParser configParser, int index);
+        Module(RobotDescriptionPtr robotDescription, int index, ModuleArray * moduleArray = NULL);
         ~Module();
 
 
@@ -75,6 +78,10 @@ class Module
 
         /*!
          * \brief Process the incoming hormones, and discover the different  module IDs from them
+         *
+         * In incremental mode, if the input buffers are identical to the ones processed in the
+         * previous call the module ID and role are not recomputed and no hormones are generated.
+         *
          * \return True if completed successfully, false otherwise
          */
         bool processHormones();
@@ -105,21 +112,102 @@ class Module
 
 
         unsigned long getID();
+        int getConfigurationId();
         float getCurrentJointPos();
 
+        /*!
+         * \brief Enables or disables the incremental mode, in which hormones are only processed and
+         * propagated when the input buffers change
+         */
+        void setIncrementalMode(bool incrementalMode);
+        bool getIncrementalMode();
+
+        //! \brief Returns true if the last call to processHormones() recomputed the module ID and role
+        bool wasRecomputed();
+
+        /*!
+         * \brief Sets the final ID and configuration ID of the module, computed offline (see IdSolver)
+         *
+         * They are used from now on and after each reset(), replacing the ones obtained by processHormones()
+         * on the first \a periods calls, while the distributed algorithm has not converged yet (hormones are
+         * exchanged as usual). Changing the ID encoding disables the warm start.
+         *
+         * \param periods Number of calls to processHormones() whose results are replaced, 0 to disable
+         */
+        void setWarmStart(unsigned long id, int configurationId, int periods);
+
+        //! \brief Encodings available for the module IDs
+        enum IdEncoding
+        {
+            //! \brief Base-17 number over the 4 connectors, with the leg and head roles of the known robots
+            BASE17_ID,
+            //! \brief Hash of the topology of the neighbourhood of the module up to a given depth
+            DESCRIPTOR_ID
+        };
+
+        /*!
+         * \brief Selects the encoding used for the module IDs
+         *
+         * With descriptor IDs, the ID of a module is a hash of the connections of all the modules
+         * up to \a depth hops away, obtained exchanging topology hormones with the neighbours (it
+         * converges after \a depth + 2 communication periods). It does not depend on the number of
+         * modules, and the configuration ID is the index of the first gait table containing the ID.
+         * Since only the neighbourhood of each module is hashed, modules in symmetric positions of
+         * the robot get the same ID whatever the depth, so symmetric robots are not supported.
+         *
+         * \param depth Number of hops of the neighbourhood hashed on the descriptor IDs
+         * \return True if completed successfully, false otherwise
+         */
+        bool setIdEncoding(IdEncoding encoding, int depth = DEFAULT_DESCRIPTOR_DEPTH);
+        IdEncoding getIdEncoding();
+        int getDescriptorDepth();
+
+        static const int DEFAULT_DESCRIPTOR_DEPTH = 4;
+
+        //! \brief First base-17 ID assigned to leg modules (17^4, above the IDs of any 4 connector module)
+        static const unsigned long LEG_BASE17_ID = 83521;
+
 
     private:
-        ConfigParser configParser;
-        std::vector<GaitTable *> gaitTables;
-        GaitTable * frequencyTable;
+        //! \brief Storage of the module state, shared with the other modules of the robot
+        ModuleArray * moduleArray;
+        bool ownsModuleArray;
+        int module_index; //-- Position of the module on moduleArray
+
+        //-- State of the module, stored on moduleArray
+        unsigned long& id;
+        int& configurationId;
+        float& currentJointPos;
+        unsigned long& elapsedTime; //-- This time is in uS
+
         std::vector<Connector*> connectors;
-        Oscillator* oscillator;
-        int module_index;
-        unsigned long id;
-        int configurationId;
-        float currentJointPos;
-        unsigned long elapsedTime; //-- This time is in uS
         Orientation orientation;
+
+        bool incrementalMode;
+        bool forceRecompute;
+        bool recomputed;
+        bool oscillatorOutdated;
+
+        IdEncoding idEncoding;
+        int descriptorDepth;
+
+        unsigned long warmStartID;
+        int warmStartConfigurationId;
+        int warmStartPeriods;
+        int warmStartPeriodsLeft;
+
+        //! \brief Descriptors of this module for each depth, from 0 (local connections) to descriptorDepth
+        std::vector<uint32_t> descriptors;
+
+        /*!
+         * \brief Computes the descriptor ID from the topology hormones received and sends the
+         * descriptors of lower depth to the neighbours
+         * \param localTopology Base-17 digit (connection to each connector) of this module
+         */
+        void processTopologyHormones(const std::vector<int>& localTopology);
+
+        //! \brief Clears the processed input buffers and checks if the oscillator must be updated
+        void finishHormoneProcessing(unsigned long previousID, int previousConfigurationId);
 };
 
 }
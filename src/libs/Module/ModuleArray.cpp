@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+//-- ModuleArray
+//------------------------------------------------------------------------------
+//--
+//-- Storage of the state of all the modules of a robot, one array per field
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "ModuleArray.hpp"
+
+#include <cmath>
+
+hormodular::ModuleArray::ModuleArray(RobotDescriptionPtr robotDescription, int numModules)
+{
+    this->numModules = numModules;
+
+    ids.assign(numModules, (unsigned long) -1);
+    configurationIds.assign(numModules, 0);
+
+    //-- Same default parameters as the oscillators
+    amplitudes.assign(numModules, 0);
+    offsets.assign(numModules, 0);
+    phases.assign(numModules, 0);
+    periods.assign(numModules, 4000);
+
+    elapsedTimes.assign(numModules, 0);
+    jointPositions.assign(numModules, 0);
+
+    //-- Gait tables and frequency table are loaded on first use
+    const std::vector<std::string>& gaitTableNames = robotDescription->getGaitTableFiles();
+    for (int i = 0; i < (int) gaitTableNames.size(); i++)
+        gaitTableFiles.push_back( gaitTableNames[i].empty() ? "" : robotDescription->getGaitTableFolder() + gaitTableNames[i]);
+
+    gaitTables.assign(gaitTableFiles.size(), (GaitTable *) NULL);
+
+    frequencyTableFile = robotDescription->getFrequencyTableFile();
+    frequencyTable = NULL;
+}
+
+hormodular::ModuleArray::~ModuleArray()
+{
+    for(int i = 0; i < (int)gaitTables.size(); i++)
+    {
+        delete gaitTables[i];
+        gaitTables[i] = NULL;
+    }
+
+    delete frequencyTable;
+    frequencyTable = NULL;
+}
+
+int hormodular::ModuleArray::size()
+{
+    return numModules;
+}
+
+void hormodular::ModuleArray::calculateJointPositions(std::vector<float> &jointValues)
+{
+    jointValues.resize(numModules);
+
+    for (int i = 0; i < numModules; i++)
+    {
+        jointPositions[i] = calculateJointPosition(i);
+        jointValues[i] = jointPositions[i];
+    }
+}
+
+void hormodular::ModuleArray::updateElapsedTime(float timeIncrement_ms)
+{
+    unsigned long timeIncrement = (unsigned long) (timeIncrement_ms*1000);
+
+    for (int i = 0; i < numModules; i++)
+        elapsedTimes[i] += timeIncrement;
+}
+
+hormodular::GaitTable *hormodular::ModuleArray::getGaitTable(int configurationId)
+{
+    if ( configurationId < 0 || configurationId >= (int) gaitTables.size()
+         || gaitTableFiles[configurationId].empty() )
+        return NULL;
+
+    if ( !gaitTables[configurationId] )
+        gaitTables[configurationId] = new GaitTable(gaitTableFiles[configurationId]);
+
+    return gaitTables[configurationId];
+}
+
+int hormodular::ModuleArray::getNumConfigurations()
+{
+    return gaitTables.size();
+}
+
+hormodular::GaitTable *hormodular::ModuleArray::getFrequencyTable()
+{
+    if ( !frequencyTable )
+        frequencyTable = new GaitTable(frequencyTableFile);
+
+    return frequencyTable;
+}
+
+void hormodular::ModuleArray::loadGaitTables()
+{
+    for (int i = 0; i < (int) gaitTables.size(); i++)
+        getGaitTable(i);
+
+    getFrequencyTable();
+}
+
+int hormodular::ModuleArray::getDefaultConfigurationId()
+{
+    int configurationId = 0;
+    while ( configurationId < (int) gaitTableFiles.size() - 1 && gaitTableFiles[configurationId].empty() )
+        configurationId++;
+
+    return configurationId;
+}
+
+float hormodular::ModuleArray::calculateJointPosition(int module)
+{
+    //-- Same as SinusoidalOscillator::calculatePos(), with the phase already in radians
+    return amplitudes[module]*sin( 2*M_PI*elapsedTimes[module]/(periods[module]*1000) + phases[module])
+            + offsets[module];
+}
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//-- ModuleArray
+//------------------------------------------------------------------------------
+//--
+//-- Storage of the state of all the modules of a robot, one array per field
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file ModuleArray.hpp
+ *  \brief Storage of the state of all the modules of a robot, one array per field
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef MODULE_ARRAY_H
+#define MODULE_ARRAY_H
+
+#include <string>
+#include <vector>
+
+#include "RobotDescription.hpp"
+#include "GaitTable.h"
+
+namespace hormodular {
+
+class Module;
+
+/*!
+ *  \class ModuleArray
+ *  \brief Storage of the state of all the modules of a robot, one array per field (structure of arrays)
+ *
+ *  The IDs, configuration IDs, oscillator parameters, elapsed times and joint positions of the
+ *  modules are stored on contiguous arrays indexed by module, so that the control loop can update
+ *  the joint positions of all the modules with a linear sweep. Each Module is a view of its position
+ *  on the array. The gait tables are loaded once and shared by all the modules of the array.
+ *
+ *  The connections between the modules are not stored here: the hormones are still exchanged once
+ *  every communication period through the Connector objects of each Module.
+ *
+ *  The size of the array is fixed on construction, so the references held by the modules are
+ *  never invalidated.
+ */
+class ModuleArray
+{
+    public:
+        /*!
+         * \brief Creates the storage for a number of modules of a robot
+         * \param robotDescription Description of the robot, with the gait tables used
+         * \param numModules Number of modules stored
+         */
+        ModuleArray(RobotDescriptionPtr robotDescription, int numModules);
+        ~ModuleArray();
+
+        int size();
+
+        /*!
+         * \brief Calculates the joint position of all the modules from their oscillator parameters and
+         * elapsed times
+         * \param jointValues Vector where the joint positions are stored (resized if needed)
+         */
+        void calculateJointPositions(std::vector<float>& jointValues);
+
+        //! \brief Increments the elapsed time of all the modules
+        void updateElapsedTime(float timeIncrement_ms);
+
+        /*!
+         * \brief Returns the gait table of a configuration, loading it if it was not used before
+         * \return The gait table, or NULL if there is no gait table for that configuration
+         */
+        GaitTable * getGaitTable(int configurationId);
+
+        //! \brief Returns the number of configurations (with or without gait table)
+        int getNumConfigurations();
+
+        //! \brief Returns the frequency table, loading it if it was not used before
+        GaitTable * getFrequencyTable();
+
+        /*!
+         * \brief Loads all the gait tables and the frequency table that were not used yet, so that
+         * they are not loaded from the control loop (i.e. before a real-time run)
+         */
+        void loadGaitTables();
+
+        //! \brief Returns the first configuration that has a gait table
+        int getDefaultConfigurationId();
+
+    private:
+        friend class Module;
+
+        //! \brief Returns the joint position of a module from its oscillator (see SinusoidalOscillator)
+        float calculateJointPosition(int module);
+
+        int numModules;
+
+        std::vector<unsigned long> ids;
+        std::vector<int> configurationIds;
+
+        //-- Oscillator parameters
+        std::vector<float> amplitudes;
+        std::vector<float> offsets;
+        std::vector<float> phases; //-- In radians
+        std::vector<int> periods; //-- In ms
+
+        std::vector<unsigned long> elapsedTimes; //-- In us
+        std::vector<float> jointPositions;
+
+        //! \brief Gait table of each configuration ID, NULL until it is first used
+        std::vector<GaitTable *> gaitTables;
+        std::vector<std::string> gaitTableFiles;
+        GaitTable * frequencyTable;
+        std::string frequencyTableFile;
+};
+
+}
+
+#endif //-- MODULE_ARRAY_H
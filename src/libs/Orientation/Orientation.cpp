@@ -17,6 +17,74 @@
 
 #include "Orientation.hpp"
 
+#include <vector>
+#include <algorithm>
+
+const int hormodular::Orientation::NUM_ORIENTATIONS;
+const hormodular::OrientationIndex hormodular::Orientation::INVALID_INDEX;
+
+namespace {
+
+//-- Number of roll, pitch and yaw combinations of angles multiple of 90º
+const int NUM_EULER_COMBINATIONS = 64;
+
+//-- Maps each roll, pitch and yaw combination ( (roll/90)*16 + (pitch/90)*4 + yaw/90 ) to its
+//-- orientation index
+hormodular::OrientationIndex eulerToIndex[NUM_EULER_COMBINATIONS];
+
+//-- Relative orientation for each local orientation, remote orientation and connector axis
+//-- (0 for connectors 0 and 2, 1 for connectors 1 and 3)
+signed char relativeOrientationTable[hormodular::Orientation::NUM_ORIENTATIONS]
+                                    [hormodular::Orientation::NUM_ORIENTATIONS][2];
+
+int eulerCombination(int roll, int pitch, int yaw)
+{
+    return (roll / 90) * 16 + (pitch / 90) * 4 + yaw / 90;
+}
+
+//-- Fills the lookup tables, using the Eigen implementation
+struct OrientationTableInitializer
+{
+    OrientationTableInitializer()
+    {
+        std::vector<Eigen::Matrix3i> rotations;
+        std::vector<hormodular::Orientation> representatives;
+
+        for (int i = 0; i < NUM_EULER_COMBINATIONS; i++)
+        {
+            hormodular::Orientation orientation( (i / 16) * 90, ((i / 4) % 4) * 90, (i % 4) * 90);
+
+            Eigen::AngleAxisd rollAngle( orientation.getRoll()*M_PI/180.0, Eigen::Vector3d::UnitZ());
+            Eigen::AngleAxisd pitchAngle( orientation.getPitch()*M_PI/180.0, Eigen::Vector3d::UnitY());
+            Eigen::AngleAxisd yawAngle( orientation.getYaw()*M_PI/180.0, Eigen::Vector3d::UnitX());
+            Eigen::Matrix3d rotationMatrix = (yawAngle * pitchAngle * rollAngle).matrix();
+
+            //-- All entries are -1, 0 or 1
+            Eigen::Matrix3i rotation;
+            for (int row = 0; row < 3; row++)
+                for (int col = 0; col < 3; col++)
+                    rotation(row, col) = (int) floor(rotationMatrix(row, col) + 0.5);
+
+            int index = std::find(rotations.begin(), rotations.end(), rotation) - rotations.begin();
+            if ( index == (int) rotations.size())
+            {
+                rotations.push_back(rotation);
+                representatives.push_back(orientation);
+            }
+
+            eulerToIndex[i] = index;
+        }
+
+        for (int local = 0; local < (int) representatives.size(); local++)
+            for (int remote = 0; remote < (int) representatives.size(); remote++)
+                for (int axis = 0; axis < 2; axis++)
+                    relativeOrientationTable[local][remote][axis] = hormodular::Orientation::getRelativeOrientationEigen(
+                                axis, representatives[local], representatives[remote]);
+    }
+} orientationTableInitializer;
+
+}
+
 
 hormodular::Orientation::Orientation()
 {
@@ -84,6 +152,35 @@ std::string hormodular::Orientation::str()
 }
 
 int hormodular::Orientation::getRelativeOrientation(int connector, hormodular::Orientation localOrient, hormodular::Orientation remoteOrient)
+{
+    OrientationIndex localIndex = localOrient.getIndex();
+    OrientationIndex remoteIndex = remoteOrient.getIndex();
+
+    if ( localIndex != INVALID_INDEX && remoteIndex != INVALID_INDEX )
+        return getRelativeOrientation(connector, localIndex, remoteIndex);
+    else
+        return getRelativeOrientationEigen(connector, localOrient, remoteOrient);
+}
+
+int hormodular::Orientation::getRelativeOrientation(int connector, hormodular::OrientationIndex localIndex, hormodular::OrientationIndex remoteIndex)
+{
+    if ( connector < 0 || connector > 3 ||
+         localIndex < 0 || localIndex >= NUM_ORIENTATIONS ||
+         remoteIndex < 0 || remoteIndex >= NUM_ORIENTATIONS )
+        return -1;
+
+    return relativeOrientationTable[localIndex][remoteIndex][connector % 2];
+}
+
+hormodular::OrientationIndex hormodular::Orientation::getIndex() const
+{
+    if ( roll % 90 != 0 || pitch % 90 != 0 || yaw % 90 != 0 )
+        return INVALID_INDEX;
+
+    return eulerToIndex[eulerCombination(roll, pitch, yaw)];
+}
+
+int hormodular::Orientation::getRelativeOrientationEigen(int connector, hormodular::Orientation localOrient, hormodular::Orientation remoteOrient)
 {
     //-- Create rotation matrices for local orientation:
     Eigen::AngleAxisd rollAngle( deg2rad(localOrient.getRoll()), Eigen::Vector3d::UnitZ());
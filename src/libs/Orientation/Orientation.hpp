@@ -34,6 +34,12 @@
 
 namespace hormodular {
 
+/*!
+ * \brief Index of one of the 24 rotations that can be expressed as roll, pitch and yaw angles
+ * multiples of 90º (0 to 23), or Orientation::INVALID_INDEX
+ */
+typedef int OrientationIndex;
+
 /*!
  *  \class Orientation
  *  \brief 3D vector representing the orientation of a module
@@ -96,6 +102,38 @@ class Orientation
          */
         static int getRelativeOrientation( int connector, Orientation localOrient, Orientation remoteOrient );
 
+        /*!
+         * \brief Returns the relative orientation between two orientations given by their index
+         *
+         * Same as getRelativeOrientation(int, Orientation, Orientation), but using a precomputed
+         * lookup table instead of computing the rotations.
+         *
+         * \return The relative orientation (0 to 3), or -1 if any of the arguments is not valid
+         */
+        static int getRelativeOrientation( int connector, OrientationIndex localIndex, OrientationIndex remoteIndex );
+
+        /*!
+         * \brief Computes the relative orientation using Eigen rotations (used to build and
+         * validate the lookup table, and for orientations not multiple of 90º)
+         */
+        static int getRelativeOrientationEigen( int connector, Orientation localOrient, Orientation remoteOrient );
+
+        /*!
+         * \brief Returns the index (0 to 23) of the rotation represented by this orientation
+         *
+         * Different roll, pitch and yaw combinations representing the same rotation share the
+         * same index.
+         *
+         * \return The orientation index, or INVALID_INDEX if any angle is not a multiple of 90º
+         */
+        OrientationIndex getIndex() const;
+
+        //! \brief Number of different orientations with angles multiple of 90º
+        static const int NUM_ORIENTATIONS = 24;
+
+        //! \brief Index returned for orientations with angles not multiple of 90º
+        static const OrientationIndex INVALID_INDEX = -1;
+
 
 private:
         int roll;
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//-- JointInterpolator
+//------------------------------------------------------------------------------
+//--
+//-- Interpolates the joint targets computed at the control rate
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "JointInterpolator.h"
+
+hormodular::JointInterpolator::JointInterpolator(Mode mode)
+{
+    this->mode = mode;
+    empty = true;
+}
+
+void hormodular::JointInterpolator::setMode(Mode mode)
+{
+    this->mode = mode;
+}
+
+hormodular::JointInterpolator::Mode hormodular::JointInterpolator::getMode() const
+{
+    return mode;
+}
+
+int hormodular::JointInterpolator::getDelay() const
+{
+    return mode == CUBIC ? 2 : 1;
+}
+
+void hormodular::JointInterpolator::reset()
+{
+    empty = true;
+}
+
+void hormodular::JointInterpolator::addTargets(const std::vector<float> &targets)
+{
+    //-- The first targets fill the whole history, so that the robot starts still
+    if ( empty )
+    {
+        for (int i = 0; i < 4; i++)
+            this->targets[i] = targets;
+        empty = false;
+        return;
+    }
+
+    //-- Shift the history, reusing the storage of the oldest targets
+    this->targets[0].swap(this->targets[1]);
+    this->targets[1].swap(this->targets[2]);
+    this->targets[2].swap(this->targets[3]);
+    this->targets[3] = targets;
+}
+
+void hormodular::JointInterpolator::interpolate(float fraction, std::vector<float> &joint_values) const
+{
+    if ( empty )
+        return;
+
+    const std::vector<float>& p0 = targets[0];
+    const std::vector<float>& p1 = targets[1];
+    const std::vector<float>& p2 = targets[2];
+    const std::vector<float>& p3 = targets[3];
+    int num_joints = p3.size();
+    joint_values.resize(num_joints);
+
+    float t = fraction;
+    if ( mode == LINEAR )
+    {
+        for (int i = 0; i < num_joints; i++)
+            joint_values[i] = p2[i] + (p3[i] - p2[i]) * t;
+    }
+    else
+    {
+        //-- Catmull-Rom spline between p1 and p2
+        float t2 = t * t, t3 = t2 * t;
+        for (int i = 0; i < num_joints; i++)
+            joint_values[i] = 0.5f * ( 2 * p1[i]
+                                       + (p2[i] - p0[i]) * t
+                                       + (2 * p0[i] - 5 * p1[i] + 4 * p2[i] - p3[i]) * t2
+                                       + (3 * p1[i] - p0[i] - 3 * p2[i] + p3[i]) * t3 );
+    }
+}
+
+bool hormodular::JointInterpolator::parseMode(const std::string &name, Mode &mode)
+{
+    if ( name.compare("linear") == 0 )
+        mode = LINEAR;
+    else if ( name.compare("cubic") == 0 )
+        mode = CUBIC;
+    else
+        return false;
+
+    return true;
+}
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//-- JointInterpolator
+//------------------------------------------------------------------------------
+//--
+//-- Interpolates the joint targets computed at the control rate
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file JointInterpolator.h
+ *  \brief Interpolates the joint targets computed at the control rate
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef JOINT_INTERPOLATOR_H
+#define JOINT_INTERPOLATOR_H
+
+#include <string>
+#include <vector>
+
+namespace hormodular {
+
+/*!
+ *  \class JointInterpolator
+ *  \brief Interpolates the joint targets computed at the control rate
+ *
+ *  The joint targets are added once every control period, and the joint values of the steps
+ *  in between are interpolated from the last targets. As the next target is not known until
+ *  the next control period, the output is delayed: one control period with linear
+ *  interpolation (between the last two targets) and two control periods with cubic
+ *  interpolation (Catmull-Rom spline through the last four targets, continuous in velocity).
+ */
+class JointInterpolator
+{
+    public:
+        enum Mode { LINEAR, CUBIC };
+
+        JointInterpolator(Mode mode = LINEAR);
+
+        void setMode(Mode mode);
+        Mode getMode() const;
+
+        //! \brief Returns the delay of the output, in control periods
+        int getDelay() const;
+
+        //! \brief Clears the previous targets. The first targets added after it are held still
+        void reset();
+
+        //! \brief Adds the joint targets of a new control period
+        void addTargets(const std::vector<float>& targets);
+
+        /*!
+         * \brief Calculates the joint values between the last targets
+         * \param fraction Fraction of the control period elapsed since the last targets were added, in [0, 1)
+         * \param joint_values Vector where the joint values are stored (resized if needed, left
+         * untouched if no targets were added yet)
+         */
+        void interpolate(float fraction, std::vector<float>& joint_values) const;
+
+        //! \brief Parses "linear" / "cubic", returning false if the name is unknown
+        static bool parseMode(const std::string& name, Mode& mode);
+
+    private:
+        Mode mode;
+
+        //! \brief Last four targets added, oldest first
+        std::vector<float> targets[4];
+        bool empty;
+};
+
+}
+
+#endif //-- JOINT_INTERPOLATOR_H
@@ -37,6 +37,8 @@ class Oscillator
 {
 
    public:
+        virtual ~Oscillator() {}
+
         void setPeriod( int period_ms);
         int getPeriod( );
 
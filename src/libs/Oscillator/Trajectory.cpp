@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+//-- Trajectory
+//------------------------------------------------------------------------------
+//--
+//-- Joint trajectory precomputed from a set of oscillators
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "Trajectory.h"
+
+hormodular::Trajectory::Trajectory()
+{
+    num_joints = 0;
+    num_steps = 0;
+    buffered_steps = 0;
+    step_us = 0;
+}
+
+bool hormodular::Trajectory::compute(const std::vector<Oscillator *>& oscillators, float step_ms,
+                                     unsigned long duration_us)
+{
+    buffer.clear();
+    num_joints = oscillators.size();
+    num_steps = 0;
+    buffered_steps = 0;
+
+    //-- Same rounding as the evaluation loops, that advance (unsigned long) (step_ms*1000) us each step
+    step_us = (unsigned long) (step_ms*1000);
+    if ( step_us == 0 )
+    {
+        std::cerr << "[Trajectory] Error: step must be at least 1 us (Got: " << step_ms << "ms)" << std::endl;
+        return false;
+    }
+
+    num_steps = (duration_us + step_us - 1) / step_us;
+    buffered_steps = num_steps;
+
+    //-- Check if the whole trajectory is periodic, so that only one period is stored
+    if ( num_joints > 0 )
+    {
+        int period_ms = oscillators[0]->getPeriod();
+        bool same_period = true;
+        for (int i = 1; i < num_joints; i++)
+            if ( oscillators[i]->getPeriod() != period_ms )
+                same_period = false;
+
+        //-- A period of 0 would store no steps at all
+        unsigned long period_us = period_ms > 0 ? 1000 * (unsigned long) period_ms : 0;
+        if ( same_period && period_us > 0 && period_us % step_us == 0 && (int) (period_us / step_us) < num_steps )
+            buffered_steps = period_us / step_us;
+    }
+
+    buffer.resize( buffered_steps * num_joints);
+    for (int step = 0; step < buffered_steps; step++)
+        for (int i = 0; i < num_joints; i++)
+            buffer[step * num_joints + i] = oscillators[i]->calculatePos(step * step_us);
+
+    return true;
+}
+
+int hormodular::Trajectory::getNumJoints() const
+{
+    return num_joints;
+}
+
+int hormodular::Trajectory::getNumSteps() const
+{
+    return num_steps;
+}
+
+int hormodular::Trajectory::getBufferedSteps() const
+{
+    return buffered_steps;
+}
+
+bool hormodular::Trajectory::isCyclic() const
+{
+    return buffered_steps < num_steps;
+}
+
+unsigned long hormodular::Trajectory::getStepTime() const
+{
+    return step_us;
+}
+
+const float * hormodular::Trajectory::getJointValues(int step) const
+{
+    //-- Empty trajectory (not computed yet, or no joints / steps)
+    if ( buffered_steps <= 0 || num_joints <= 0 || step < 0 )
+        return NULL;
+
+    return &buffer[ (step % buffered_steps) * num_joints];
+}
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//-- Trajectory
+//------------------------------------------------------------------------------
+//--
+//-- Joint trajectory precomputed from a set of oscillators
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file Trajectory.h
+ *  \brief Joint trajectory precomputed from a set of oscillators
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <vector>
+#include <iostream>
+
+#include "Oscillator.h"
+
+namespace hormodular {
+
+/*!
+ *  \class Trajectory
+ *  \brief Joint trajectory precomputed from a set of oscillators
+ *
+ *  As open-loop gaits are a deterministic function of time, the joint values of all the
+ *  control steps can be computed once and stored on a contiguous buffer (step-major, one
+ *  value per joint). If all the oscillators share the same period and this period is a
+ *  multiple of the control step, only one period is stored and it is replayed cyclically.
+ */
+class Trajectory
+{
+    public:
+        Trajectory();
+
+        /*!
+         * \brief Computes the trajectory of the given oscillators
+         * \param oscillators Oscillators that generate the value of each joint
+         * \param step_ms Time between two consecutive steps of the trajectory (in ms)
+         * \param duration_us Total duration of the trajectory (in us)
+         * \return True if completed successfully, false otherwise
+         */
+        bool compute(const std::vector<Oscillator *>& oscillators, float step_ms, unsigned long duration_us);
+
+        //! \brief Returns the number of joints of the trajectory
+        int getNumJoints() const;
+
+        //! \brief Returns the number of steps needed to cover the whole duration of the trajectory
+        int getNumSteps() const;
+
+        //! \brief Returns the number of steps actually stored on the buffer
+        int getBufferedSteps() const;
+
+        //! \brief Returns true if the buffer contains one period that is replayed cyclically
+        bool isCyclic() const;
+
+        //! \brief Returns the time between two consecutive steps (in us)
+        unsigned long getStepTime() const;
+
+        /*!
+         * \brief Returns the joint values of a step of the trajectory
+         * \param step Index of the step, in the range [0, getNumSteps())
+         * \return Pointer to getNumJoints() consecutive joint values, or NULL if the trajectory is empty
+         */
+        const float * getJointValues(int step) const;
+
+    private:
+        std::vector<float> buffer;
+        int num_joints;
+        int num_steps;
+        int buffered_steps;
+        unsigned long step_us;
+};
+
+}
+
+#endif //-- TRAJECTORY_H
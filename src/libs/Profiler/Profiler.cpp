@@ -0,0 +1,326 @@
+//------------------------------------------------------------------------------
+//-- Profiler
+//------------------------------------------------------------------------------
+//--
+//-- Low-overhead instrumentation of the controller loop phases
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "Profiler.hpp"
+
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace {
+
+struct PhaseStats
+{
+    unsigned long calls;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+};
+
+struct TraceEvent
+{
+    int phase;
+    long tid;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+};
+
+//-- Timing data of a single thread. Only its own thread records on it, so its
+//-- mutex is only contended while the data is being reported or reset.
+struct ThreadProfile
+{
+    boost::mutex mutex;
+    long tid;
+    PhaseStats phaseStats[hormodular::Profiler::NUM_PHASES];
+    std::vector<TraceEvent> traceEvents;
+    bool traceEnabled;
+    unsigned long maxTraceEvents;
+    unsigned long droppedTraceEvents;
+};
+
+//-- Slots of all the threads that have recorded something. They are kept after
+//-- the threads finish, so that their data is still reported.
+std::vector<ThreadProfile *> threadProfiles;
+bool traceEnabled = false;
+unsigned long maxTraceEvents = 0;
+uint64_t traceOrigin_ns = 0;
+boost::mutex profilerMutex;
+
+void clearStats(PhaseStats& stats)
+{
+    stats.calls = 0;
+    stats.total_ns = 0;
+    stats.min_ns = (uint64_t) -1;
+    stats.max_ns = 0;
+}
+
+void clearStats(PhaseStats * phaseStats)
+{
+    for (int i = 0; i < hormodular::Profiler::NUM_PHASES; i++)
+        clearStats(phaseStats[i]);
+}
+
+void setTrace(ThreadProfile * profile)
+{
+    profile->traceEnabled = traceEnabled;
+    profile->maxTraceEvents = maxTraceEvents;
+
+    //-- Reserve the memory now, so that recording does not reallocate the buffer
+    if (traceEnabled)
+        profile->traceEvents.reserve(maxTraceEvents);
+}
+
+//-- The slots are owned by threadProfiles, nothing is freed on thread exit
+void keepThreadProfile(ThreadProfile *) {}
+
+boost::thread_specific_ptr<ThreadProfile> currentThreadProfile(keepThreadProfile);
+
+ThreadProfile * getThreadProfile()
+{
+    ThreadProfile * profile = currentThreadProfile.get();
+
+    if (profile == NULL)
+    {
+        profile = new ThreadProfile;
+        profile->tid = (long) syscall(SYS_gettid);
+        clearStats(profile->phaseStats);
+        profile->droppedTraceEvents = 0;
+
+        boost::mutex::scoped_lock lock(profilerMutex);
+        setTrace(profile);
+        threadProfiles.push_back(profile);
+        currentThreadProfile.reset(profile);
+    }
+
+    return profile;
+}
+
+//-- Adds up the stats of all the threads (profilerMutex must be locked)
+PhaseStats mergeStats(int phase)
+{
+    PhaseStats merged;
+    clearStats(merged);
+
+    for (int i = 0; i < (int) threadProfiles.size(); i++)
+    {
+        boost::mutex::scoped_lock lock(threadProfiles[i]->mutex);
+        const PhaseStats& stats = threadProfiles[i]->phaseStats[phase];
+        merged.calls += stats.calls;
+        merged.total_ns += stats.total_ns;
+        if (stats.min_ns < merged.min_ns) merged.min_ns = stats.min_ns;
+        if (stats.max_ns > merged.max_ns) merged.max_ns = stats.max_ns;
+    }
+
+    return merged;
+}
+
+}
+
+bool hormodular::Profiler::isEnabled()
+{
+#ifdef HORMODULAR_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t hormodular::Profiler::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+void hormodular::Profiler::record(Phase phase, uint64_t start_ns, uint64_t end_ns)
+{
+    uint64_t duration_ns = end_ns - start_ns;
+
+    ThreadProfile * profile = getThreadProfile();
+    boost::mutex::scoped_lock lock(profile->mutex);
+
+    PhaseStats& stats = profile->phaseStats[phase];
+    stats.calls++;
+    stats.total_ns += duration_ns;
+    if (duration_ns < stats.min_ns) stats.min_ns = duration_ns;
+    if (duration_ns > stats.max_ns) stats.max_ns = duration_ns;
+
+    if (profile->traceEnabled)
+    {
+        if (profile->traceEvents.size() < profile->maxTraceEvents)
+        {
+            TraceEvent event;
+            event.phase = phase;
+            event.tid = profile->tid;
+            event.start_ns = start_ns;
+            event.duration_ns = duration_ns;
+            profile->traceEvents.push_back(event);
+        }
+        else
+            profile->droppedTraceEvents++;
+    }
+}
+
+void hormodular::Profiler::reset()
+{
+    boost::mutex::scoped_lock lock(profilerMutex);
+
+    for (int i = 0; i < (int) threadProfiles.size(); i++)
+    {
+        boost::mutex::scoped_lock thread_lock(threadProfiles[i]->mutex);
+        clearStats(threadProfiles[i]->phaseStats);
+        threadProfiles[i]->traceEvents.clear();
+        threadProfiles[i]->droppedTraceEvents = 0;
+    }
+
+    traceOrigin_ns = now();
+}
+
+void hormodular::Profiler::enableTrace(bool enabled, unsigned long max_events)
+{
+    boost::mutex::scoped_lock lock(profilerMutex);
+    traceEnabled = enabled;
+    maxTraceEvents = max_events;
+
+    for (int i = 0; i < (int) threadProfiles.size(); i++)
+    {
+        boost::mutex::scoped_lock thread_lock(threadProfiles[i]->mutex);
+        setTrace(threadProfiles[i]);
+    }
+
+    if (traceOrigin_ns == 0)
+        traceOrigin_ns = now();
+}
+
+void hormodular::Profiler::printSummary(std::ostream &out)
+{
+    if (!isEnabled())
+    {
+        out << "[Profiler] Profiling is disabled (configure with -DENABLE_PROFILING=ON)." << std::endl;
+        return;
+    }
+
+    boost::mutex::scoped_lock lock(profilerMutex);
+
+    out << "[Profiler] Time per phase:" << std::endl;
+    out << std::setw(20) << std::left << "phase" << std::right
+        << std::setw(12) << "calls"
+        << std::setw(14) << "total(ms)"
+        << std::setw(12) << "mean(us)"
+        << std::setw(12) << "min(us)"
+        << std::setw(12) << "max(us)" << std::endl;
+
+    for (int i = 0; i < NUM_PHASES; i++)
+    {
+        PhaseStats stats = mergeStats(i);
+        double mean_us = stats.calls > 0 ? stats.total_ns / 1000.0 / stats.calls : 0;
+        double min_us = stats.calls > 0 ? stats.min_ns / 1000.0 : 0;
+
+        out << std::setw(20) << std::left << getPhaseName((Phase) i) << std::right
+            << std::setw(12) << stats.calls
+            << std::setw(14) << std::fixed << std::setprecision(3) << stats.total_ns / 1.0e6
+            << std::setw(12) << mean_us
+            << std::setw(12) << min_us
+            << std::setw(12) << stats.max_ns / 1000.0 << std::endl;
+    }
+    out.unsetf(std::ios::fixed);
+
+    unsigned long droppedTraceEvents = 0;
+    for (int i = 0; i < (int) threadProfiles.size(); i++)
+    {
+        boost::mutex::scoped_lock thread_lock(threadProfiles[i]->mutex);
+        droppedTraceEvents += threadProfiles[i]->droppedTraceEvents;
+    }
+
+    if (droppedTraceEvents > 0)
+        out << "[Profiler] Warning: " << droppedTraceEvents << " trace events were dropped." << std::endl;
+}
+
+bool hormodular::Profiler::saveTrace(const std::string &filepath)
+{
+    std::ofstream output_file(filepath.c_str());
+
+    if (!output_file.is_open())
+    {
+        std::cerr << "[Profiler] Error: file " << filepath << " could not be opened." << std::endl;
+        return false;
+    }
+
+    boost::mutex::scoped_lock lock(profilerMutex);
+
+    //-- Timestamps and durations are expressed in us in the trace-event format
+    output_file << "{\"traceEvents\":[" << std::endl;
+    output_file << std::fixed << std::setprecision(3);
+
+    bool first_event = true;
+    for (int i = 0; i < (int) threadProfiles.size(); i++)
+    {
+        boost::mutex::scoped_lock thread_lock(threadProfiles[i]->mutex);
+        const std::vector<TraceEvent>& traceEvents = threadProfiles[i]->traceEvents;
+
+        for (int j = 0; j < (int) traceEvents.size(); j++)
+        {
+            const TraceEvent& event = traceEvents[j];
+
+            if (!first_event)
+                output_file << "," << std::endl;
+            first_event = false;
+
+            output_file << "{\"name\":\"" << getPhaseName((Phase) event.phase) << "\","
+                        << "\"cat\":\"hormodular\",\"ph\":\"X\","
+                        << "\"ts\":" << (event.start_ns - traceOrigin_ns) / 1000.0 << ","
+                        << "\"dur\":" << event.duration_ns / 1000.0 << ","
+                        << "\"pid\":" << getpid() << ",\"tid\":" << event.tid << "}";
+        }
+    }
+    if (!first_event)
+        output_file << std::endl;
+
+    output_file << "]}" << std::endl;
+    output_file.close();
+
+    return true;
+}
+
+unsigned long hormodular::Profiler::getCalls(Phase phase)
+{
+    boost::mutex::scoped_lock lock(profilerMutex);
+    return mergeStats(phase).calls;
+}
+
+uint64_t hormodular::Profiler::getTotalTime(Phase phase)
+{
+    boost::mutex::scoped_lock lock(profilerMutex);
+    return mergeStats(phase).total_ns;
+}
+
+const char *hormodular::Profiler::getPhaseName(Phase phase)
+{
+    switch (phase)
+    {
+        case HORMONE_PROCESSING: return "hormone_processing";
+        case OSCILLATOR_UPDATE:  return "oscillator_update";
+        case JOINT_SEND:         return "joint_send";
+        case SIMULATION_STEP:    return "simulation_step";
+        default:                 return "unknown";
+    }
+}
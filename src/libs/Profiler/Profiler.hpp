@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+//-- Profiler
+//------------------------------------------------------------------------------
+//--
+//-- Low-overhead instrumentation of the controller loop phases
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file Profiler.hpp
+ *  \brief Low-overhead instrumentation of the controller loop phases
+ *
+ * The timers are only compiled in when HORMODULAR_PROFILING is defined (cmake
+ * option ENABLE_PROFILING). Otherwise, HORMODULAR_PROFILE_SCOPE expands to nothing
+ * and the Profiler only reports that profiling is disabled.
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <string>
+#include <iostream>
+
+namespace hormodular {
+
+/*!
+ *  \class Profiler
+ *  \brief Accumulates the time spent on each phase of the controller loop
+ *
+ *  Timing data is stored per phase (number of calls, total, min and max time).
+ *  Optionally, each timed scope can also be stored as an event to be exported
+ *  in the Chrome trace-event JSON format (chrome://tracing).
+ */
+class Profiler
+{
+    public:
+        //! \brief Phases of the controller loop that can be timed
+        enum Phase { HORMONE_PROCESSING = 0,
+                     OSCILLATOR_UPDATE = 1,
+                     JOINT_SEND = 2,
+                     SIMULATION_STEP = 3,
+                     NUM_PHASES = 4 };
+
+        //! \brief Returns true if the profiler was compiled in (HORMODULAR_PROFILING defined)
+        static bool isEnabled();
+
+        //! \brief Returns the current time of a monotonic clock, in ns
+        static uint64_t now();
+
+        /*!
+         * \brief Adds a timed interval (in ns, as returned by now()) to the given phase
+         *
+         * The interval is accumulated on the data of the calling thread, which is only
+         * merged with the other threads when it is reported.
+         */
+        static void record(Phase phase, uint64_t start_ns, uint64_t end_ns);
+
+        //! \brief Clears all the accumulated timing data and trace events
+        static void reset();
+
+        /*!
+         * \brief Enables or disables the storage of trace events
+         * \param enabled If true, each timed scope is stored as a trace event
+         * \param max_events Maximum number of events stored per thread, further events are dropped
+         */
+        static void enableTrace(bool enabled, unsigned long max_events = 1000000);
+
+        //! \brief Prints a table with the time spent on each phase
+        static void printSummary(std::ostream& out = std::cout);
+
+        /*!
+         * \brief Saves the stored trace events as a Chrome trace-event JSON file
+         * \return True if completed successfully, false otherwise
+         */
+        static bool saveTrace(const std::string& filepath);
+
+        //! \brief Returns the number of times a phase has been timed
+        static unsigned long getCalls(Phase phase);
+
+        //! \brief Returns the total time spent on a phase, in ns
+        static uint64_t getTotalTime(Phase phase);
+
+        //! \brief Returns a human-readable name for the phase
+        static const char * getPhaseName(Phase phase);
+};
+
+/*!
+ *  \class ScopedTimer
+ *  \brief Times the scope in which it is created and records it on the Profiler
+ */
+class ScopedTimer
+{
+    public:
+        ScopedTimer(Profiler::Phase phase) : phase(phase), start_ns(Profiler::now()) {}
+        ~ScopedTimer() { Profiler::record(phase, start_ns, Profiler::now()); }
+
+    private:
+        Profiler::Phase phase;
+        uint64_t start_ns;
+};
+
+}
+
+#define HORMODULAR_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HORMODULAR_PROFILE_CONCAT(a, b) HORMODULAR_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef HORMODULAR_PROFILING
+    //! \brief Times the rest of the current scope as the given Profiler::Phase
+    #define HORMODULAR_PROFILE_SCOPE(phase) \
+        hormodular::ScopedTimer HORMODULAR_PROFILE_CONCAT(hormodular_scoped_timer_, __LINE__)(phase)
+#else
+    #define HORMODULAR_PROFILE_SCOPE(phase)
+#endif
+
+#endif //-- PROFILER_H
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+//-- JitterStats
+//------------------------------------------------------------------------------
+//--
+//-- Statistics of the period of a periodic loop
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "JitterStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+hormodular::JitterStats::JitterStats()
+{
+    reset(0, 0);
+}
+
+void hormodular::JitterStats::reset(uint64_t period_ns, unsigned long capacity)
+{
+    this->period_ns = period_ns;
+    last_time_ns = 0;
+    started = false;
+
+    this->capacity = capacity;
+    jitters.clear();
+    jitters.reserve(capacity);
+
+    num_periods = 0;
+    overruns = 0;
+    min_jitter = 0;
+    max_jitter = 0;
+    sum_jitter = 0;
+    sum_squared_jitter = 0;
+}
+
+void hormodular::JitterStats::addCycle(uint64_t time_ns)
+{
+    if ( !started )
+    {
+        started = true;
+        last_time_ns = time_ns;
+        return;
+    }
+
+    int64_t jitter = (int64_t) (time_ns - last_time_ns) - (int64_t) period_ns;
+    last_time_ns = time_ns;
+
+    if ( num_periods == 0 || jitter < min_jitter )
+        min_jitter = jitter;
+    if ( num_periods == 0 || jitter > max_jitter )
+        max_jitter = jitter;
+
+    num_periods++;
+    sum_jitter += jitter;
+    sum_squared_jitter += (double) jitter * jitter;
+
+    if ( jitter > (int64_t) period_ns )
+        overruns++;
+
+    //-- Only stored while there is reserved memory
+    if ( jitters.size() < capacity )
+        jitters.push_back(jitter);
+}
+
+unsigned long hormodular::JitterStats::getNumPeriods() const
+{
+    return num_periods;
+}
+
+uint64_t hormodular::JitterStats::getNominalPeriod() const
+{
+    return period_ns;
+}
+
+double hormodular::JitterStats::getMeanPeriod() const
+{
+    return num_periods > 0 ? period_ns + sum_jitter / num_periods : 0;
+}
+
+int64_t hormodular::JitterStats::getMinJitter() const
+{
+    return min_jitter;
+}
+
+int64_t hormodular::JitterStats::getMaxJitter() const
+{
+    return max_jitter;
+}
+
+double hormodular::JitterStats::getStdDevJitter() const
+{
+    if ( num_periods == 0 )
+        return 0;
+
+    double mean = sum_jitter / num_periods;
+    double variance = sum_squared_jitter / num_periods - mean * mean;
+    return variance > 0 ? sqrt(variance) : 0;
+}
+
+int64_t hormodular::JitterStats::getPercentile(double percentile) const
+{
+    if ( jitters.empty() )
+        return 0;
+
+    std::vector<int64_t> absolute(jitters.size());
+    for (int i = 0; i < (int) jitters.size(); i++)
+        absolute[i] = jitters[i] < 0 ? -jitters[i] : jitters[i];
+
+    size_t index = (size_t) ( percentile / 100 * (absolute.size() - 1) + 0.5);
+    if ( index >= absolute.size() )
+        index = absolute.size() - 1;
+
+    std::nth_element(absolute.begin(), absolute.begin() + index, absolute.end());
+    return absolute[index];
+}
+
+unsigned long hormodular::JitterStats::getOverruns() const
+{
+    return overruns;
+}
+
+void hormodular::JitterStats::print(std::ostream &out) const
+{
+    out << "Jitter report (" << num_periods << " periods of " << period_ns / 1000.0 << "us):" << std::endl;
+    if ( num_periods == 0 )
+        return;
+
+    out << "  Mean period: " << getMeanPeriod() / 1000 << "us" << std::endl
+        << "  Jitter min / max: " << min_jitter / 1000.0 << "us / " << max_jitter / 1000.0 << "us" << std::endl
+        << "  Jitter std dev: " << getStdDevJitter() / 1000 << "us" << std::endl
+        << "  |Jitter| p50 / p99 / p99.9: " << getPercentile(50) / 1000.0 << "us / " << getPercentile(99) / 1000.0
+        << "us / " << getPercentile(99.9) / 1000.0 << "us" << std::endl
+        << "  Overruns (period > 2x nominal): " << overruns << std::endl;
+}
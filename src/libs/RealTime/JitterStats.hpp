@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//-- JitterStats
+//------------------------------------------------------------------------------
+//--
+//-- Statistics of the period of a periodic loop
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file JitterStats.hpp
+ *  \brief Statistics of the period of a periodic loop
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef JITTER_STATS_H
+#define JITTER_STATS_H
+
+#include <stdint.h>
+#include <vector>
+#include <iostream>
+
+namespace hormodular {
+
+/*!
+ *  \class JitterStats
+ *  \brief Statistics of the period of a periodic loop
+ *
+ *  The start time of each cycle of the loop is added with addCycle(), and the jitter of each
+ *  cycle (its actual period minus the nominal one) is accumulated. The memory for the jitter
+ *  of each cycle is reserved by reset(), so that adding cycles does not allocate memory; once
+ *  it is full, the cycles are still counted on the mean, maximum and overruns, but not on the
+ *  percentiles.
+ */
+class JitterStats
+{
+    public:
+        JitterStats();
+
+        /*!
+         * \brief Clears the statistics
+         * \param period_ns Nominal period of the loop (in ns)
+         * \param capacity Number of cycles whose jitter is stored, for the percentiles
+         */
+        void reset(uint64_t period_ns, unsigned long capacity);
+
+        //! \brief Adds the start time of a cycle (in ns, as returned by Profiler::now())
+        void addCycle(uint64_t time_ns);
+
+        //! \brief Returns the number of periods measured (one less than the cycles added)
+        unsigned long getNumPeriods() const;
+
+        uint64_t getNominalPeriod() const;
+        double getMeanPeriod() const;
+        int64_t getMinJitter() const;
+        int64_t getMaxJitter() const;
+        double getStdDevJitter() const;
+
+        //! \brief Returns the given percentile (in [0, 100]) of the absolute jitter (in ns)
+        int64_t getPercentile(double percentile) const;
+
+        //! \brief Returns the number of periods longer than twice the nominal one
+        unsigned long getOverruns() const;
+
+        //! \brief Prints the jitter report (in us)
+        void print(std::ostream& out = std::cout) const;
+
+    private:
+        uint64_t period_ns;
+        uint64_t last_time_ns;
+        bool started;
+
+        std::vector<int64_t> jitters;
+        unsigned long capacity;
+        unsigned long num_periods;
+        unsigned long overruns;
+        int64_t min_jitter;
+        int64_t max_jitter;
+        double sum_jitter;
+        double sum_squared_jitter;
+};
+
+}
+
+#endif //-- JITTER_STATS_H
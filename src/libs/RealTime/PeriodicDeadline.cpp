@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+//-- PeriodicDeadline
+//------------------------------------------------------------------------------
+//--
+//-- Pacing of a periodic loop, with absolute deadlines or plain sleeps
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "PeriodicDeadline.hpp"
+#include "RealTime.hpp"
+#include "Profiler.hpp"
+
+#include <unistd.h>
+
+hormodular::PeriodicDeadline::PeriodicDeadline()
+{
+    absolute = false;
+    next_deadline_ns = 0;
+}
+
+void hormodular::PeriodicDeadline::setAbsolute(bool absolute)
+{
+    this->absolute = absolute;
+    reset();
+}
+
+bool hormodular::PeriodicDeadline::isAbsolute() const
+{
+    return absolute;
+}
+
+void hormodular::PeriodicDeadline::reset()
+{
+    next_deadline_ns = 0;
+}
+
+void hormodular::PeriodicDeadline::waitStep(float step_ms)
+{
+    if ( step_ms <= 0 )
+        return;
+
+    if ( !absolute )
+    {
+        usleep(step_ms * 1000);
+        return;
+    }
+
+    uint64_t now_ns = Profiler::now();
+    uint64_t step_ns = (uint64_t) (step_ms * 1000000);
+
+    //-- The first step (or a step late by more than a whole period) starts a new schedule
+    if ( next_deadline_ns == 0 || now_ns > next_deadline_ns + step_ns )
+        next_deadline_ns = now_ns;
+
+    next_deadline_ns += step_ns;
+    RealTime::sleepUntil(next_deadline_ns);
+}
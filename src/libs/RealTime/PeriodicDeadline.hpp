@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+//-- PeriodicDeadline
+//------------------------------------------------------------------------------
+//--
+//-- Pacing of a periodic loop, with absolute deadlines or plain sleeps
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file PeriodicDeadline.hpp
+ *  \brief Pacing of a periodic loop, with absolute deadlines or plain sleeps
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef PERIODIC_DEADLINE_H
+#define PERIODIC_DEADLINE_H
+
+#include <stdint.h>
+
+namespace hormodular {
+
+/*!
+ *  \class PeriodicDeadline
+ *  \brief Pacing of a periodic loop, with absolute deadlines or plain sleeps
+ *
+ *  Each call to waitStep() waits for the duration of a step of the loop. With absolute deadlines
+ *  enabled, it waits until one step after the previous deadline (see RealTime::sleepUntil()), so
+ *  the time spent by the loop on each step and the delays of the wake-ups do not accumulate.
+ *  Otherwise it just sleeps the step.
+ */
+class PeriodicDeadline
+{
+    public:
+        PeriodicDeadline();
+
+        //! \brief Enables or disables the absolute deadlines, starting a new schedule
+        void setAbsolute(bool absolute);
+        bool isAbsolute() const;
+
+        //! \brief Starts a new schedule on the next step
+        void reset();
+
+        /*!
+         * \brief Waits until the end of the current step
+         *
+         * The first step (or a step late by more than a whole step) starts a new schedule from the
+         * current time. A step of 0 does not wait.
+         */
+        void waitStep(float step_ms);
+
+    private:
+        bool absolute;
+        uint64_t next_deadline_ns;
+};
+
+}
+
+#endif //-- PERIODIC_DEADLINE_H
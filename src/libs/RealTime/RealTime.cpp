@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+//-- RealTime
+//------------------------------------------------------------------------------
+//--
+//-- Real-time settings of the control thread: CPU pinning, SCHED_FIFO priority
+//-- and locked memory
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "RealTime.hpp"
+
+#include <alloca.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+const int hormodular::RealTime::DEFAULT_PRIORITY;
+const size_t hormodular::RealTime::DEFAULT_PREFAULT_STACK;
+const size_t hormodular::RealTime::DEFAULT_PREFAULT_HEAP;
+
+bool hormodular::RealTime::cpu_pinned = false;
+bool hormodular::RealTime::fifo_scheduled = false;
+bool hormodular::RealTime::memory_locked = false;
+int hormodular::RealTime::pinned_cpu = -1;
+int hormodular::RealTime::fifo_priority = 0;
+
+bool hormodular::RealTime::enable(int cpu, int priority, bool lock_memory)
+{
+    bool ok = true;
+
+    //-- Pin the thread to a CPU
+    if ( cpu >= 0 )
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu, &cpuset);
+
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+        if ( error == 0 )
+        {
+            cpu_pinned = true;
+            pinned_cpu = cpu;
+        }
+        else
+        {
+            std::cerr << "[RealTime] Warning: could not pin the thread to CPU " << cpu << " ("
+                      << strerror(error) << ")" << std::endl;
+            ok = false;
+        }
+    }
+
+    //-- Real-time priority
+    if ( priority > 0 )
+    {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+
+        int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if ( error == 0 )
+        {
+            fifo_scheduled = true;
+            fifo_priority = priority;
+        }
+        else
+        {
+            std::cerr << "[RealTime] Warning: could not set SCHED_FIFO priority " << priority << " ("
+                      << strerror(error) << "). Running with normal scheduling (requires CAP_SYS_NICE or "
+                      << "an rtprio limit)" << std::endl;
+            ok = false;
+        }
+    }
+
+    //-- Lock the memory, keeping the freed heap mapped, and fault it in before the loop starts
+    if ( lock_memory )
+    {
+        mallopt(M_TRIM_THRESHOLD, -1);
+        mallopt(M_MMAP_MAX, 0);
+
+        if ( mlockall(MCL_CURRENT | MCL_FUTURE) == 0 )
+            memory_locked = true;
+        else
+        {
+            std::cerr << "[RealTime] Warning: could not lock the memory (" << strerror(errno) << "). Page "
+                      << "faults may delay the control loop (requires CAP_IPC_LOCK or a memlock limit)"
+                      << std::endl;
+            ok = false;
+        }
+
+        prefaultStack();
+        prefaultHeap();
+    }
+
+    return ok;
+}
+
+void hormodular::RealTime::disable()
+{
+    if ( cpu_pinned )
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+        for (int i = 0; i < num_cpus && i < CPU_SETSIZE; i++)
+            CPU_SET(i, &cpuset);
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+        cpu_pinned = false;
+        pinned_cpu = -1;
+    }
+
+    if ( fifo_scheduled )
+    {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+        fifo_scheduled = false;
+        fifo_priority = 0;
+    }
+
+    if ( memory_locked )
+    {
+        munlockall();
+        memory_locked = false;
+    }
+}
+
+bool hormodular::RealTime::isCpuPinned()
+{
+    return cpu_pinned;
+}
+
+bool hormodular::RealTime::isFifoScheduled()
+{
+    return fifo_scheduled;
+}
+
+bool hormodular::RealTime::isMemoryLocked()
+{
+    return memory_locked;
+}
+
+void hormodular::RealTime::printStatus(std::ostream &out)
+{
+    out << "Real-time settings:" << std::endl;
+
+    out << "  CPU pinning: ";
+    if ( cpu_pinned )
+        out << "CPU " << pinned_cpu << std::endl;
+    else
+        out << "disabled" << std::endl;
+
+    out << "  Scheduling: ";
+    if ( fifo_scheduled )
+        out << "SCHED_FIFO, priority " << fifo_priority << std::endl;
+    else
+        out << "normal" << std::endl;
+
+    out << "  Locked memory: " << (memory_locked ? "enabled" : "disabled") << std::endl;
+}
+
+void hormodular::RealTime::prefaultStack(size_t size)
+{
+    //-- Touch one byte per page (volatile, so that the writes are not optimized away)
+    volatile char * stack = (volatile char *) alloca(size);
+    long page_size = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += page_size)
+        stack[i] = 0;
+}
+
+void hormodular::RealTime::prefaultHeap(size_t size)
+{
+    char * heap = (char *) malloc(size);
+    if ( !heap )
+        return;
+
+    //-- Touch one byte per page (volatile, as the block is freed right after and otherwise the writes
+    //-- are optimized away)
+    volatile char * pages = heap;
+    long page_size = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += page_size)
+        pages[i] = 0;
+
+    //-- As trimming is disabled, the pages stay mapped (and locked) for future allocations
+    free(heap);
+}
+
+void hormodular::RealTime::sleepUntil(uint64_t deadline_ns)
+{
+    struct timespec deadline;
+    deadline.tv_sec = deadline_ns / 1000000000ULL;
+    deadline.tv_nsec = deadline_ns % 1000000000ULL;
+
+    //-- Retry if interrupted by a signal
+    while ( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR )
+        ;
+}
@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+//-- RealTime
+//------------------------------------------------------------------------------
+//--
+//-- Real-time settings of the control thread: CPU pinning, SCHED_FIFO priority
+//-- and locked memory
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file RealTime.hpp
+ *  \brief Real-time settings of the control thread: CPU pinning, SCHED_FIFO priority and locked memory
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef REAL_TIME_H
+#define REAL_TIME_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <iostream>
+
+namespace hormodular {
+
+/*!
+ *  \class RealTime
+ *  \brief Real-time settings of the control thread: CPU pinning, SCHED_FIFO priority and locked memory
+ *
+ *  enable() pins the calling thread to a CPU, gives it a SCHED_FIFO priority, locks all the
+ *  process memory (current and future) and pre-faults the stack and some heap, so that the
+ *  control loop is neither preempted by normal processes nor stopped by page faults. Threads
+ *  created afterwards inherit the CPU and the scheduling policy.
+ *
+ *  Each setting is applied independently: if the process lacks the privileges for any of them
+ *  (CAP_SYS_NICE / rtprio limit for SCHED_FIFO, CAP_IPC_LOCK / memlock limit for mlockall), a
+ *  warning is printed and the rest are still applied.
+ */
+class RealTime
+{
+    public:
+        static const int DEFAULT_PRIORITY = 80;
+        static const size_t DEFAULT_PREFAULT_STACK = 512 * 1024;
+        static const size_t DEFAULT_PREFAULT_HEAP = 16 * 1024 * 1024;
+
+        /*!
+         * \brief Applies the real-time settings to the calling thread
+         * \param cpu CPU the thread is pinned to (-1 to not pin it)
+         * \param priority SCHED_FIFO priority (0 to keep the normal scheduling)
+         * \param lock_memory If true, locks and pre-faults the memory of the process
+         * \return True if all the settings were applied, false if any of them was not
+         */
+        static bool enable(int cpu, int priority = DEFAULT_PRIORITY, bool lock_memory = true);
+
+        //! \brief Restores the CPU affinity and scheduling of the thread and unlocks the memory
+        static void disable();
+
+        static bool isCpuPinned();
+        static bool isFifoScheduled();
+        static bool isMemoryLocked();
+
+        //! \brief Prints the settings applied
+        static void printStatus(std::ostream& out = std::cout);
+
+        //! \brief Touches the given amount of stack, so that it is mapped before it is needed
+        static void prefaultStack(size_t size = DEFAULT_PREFAULT_STACK);
+
+        //! \brief Touches the given amount of heap and returns it to malloc, that keeps it mapped
+        static void prefaultHeap(size_t size = DEFAULT_PREFAULT_HEAP);
+
+        /*!
+         * \brief Sleeps until an absolute time of the monotonic clock (as returned by Profiler::now()),
+         * so that periodic loops do not accumulate the delays of each period
+         */
+        static void sleepUntil(uint64_t deadline_ns);
+
+    private:
+        static bool cpu_pinned;
+        static bool fifo_scheduled;
+        static bool memory_locked;
+        static int pinned_cpu;
+        static int fifo_priority;
+};
+
+}
+
+#endif //-- REAL_TIME_H
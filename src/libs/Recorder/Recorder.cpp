@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+//-- Recorder
+//------------------------------------------------------------------------------
+//--
+//-- Streaming binary recorder for joint values, module IDs and timings
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "Recorder.hpp"
+
+#include <algorithm>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+
+const uint32_t hormodular::Recorder::MAGIC;
+const uint32_t hormodular::Recorder::VERSION;
+const int hormodular::Recorder::DEFAULT_CHUNK_SIZE;
+
+int hormodular::Recorder::getRecordSize(hormodular::Recorder::RecordType type, int num_modules)
+{
+    int header_size = sizeof(uint8_t) + sizeof(uint64_t);
+
+    switch (type)
+    {
+        case JOINT_VALUES:
+            return header_size + num_modules * sizeof(float);
+        case MODULES:
+            return header_size + num_modules * (sizeof(uint64_t) + sizeof(int32_t));
+        case TIMING:
+            return header_size + sizeof(uint32_t);
+    }
+
+    return 0;
+}
+
+hormodular::Recorder::Recorder()
+{
+    opened = false;
+    num_modules = 0;
+    num_records = 0;
+    chunk_size = 0;
+    chunk_used = 0;
+    chunk_records = 0;
+    stopping = false;
+    write_failed = false;
+
+    for (int i = 0; i <= TIMING; i++)
+        record_sizes[i] = 0;
+}
+
+hormodular::Recorder::~Recorder()
+{
+    close();
+}
+
+bool hormodular::Recorder::open(const std::string &filepath, int num_modules, float step_ms, bool compressed,
+                                int chunk_size)
+{
+    close();
+
+    this->num_modules = num_modules;
+    num_records = 0;
+
+    record_sizes[JOINT_VALUES] = getRecordSize(JOINT_VALUES, num_modules);
+    record_sizes[MODULES] = getRecordSize(MODULES, num_modules);
+    record_sizes[TIMING] = getRecordSize(TIMING, num_modules);
+
+    //-- Any record must fit in a chunk (after the chunk header: payload size and number of records)
+    this->chunk_size = 2 * sizeof(uint32_t) + std::max(chunk_size, std::max(record_sizes[JOINT_VALUES],
+                                                                              record_sizes[MODULES]));
+    chunk.resize(this->chunk_size);
+    chunk_used = 2 * sizeof(uint32_t);
+    chunk_records = 0;
+
+    boost::iostreams::file_sink file(filepath, std::ios_base::out | std::ios_base::binary);
+    if ( !file.is_open() )
+    {
+        std::cerr << "[Recorder] Error: could not open recording file \"" << filepath << "\"" << std::endl;
+        return false;
+    }
+
+    if ( compressed )
+        out.push(boost::iostreams::gzip_compressor(boost::iostreams::gzip_params(boost::iostreams::gzip::best_speed)));
+    out.push(file);
+
+    uint32_t header[3] = { MAGIC, VERSION, (uint32_t) num_modules };
+    out.write((const char *) header, sizeof(header));
+    out.write((const char *) &step_ms, sizeof(step_ms));
+
+    if ( !out.good() )
+    {
+        std::cerr << "[Recorder] Error: could not write recording file \"" << filepath << "\"" << std::endl;
+        out.reset();
+        return false;
+    }
+
+    stopping = false;
+    write_failed = false;
+    writer = boost::thread(&Recorder::writerLoop, this);
+
+    opened = true;
+    return true;
+}
+
+bool hormodular::Recorder::close()
+{
+    if ( !opened )
+        return false;
+
+    flush();
+
+    {
+        boost::mutex::scoped_lock lock(queue_mutex);
+        stopping = true;
+    }
+    queue_condition.notify_one();
+    writer.join();
+
+    //-- Popping the file flushes and closes the whole chain (including the gzip footer)
+    out.reset();
+    opened = false;
+    free_chunks.clear();
+
+    return !write_failed;
+}
+
+bool hormodular::Recorder::isOpen() const
+{
+    return opened;
+}
+
+bool hormodular::Recorder::flush()
+{
+    if ( !opened )
+        return false;
+
+    boost::mutex::scoped_lock lock(queue_mutex);
+
+    if ( chunk_records > 0 )
+    {
+        uint32_t chunk_header[2] = { (uint32_t) (chunk_used - 2 * sizeof(uint32_t)), chunk_records };
+        memcpy(&chunk[0], chunk_header, sizeof(chunk_header));
+        chunk.resize(chunk_used);
+
+        pending_chunks.push_back(std::vector<char>());
+        pending_chunks.back().swap(chunk);
+
+        //-- Reuse the memory of a chunk already written, if any
+        if ( !free_chunks.empty() )
+        {
+            chunk.swap(free_chunks.back());
+            free_chunks.pop_back();
+        }
+        chunk.resize(chunk_size);
+
+        chunk_used = 2 * sizeof(uint32_t);
+        chunk_records = 0;
+
+        queue_condition.notify_one();
+    }
+
+    return !write_failed;
+}
+
+void hormodular::Recorder::recordJointValues(uint64_t time_us, const std::vector<float> &joint_values)
+{
+    if ( !opened )
+        return;
+
+    beginRecord(JOINT_VALUES, time_us);
+    for (int i = 0; i < num_modules; i++)
+        put( i < (int) joint_values.size() ? joint_values[i] : 0.0f);
+}
+
+void hormodular::Recorder::recordModules(uint64_t time_us, const std::vector<uint64_t> &ids,
+                                         const std::vector<int32_t> &configuration_ids)
+{
+    if ( !opened )
+        return;
+
+    beginRecord(MODULES, time_us);
+    for (int i = 0; i < num_modules; i++)
+        put( i < (int) ids.size() ? ids[i] : (uint64_t) 0);
+    for (int i = 0; i < num_modules; i++)
+        put( i < (int) configuration_ids.size() ? configuration_ids[i] : (int32_t) -1);
+}
+
+void hormodular::Recorder::recordTiming(uint64_t time_us, uint32_t send_time_ns)
+{
+    if ( !opened )
+        return;
+
+    beginRecord(TIMING, time_us);
+    put(send_time_ns);
+}
+
+unsigned long hormodular::Recorder::getNumRecords() const
+{
+    return num_records;
+}
+
+void hormodular::Recorder::beginRecord(hormodular::Recorder::RecordType type, uint64_t time_us)
+{
+    if ( chunk_used + record_sizes[type] > chunk_size )
+        flush();
+
+    put( (uint8_t) type);
+    put( time_us);
+
+    chunk_records++;
+    num_records++;
+}
+
+void hormodular::Recorder::writerLoop()
+{
+    boost::mutex::scoped_lock lock(queue_mutex);
+
+    while ( true )
+    {
+        while ( pending_chunks.empty() && !stopping )
+            queue_condition.wait(lock);
+
+        if ( pending_chunks.empty() )
+            break;
+
+        std::vector<char> data;
+        data.swap(pending_chunks.front());
+        pending_chunks.pop_front();
+
+        //-- Write (and compress) without blocking the control loop
+        lock.unlock();
+        out.write(&data[0], data.size());
+        bool ok = out.good();
+        lock.lock();
+
+        if ( !ok && !write_failed )
+        {
+            std::cerr << "[Recorder] Error: could not write to the recording file" << std::endl;
+            write_failed = true;
+        }
+
+        data.clear();
+        free_chunks.push_back(std::vector<char>());
+        free_chunks.back().swap(data);
+    }
+}
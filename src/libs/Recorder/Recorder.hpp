@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+//-- Recorder
+//------------------------------------------------------------------------------
+//--
+//-- Streaming binary recorder for joint values, module IDs and timings
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file Recorder.hpp
+ *  \brief Streaming binary recorder for joint values, module IDs and timings
+ *
+ * Recording file format (native byte order):
+ *  - Header: magic "HMRC" (uint32), version (uint32), number of modules (uint32), step (float, ms)
+ *  - Chunks: payload size in bytes (uint32), number of records (uint32) and the records
+ *  - Record: type (uint8), time (uint64, us) and a fixed-size payload depending on the type:
+ *     - JOINT_VALUES: one float per module
+ *     - MODULES: one ID (uint64) per module followed by one configuration ID (int32) per module
+ *     - TIMING: time spent sending the joint values to the robot (uint32, ns)
+ *
+ * If the file is compressed, the whole file is a gzip stream containing the format above.
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <deque>
+#include <iostream>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/thread.hpp>
+
+namespace hormodular {
+
+/*!
+ *  \class Recorder
+ *  \brief Streaming binary recorder for joint values, module IDs and timings
+ *
+ *  Records are appended to an in-memory chunk. Full chunks are handed to a writer thread that
+ *  writes them to the file (compressing them, if enabled), so the cost of recording a step on
+ *  the control loop is a copy of a few bytes.
+ */
+class Recorder
+{
+    public:
+        //! \brief Types of records stored on a recording
+        enum RecordType { JOINT_VALUES = 1,
+                          MODULES = 2,
+                          TIMING = 3 };
+
+        //! \brief Contents of a record, as read by RecordingReader
+        struct Record
+        {
+            RecordType type;
+            uint64_t time_us;
+            std::vector<float> joint_values;
+            std::vector<uint64_t> ids;
+            std::vector<int32_t> configuration_ids;
+            uint32_t send_time_ns;
+        };
+
+        static const uint32_t MAGIC = 0x43524d48;   //-- "HMRC"
+        static const uint32_t VERSION = 1;
+        static const int DEFAULT_CHUNK_SIZE = 65536;
+
+        //! \brief Returns the size in bytes of a record of the given type (including type and time)
+        static int getRecordSize(RecordType type, int num_modules);
+
+        Recorder();
+        ~Recorder();
+
+        /*!
+         * \brief Creates a new recording file
+         * \param filepath Path of the recording file
+         * \param num_modules Number of modules of the robot recorded
+         * \param step_ms Control step of the robot, stored on the header
+         * \param compressed If true, the file is compressed with gzip
+         * \param chunk_size Size in bytes of the chunks written to the file
+         * \return True if completed successfully, false otherwise
+         */
+        bool open(const std::string& filepath, int num_modules, float step_ms, bool compressed = false,
+                  int chunk_size = DEFAULT_CHUNK_SIZE);
+
+        //! \brief Writes the pending records and closes the file
+        bool close();
+
+        bool isOpen() const;
+
+        /*!
+         * \brief Queues the records of the current chunk to be written to the file
+         * \return False if the recording is not open or a previous write failed
+         */
+        bool flush();
+
+        //! \brief Records the joint values sent to the robot (one per module)
+        void recordJointValues(uint64_t time_us, const std::vector<float>& joint_values);
+
+        //! \brief Records the IDs and configuration IDs of all the modules
+        void recordModules(uint64_t time_us, const std::vector<uint64_t>& ids,
+                           const std::vector<int32_t>& configuration_ids);
+
+        //! \brief Records the time spent sending the joint values to the robot
+        void recordTiming(uint64_t time_us, uint32_t send_time_ns);
+
+        //! \brief Returns the number of records stored since the file was opened
+        unsigned long getNumRecords() const;
+
+    private:
+        //! \brief Makes room for a record on the current chunk and writes its type and time
+        void beginRecord(RecordType type, uint64_t time_us);
+
+        //! \brief Writes the queued chunks to the file until the recording is closed
+        void writerLoop();
+
+        template<class T> void put(const T& value)
+        {
+            memcpy(&chunk[chunk_used], &value, sizeof(T));
+            chunk_used += sizeof(T);
+        }
+
+        boost::iostreams::filtering_ostream out;
+        bool opened;
+        int num_modules;
+        unsigned long num_records;
+
+        std::vector<char> chunk;
+        int chunk_size;
+        int chunk_used;
+        uint32_t chunk_records;
+        int record_sizes[TIMING + 1];
+
+        //-- Writer thread
+        boost::thread writer;
+        boost::mutex queue_mutex;
+        boost::condition_variable queue_condition;
+        std::deque<std::vector<char> > pending_chunks;
+        std::vector<std::vector<char> > free_chunks;
+        bool stopping;
+        bool write_failed;
+};
+
+}
+
+#endif //-- RECORDER_H
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+//-- RecordingReader
+//------------------------------------------------------------------------------
+//--
+//-- Reads the recordings created by Recorder
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "RecordingReader.hpp"
+
+#include <fstream>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+
+hormodular::RecordingReader::RecordingReader()
+{
+    opened = false;
+    compressed = false;
+    num_modules = 0;
+    step_ms = 0;
+    chunk_pos = 0;
+    chunk_records_left = 0;
+}
+
+bool hormodular::RecordingReader::open(const std::string &filepath)
+{
+    close();
+
+    //-- Check for the gzip magic number
+    unsigned char magic[2] = { 0, 0 };
+    std::ifstream file(filepath.c_str(), std::ios_base::in | std::ios_base::binary);
+    if ( !file.is_open() )
+    {
+        std::cerr << "[RecordingReader] Error: could not open recording file \"" << filepath << "\"" << std::endl;
+        return false;
+    }
+    file.read((char *) magic, 2);
+    file.close();
+
+    compressed = magic[0] == 0x1f && magic[1] == 0x8b;
+    if ( compressed )
+        in.push(boost::iostreams::gzip_decompressor());
+    in.push(boost::iostreams::file_source(filepath, std::ios_base::in | std::ios_base::binary));
+
+    uint32_t header[3];
+    in.read((char *) header, sizeof(header));
+    in.read((char *) &step_ms, sizeof(step_ms));
+
+    if ( !in.good() || header[0] != Recorder::MAGIC )
+    {
+        std::cerr << "[RecordingReader] Error: \"" << filepath << "\" is not a recording file" << std::endl;
+        in.reset();
+        return false;
+    }
+
+    if ( header[1] != Recorder::VERSION )
+    {
+        std::cerr << "[RecordingReader] Error: unsupported recording version " << header[1] << std::endl;
+        in.reset();
+        return false;
+    }
+
+    num_modules = header[2];
+    opened = true;
+    return true;
+}
+
+void hormodular::RecordingReader::close()
+{
+    if ( !in.empty() )
+        in.reset();
+
+    opened = false;
+    chunk.clear();
+    chunk_pos = 0;
+    chunk_records_left = 0;
+}
+
+bool hormodular::RecordingReader::readNext(hormodular::Recorder::Record &record)
+{
+    if ( !opened )
+        return false;
+
+    if ( chunk_records_left == 0 && !readChunk() )
+        return false;
+
+    //-- Check that the record fits in the rest of the chunk
+    int header_size = sizeof(uint8_t) + sizeof(uint64_t);
+    int record_size = 0;
+    if ( chunk_pos + header_size <= (int) chunk.size() )
+        record_size = Recorder::getRecordSize((Recorder::RecordType) chunk[chunk_pos], num_modules);
+
+    if ( record_size == 0 || chunk_pos + record_size > (int) chunk.size() )
+    {
+        std::cerr << "[RecordingReader] Error: corrupted record found" << std::endl;
+        close();
+        return false;
+    }
+
+    record.type = (Recorder::RecordType) get<uint8_t>();
+    record.time_us = get<uint64_t>();
+
+    switch (record.type)
+    {
+        case Recorder::JOINT_VALUES:
+            record.joint_values.resize(num_modules);
+            for (int i = 0; i < num_modules; i++)
+                record.joint_values[i] = get<float>();
+            break;
+
+        case Recorder::MODULES:
+            record.ids.resize(num_modules);
+            record.configuration_ids.resize(num_modules);
+            for (int i = 0; i < num_modules; i++)
+                record.ids[i] = get<uint64_t>();
+            for (int i = 0; i < num_modules; i++)
+                record.configuration_ids[i] = get<int32_t>();
+            break;
+
+        case Recorder::TIMING:
+            record.send_time_ns = get<uint32_t>();
+            break;
+    }
+
+    chunk_records_left--;
+    return true;
+}
+
+int hormodular::RecordingReader::getNumModules() const
+{
+    return num_modules;
+}
+
+float hormodular::RecordingReader::getStepTime() const
+{
+    return step_ms;
+}
+
+bool hormodular::RecordingReader::isCompressed() const
+{
+    return compressed;
+}
+
+bool hormodular::RecordingReader::readChunk()
+{
+    uint32_t chunk_header[2];
+    in.read((char *) chunk_header, sizeof(chunk_header));
+    if ( in.gcount() == 0 )
+        return false;   //-- End of the recording
+
+    if ( in.gcount() != sizeof(chunk_header) || chunk_header[0] == 0 || chunk_header[1] == 0 )
+    {
+        std::cerr << "[RecordingReader] Error: truncated chunk found" << std::endl;
+        close();
+        return false;
+    }
+
+    chunk.resize(chunk_header[0]);
+    in.read(&chunk[0], chunk_header[0]);
+    if ( in.gcount() != (std::streamsize) chunk_header[0] )
+    {
+        std::cerr << "[RecordingReader] Error: truncated chunk found" << std::endl;
+        close();
+        return false;
+    }
+
+    chunk_pos = 0;
+    chunk_records_left = chunk_header[1];
+    return true;
+}
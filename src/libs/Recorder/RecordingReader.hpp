@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//-- RecordingReader
+//------------------------------------------------------------------------------
+//--
+//-- Reads the recordings created by Recorder
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file RecordingReader.hpp
+ *  \brief Reads the recordings created by Recorder
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef RECORDING_READER_H
+#define RECORDING_READER_H
+
+#include <string>
+#include <vector>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "Recorder.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class RecordingReader
+ *  \brief Reads the recordings created by Recorder, one chunk at a time
+ *
+ *  Compressed recordings are detected automatically.
+ */
+class RecordingReader
+{
+    public:
+        RecordingReader();
+
+        /*!
+         * \brief Opens a recording file and reads its header
+         * \return True if completed successfully, false otherwise
+         */
+        bool open(const std::string& filepath);
+
+        void close();
+
+        /*!
+         * \brief Reads the next record of the recording
+         * \param record Record where the contents are stored
+         * \return True if a record was read, false at the end of the recording or on error
+         */
+        bool readNext(Recorder::Record& record);
+
+        int getNumModules() const;
+
+        //! \brief Returns the control step (in ms) stored on the recording header
+        float getStepTime() const;
+
+        bool isCompressed() const;
+
+    private:
+        //! \brief Loads the next chunk of the file
+        bool readChunk();
+
+        template<class T> T get()
+        {
+            T value;
+            memcpy(&value, &chunk[chunk_pos], sizeof(T));
+            chunk_pos += sizeof(T);
+            return value;
+        }
+
+        boost::iostreams::filtering_istream in;
+        bool opened;
+        bool compressed;
+        int num_modules;
+        float step_ms;
+
+        std::vector<char> chunk;
+        int chunk_pos;
+        uint32_t chunk_records_left;
+};
+
+}
+
+#endif //-- RECORDING_READER_H
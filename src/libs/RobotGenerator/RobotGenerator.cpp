@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+//-- RobotGenerator
+//------------------------------------------------------------------------------
+//--
+//-- Generates configuration files of synthetic robots of any size
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+#include "RobotGenerator.hpp"
+
+#include <fstream>
+#include <set>
+#include <cmath>
+#include <cstdlib>
+
+#include "ConfigParser.h"
+#include "IdSolver.hpp"
+
+//-- Connector names, in connector index order
+static const char * CONNECTOR_NAMES[] = { "front", "right", "back", "left" };
+
+hormodular::RobotGenerator::RobotGenerator(Shape shape, int numModules, unsigned int seed)
+{
+    this->numModules = numModules > 0 ? numModules : 1;
+    this->seed = seed;
+    numGaitTableRows = 0;
+
+    connectedModule.assign(this->numModules * RobotDescription::NUM_CONNECTORS, -1);
+    connectedConnector.assign(this->numModules * RobotDescription::NUM_CONNECTORS, -1);
+
+    rolls.resize(this->numModules);
+    for (int i = 0; i < this->numModules; i++)
+        rolls[i] = 90 * random(4);
+
+    if ( shape == TREE )
+        generateTree();
+    else
+        generateLattice();
+}
+
+bool hormodular::RobotGenerator::save(const std::string &folder, const std::string &name, int descriptorDepth)
+{
+    if ( !saveConfigFile(folder, name) )
+        return false;
+
+    //-- The gait table is indexed by the descriptors of the robot saved
+    ConfigParser configParser;
+    configParser.setCacheEnabled(false);
+    if ( configParser.parse(getConfigFile(folder, name)) != 0 )
+        return false;
+
+    IdSolver idSolver(configParser.getRobotDescription());
+    std::vector<unsigned long> ids = idSolver.getDescriptorIDs(descriptorDepth);
+    std::set<unsigned long> uniqueIds(ids.begin(), ids.end());
+
+    std::string gaitTableFile = folder + "/" + name + "-gaittable.txt";
+    std::ofstream gaitTable(gaitTableFile.c_str());
+    if ( !gaitTable.is_open() )
+    {
+        std::cerr << "[RobotGenerator] Error: could not open \"" << gaitTableFile << "\"" << std::endl;
+        return false;
+    }
+
+    gaitTable << "# Gait Table created by Hormodular [https://github.com/David-Estevez/hormodular.git]" << std::endl
+              << "# name: gaitTable" << std::endl
+              << "# type: matrix" << std::endl
+              << "# rows: " << uniqueIds.size() << std::endl
+              << "# columns: 4" << std::endl
+              << "# descriptor depth: " << descriptorDepth << std::endl;
+
+    //-- Placeholder parameters: amplitude, offset and phase
+    for (std::set<unsigned long>::iterator it = uniqueIds.begin(); it != uniqueIds.end(); ++it)
+        gaitTable << *it << " " << 10 + random(80) << " " << random(21) - 10 << " " << random(360) << std::endl;
+
+    numGaitTableRows = uniqueIds.size();
+
+    std::string frequencyTableFile = folder + "/" + name + "-frequencies.txt";
+    std::ofstream frequencyTable(frequencyTableFile.c_str());
+    if ( !frequencyTable.is_open() )
+    {
+        std::cerr << "[RobotGenerator] Error: could not open \"" << frequencyTableFile << "\"" << std::endl;
+        return false;
+    }
+
+    frequencyTable << "# Gait Table created by Hormodular [https://github.com/David-Estevez/hormodular.git]" << std::endl
+                   << "# name: gaitTable" << std::endl
+                   << "# type: matrix" << std::endl
+                   << "# rows: 1" << std::endl
+                   << "# columns: 2" << std::endl
+                   << "0 1" << std::endl;
+
+    return gaitTable.good() && frequencyTable.good();
+}
+
+std::string hormodular::RobotGenerator::getConfigFile(const std::string &folder, const std::string &name)
+{
+    return folder + "/" + name + ".xml";
+}
+
+int hormodular::RobotGenerator::getNumModules()
+{
+    return numModules;
+}
+
+int hormodular::RobotGenerator::getNumGaitTableRows()
+{
+    return numGaitTableRows;
+}
+
+bool hormodular::RobotGenerator::parseShape(const std::string &name, Shape &shape)
+{
+    if ( name.compare("tree") == 0 )
+        shape = TREE;
+    else if ( name.compare("lattice") == 0 )
+        shape = LATTICE;
+    else
+        return false;
+
+    return true;
+}
+
+void hormodular::RobotGenerator::generateTree()
+{
+    //-- Free connectors (module * 4 + connector) of the modules already placed
+    std::vector<int> freeConnectors;
+    for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+        freeConnectors.push_back(j);
+
+    for (int i = 1; i < numModules; i++)
+    {
+        //-- Attach a random connector of the new module to a random free connector
+        int index = random(freeConnectors.size());
+        int parent = freeConnectors[index];
+        freeConnectors[index] = freeConnectors.back();
+        freeConnectors.pop_back();
+
+        int childConnector = random(RobotDescription::NUM_CONNECTORS);
+        connect(parent / RobotDescription::NUM_CONNECTORS, parent % RobotDescription::NUM_CONNECTORS,
+                i, childConnector);
+
+        for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+            if ( j != childConnector )
+                freeConnectors.push_back(i * RobotDescription::NUM_CONNECTORS + j);
+    }
+}
+
+void hormodular::RobotGenerator::generateLattice()
+{
+    //-- Modules placed row by row, front connector towards the next row and right connector
+    //-- towards the next column
+    int width = (int) ceil(sqrt((double) numModules));
+
+    for (int i = 0; i < numModules; i++)
+    {
+        if ( (i % width) + 1 < width && i + 1 < numModules )
+            connect(i, 1, i + 1, 3);
+
+        if ( i + width < numModules )
+            connect(i, 0, i + width, 2);
+    }
+}
+
+void hormodular::RobotGenerator::connect(int moduleA, int connectorA, int moduleB, int connectorB)
+{
+    connectedModule[moduleA * RobotDescription::NUM_CONNECTORS + connectorA] = moduleB;
+    connectedConnector[moduleA * RobotDescription::NUM_CONNECTORS + connectorA] = connectorB;
+    connectedModule[moduleB * RobotDescription::NUM_CONNECTORS + connectorB] = moduleA;
+    connectedConnector[moduleB * RobotDescription::NUM_CONNECTORS + connectorB] = connectorA;
+}
+
+int hormodular::RobotGenerator::random(int max)
+{
+    return rand_r(&seed) % max;
+}
+
+bool hormodular::RobotGenerator::saveConfigFile(const std::string &folder, const std::string &name)
+{
+    std::string configFile = getConfigFile(folder, name);
+    std::ofstream file(configFile.c_str());
+    if ( !file.is_open() )
+    {
+        std::cerr << "[RobotGenerator] Error: could not open \"" << configFile << "\"" << std::endl;
+        return false;
+    }
+
+    file << "<ModularRobot name=\"" << name << "\">" << std::endl
+         << "\t<simulationFile>none</simulationFile>" << std::endl
+         << "\t<gaitTableFolder>" << folder << "/</gaitTableFolder>" << std::endl
+         << "\t<frequencyTable>" << folder << "/" << name << "-frequencies.txt</frequencyTable>" << std::endl
+         << "\t<gaitTables>" << std::endl
+         << "\t\t<gaitTable configuration=\"0\">" << name << "-gaittable.txt</gaitTable>" << std::endl
+         << "\t</gaitTables>" << std::endl
+         << "\t<serialPort>/dev/ttyUSB0</serialPort>" << std::endl;
+
+    for (int i = 0; i < numModules; i++)
+    {
+        file << "\t<Module>" << std::endl
+             << "\t\t<Joint>" << i << "</Joint>" << std::endl
+             << "\t\t<IDs>" << std::endl
+             << "\t\t\t<Function>None</Function>" << std::endl
+             << "\t\t\t<Depth>-1</Depth>" << std::endl
+             << "\t\t\t<Shape>0</Shape>" << std::endl
+             << "\t\t\t<NumLimbs>0</NumLimbs>" << std::endl
+             << "\t\t\t<LimbID>-1</LimbID>" << std::endl
+             << "\t\t</IDs>" << std::endl
+             << "\t\t<Orientation>" << std::endl
+             << "\t\t\t<Roll>" << rolls[i] << "</Roll>" << std::endl
+             << "\t\t\t<Pitch>0</Pitch>" << std::endl
+             << "\t\t\t<Yaw>0</Yaw>" << std::endl
+             << "\t\t</Orientation>" << std::endl
+             << "\t\t<Connections>" << std::endl;
+
+        for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+        {
+            int index = i * RobotDescription::NUM_CONNECTORS + j;
+            if ( connectedModule[index] >= 0 )
+                file << "\t\t\t<" << CONNECTOR_NAMES[j] << " connectedTo=\"" << connectedModule[index]
+                     << "\" connector=\"" << CONNECTOR_NAMES[connectedConnector[index]]
+                     << "\" orientation=\"0\"/>" << std::endl;
+        }
+
+        file << "\t\t</Connections>" << std::endl
+             << "\t</Module>" << std::endl;
+    }
+
+    file << "</ModularRobot>" << std::endl;
+
+    return file.good();
+}
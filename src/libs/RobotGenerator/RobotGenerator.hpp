@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+//-- RobotGenerator
+//------------------------------------------------------------------------------
+//--
+//-- Generates configuration files of synthetic robots of any size
+//--
+//------------------------------------------------------------------------------
+//--
+//-- This file belongs to the Hormodular project
+//-- (https://github.com/David-Estevez/hormodular.git)
+//--
+//------------------------------------------------------------------------------
+//-- Author: David Estevez-Fernandez
+//--
+//-- Released under the GPL license (more info on LICENSE.txt file)
+//------------------------------------------------------------------------------
+
+/*! \file RobotGenerator.hpp
+ *  \brief Generates configuration files of synthetic robots of any size
+ *
+ * \author David Estévez Fernández ( http://github.com/David-Estevez )
+ */
+
+#ifndef ROBOT_GENERATOR_H
+#define ROBOT_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "Module.hpp"
+
+namespace hormodular {
+
+/*!
+ *  \class RobotGenerator
+ *  \brief Generates configuration files of synthetic robots of any size, to test how the controller scales
+ *
+ *  Robots are either random trees (each module is attached to a random free connector of the
+ *  modules already placed) or square lattices (each module connected to its four neighbours).
+ *  Besides the configuration file, a placeholder gait table indexed by descriptor IDs (with random
+ *  oscillator parameters) and a frequency table are saved, so that the robot can be run with the
+ *  "ids" property of ModularRobot set to "descriptor".
+ */
+class RobotGenerator
+{
+    public:
+        //! \brief Shapes of the robots generated
+        enum Shape { TREE, LATTICE };
+
+        /*!
+         * \brief Generates a robot
+         * \param shape Shape of the robot
+         * \param numModules Number of modules of the robot
+         * \param seed Seed of the random connections, orientations and gait parameters
+         */
+        RobotGenerator(Shape shape, int numModules, unsigned int seed = 0);
+
+        /*!
+         * \brief Saves the configuration file, the gait table and the frequency table of the robot
+         *
+         * The files saved are "<name>.xml", "<name>-gaittable.txt" and "<name>-frequencies.txt". The
+         * paths on the configuration file are built with the \a folder given.
+         *
+         * \param folder Folder where the files are saved
+         * \param name Name of the robot
+         * \param descriptorDepth Depth of the descriptor IDs of the gait table
+         * \return True if completed successfully, false otherwise
+         */
+        bool save(const std::string& folder, const std::string& name,
+                  int descriptorDepth = Module::DEFAULT_DESCRIPTOR_DEPTH);
+
+        //! \brief Returns the path of the configuration file saved by save()
+        static std::string getConfigFile(const std::string& folder, const std::string& name);
+
+        int getNumModules();
+
+        //! \brief Returns the number of rows of the gait table saved by the last call to save()
+        int getNumGaitTableRows();
+
+        /*!
+         * \brief Parses a shape name ("tree" or "lattice")
+         * \return True if the name is valid, false otherwise
+         */
+        static bool parseShape(const std::string& name, Shape& shape);
+
+    private:
+        void generateTree();
+        void generateLattice();
+
+        //! \brief Connects connector \a connectorA of module \a moduleA to connector \a connectorB of \a moduleB
+        void connect(int moduleA, int connectorA, int moduleB, int connectorB);
+
+        //! \brief Returns a random number in [0, max), from the generator seed
+        int random(int max);
+
+        bool saveConfigFile(const std::string& folder, const std::string& name);
+
+        int numModules;
+        unsigned int seed;
+        int numGaitTableRows;
+
+        //! \brief Module and connector connected to each connector (index module * 4 + connector), -1 if none
+        std::vector<int> connectedModule;
+        std::vector<int> connectedConnector;
+
+        //! \brief Roll of each module (multiple of 90 degrees)
+        std::vector<int> rolls;
+};
+
+}
+
+#endif //-- ROBOT_GENERATOR_H
@@ -20,9 +20,15 @@
 
 #include "SimulationOpenRAVE.hpp"
 
-hormodular::SimulationOpenRAVE::SimulationOpenRAVE(std::string environment_file, bool show_simulation)
+#include <algorithm>
+
+hormodular::SimulationOpenRAVE::SimulationOpenRAVE(std::string environment_file, bool show_simulation,
+                                                   int robot_copies, double copies_gap)
 {
     this->environment_file = environment_file;
+    this->robot_copies = robot_copies;
+    this->copies_gap = copies_gap;
+    copies_spacing = 0;
 
     //-- Initialize OpenRAVE:
     OpenRAVE::RaveInitialize(true);
@@ -35,6 +41,8 @@ hormodular::SimulationOpenRAVE::SimulationOpenRAVE(std::string environment_file,
     //-- Run the viewer on a different thread, and wait for it to be ready:
     this->show_simulation = show_simulation;
     pthviewer = NULL;
+    viewer_ready = false;
+    viewer_failed = false;
 
     if ( show_simulation )
         showViewer();
@@ -45,7 +53,7 @@ hormodular::SimulationOpenRAVE::SimulationOpenRAVE(std::string environment_file,
 
 hormodular::SimulationOpenRAVE::~SimulationOpenRAVE()
 {
-    if (show_simulation && pthviewer != NULL)
+    if (pthviewer != NULL)
     {
         //-- Wait for the viewer to finish
         pthviewer->join();
@@ -61,7 +69,7 @@ hormodular::SimulationOpenRAVE::~SimulationOpenRAVE()
 
 void hormodular::SimulationOpenRAVE::init()
 {
-    //-- Load the scene and wait for it to be ready:
+    //-- Load the scene (the environment is ready once Load returns):
     if ( !penv->Load( environment_file) )
     {
         std::cerr<< "[SimulationOpenRAVE] Error: could not load environment file!" << std::endl;
@@ -69,10 +77,15 @@ void hormodular::SimulationOpenRAVE::init()
         penv->Destroy();
         exit(-1);
     }
-    usleep(100000);
 
     //-- Get the robot from the environment
     penv->GetRobots( robots );
+
+    if ( robot_copies > 1 )
+    {
+        createRobotCopies();
+        penv->GetRobots( robots );
+    }
     std::cout << "[Debug] Loaded " << robots.size() << " robots." << std::endl;
 
     //-- Lock the environment mutex:
@@ -100,6 +113,9 @@ void hormodular::SimulationOpenRAVE::init()
     //-- Reset controller and wait:
     for( int i = 0; i < (int) robots.size(); i++)
         robots[i]->GetController()->Reset();
+
+    //-- Store the initial state, to be restored on reset
+    saveSnapshot();
 }
 
 
@@ -120,12 +136,41 @@ OpenRAVE::RobotBasePtr hormodular::SimulationOpenRAVE::getRobot(int index) const
     return robots[index];
 }
 
+double hormodular::SimulationOpenRAVE::getCopiesSpacing() const
+{
+    return copies_spacing;
+}
+
 
-void hormodular::SimulationOpenRAVE::showViewer()
+bool hormodular::SimulationOpenRAVE::showViewer()
 {
+    //-- Only one viewer
+    if ( pthviewer != NULL )
+        return true;
+
     show_simulation = true;
+    viewer_ready = false;
+    viewer_failed = false;
     pthviewer = new boost::thread(boost::bind(&hormodular::SimulationOpenRAVE::startViewer, this));
-    usleep(200000);
+
+    //-- Wait for the viewer to be attached to the environment
+    {
+        boost::mutex::scoped_lock lock(viewer_ready_mutex);
+        while ( !viewer_ready && !viewer_failed )
+            viewer_ready_condition.wait(lock);
+    }
+
+    if ( viewer_failed )
+    {
+        //-- The viewer thread has already returned
+        pthviewer->join();
+        delete pthviewer;
+        pthviewer = NULL;
+        show_simulation = false;
+        return false;
+    }
+
+    return true;
 }
 
 void hormodular::SimulationOpenRAVE::start( OpenRAVE::dReal step_period, bool real_time)
@@ -144,18 +189,135 @@ void hormodular::SimulationOpenRAVE::step(OpenRAVE::dReal step_period)
 }
 
 void hormodular::SimulationOpenRAVE::reset()
+{
+    if ( !restoreSnapshot() )
+        reload();
+}
+
+void hormodular::SimulationOpenRAVE::reload()
 {
     penv->Reset();
 
     init();
 }
 
+void hormodular::SimulationOpenRAVE::saveSnapshot()
+{
+    OpenRAVE::EnvironmentMutex::scoped_lock lock(penv->GetMutex());
+
+    std::vector<OpenRAVE::KinBodyPtr> bodies;
+    penv->GetBodies(bodies);
+
+    snapshot.clear();
+    for (int i = 0; i < (int) bodies.size(); i++)
+    {
+        BodyState state;
+        state.body = bodies[i];
+        bodies[i]->GetLinkTransformations(state.link_transforms, state.dof_branches);
+        bodies[i]->GetLinkVelocities(state.link_velocities);
+        bodies[i]->GetDOFValues(state.dof_values);
+        snapshot.push_back(state);
+    }
+}
+
+bool hormodular::SimulationOpenRAVE::restoreSnapshot()
+{
+    OpenRAVE::EnvironmentMutex::scoped_lock lock(penv->GetMutex());
+
+    //-- The snapshot is only valid if the environment contains the same bodies
+    std::vector<OpenRAVE::KinBodyPtr> bodies;
+    penv->GetBodies(bodies);
+
+    if ( snapshot.empty() || bodies.size() != snapshot.size() )
+        return false;
+
+    for (int i = 0; i < (int) snapshot.size(); i++)
+        if ( bodies[i] != snapshot[i].body )
+            return false;
+
+    //-- Restore the bodies
+    for (int i = 0; i < (int) snapshot.size(); i++)
+    {
+        BodyState& state = snapshot[i];
+        state.body->SetDOFValues(state.dof_values);
+        state.body->SetLinkTransformations(state.link_transforms, state.dof_branches);
+        state.body->SetLinkVelocities(state.link_velocities);
+    }
+
+    lock.unlock();
+
+    //-- Reset controllers
+    for( int i = 0; i < (int) robots.size(); i++)
+        robots[i]->GetController()->Reset();
+
+    return true;
+}
+
+void hormodular::SimulationOpenRAVE::createRobotCopies()
+{
+    if ( robots.empty() )
+    {
+        std::cerr << "[SimulationOpenRAVE] Error: there is no robot to copy!" << std::endl;
+        return;
+    }
+
+    OpenRAVE::EnvironmentMutex::scoped_lock lock(penv->GetMutex());
+
+    //-- Copies are placed on a grid around the original robot, which is the first one, separated by
+    //-- the footprint of the robot (so that long robots do not overlap) plus the free gap
+    OpenRAVE::AABB aabb = robots[0]->ComputeAABB();
+    double footprint = 2 * std::max(aabb.extents.x, aabb.extents.y);
+    copies_spacing = footprint + copies_gap;
+
+    int columns = (int) ceil( sqrt( (double) robot_copies));
+    OpenRAVE::Transform original_transform = robots[0]->GetTransform();
+
+    for (int i = 1; i < robot_copies; i++)
+    {
+        OpenRAVE::RobotBasePtr copy = OpenRAVE::RaveCreateRobot(penv, robots[0]->GetXMLId());
+        copy->Clone(robots[0], 0);
+
+        std::stringstream name;
+        name << robots[0]->GetName() << "_" << i;
+        copy->SetName(name.str());
+
+        OpenRAVE::Transform transform = original_transform;
+        transform.trans.x += (i % columns) * copies_spacing;
+        transform.trans.y += (i / columns) * copies_spacing;
+        copy->SetTransform(transform);
+
+        penv->Add(copy, true);
+    }
+}
+
 void hormodular::SimulationOpenRAVE::startViewer()
 {
         //-- Create the viewer and attach it to the environment
-        pviewer = OpenRAVE::RaveCreateViewer(penv, "qtcoin");
-        BOOST_ASSERT(!!pviewer);
-        penv->Add( pviewer);
+        try
+        {
+            pviewer = OpenRAVE::RaveCreateViewer(penv, "qtcoin");
+            if ( pviewer )
+                penv->Add( pviewer);
+        }
+        catch ( std::exception& e )
+        {
+            std::cerr << "[SimulationOpenRAVE] Error: " << e.what() << std::endl;
+            pviewer.reset();
+        }
+
+        if ( !pviewer )
+            std::cerr << "[SimulationOpenRAVE] Error: could not create the viewer" << std::endl;
+
+        //-- Notify that the viewer is ready (or that it failed)
+        {
+            boost::mutex::scoped_lock lock(viewer_ready_mutex);
+            viewer_ready = !!pviewer;
+            viewer_failed = !pviewer;
+        }
+        viewer_ready_condition.notify_all();
+
+        if ( !pviewer )
+            return;
 
         //-- Show viewer
         pviewer->main(show_simulation);
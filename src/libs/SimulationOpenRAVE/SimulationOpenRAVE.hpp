@@ -31,6 +31,8 @@
 
 #include <openrave-core.h>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/bind.hpp>
 
 #include <iostream>
@@ -50,8 +52,14 @@ class SimulationOpenRAVE
          * \brief Creates a SimulationOpenRAVE using the environment defined in the environment_file
          * \param environment_file Path to the XML file defining the OpenRAVE simulation environment
          * \param show_simulation If true (default value), enables the simulation viewer
+         * \param robot_copies Number of copies of the first robot of the environment to be simulated
+         * at the same time (including the original one)
+         * \param copies_gap Free distance (in m) between the bounding boxes of neighbouring copies, that
+         * are placed on a grid. It has to be larger than what two copies can travel towards each other,
+         * as the copies collide with each other
          */
-        SimulationOpenRAVE( std::string environment_file , bool show_simulation = true);
+        SimulationOpenRAVE( std::string environment_file , bool show_simulation = true, int robot_copies = 1,
+                            double copies_gap = 1.0);
         ~SimulationOpenRAVE();
 
 
@@ -63,9 +71,18 @@ class SimulationOpenRAVE
         std::vector<OpenRAVE::RobotBasePtr> getRobots() const;
         OpenRAVE::RobotBasePtr getRobot( int index = 0) const;
 
+        //! \brief Returns the distance (in m) between the origins of neighbouring copies of the robot
+        double getCopiesSpacing() const;
 
-        //! \brief Starts the dedicated thread for the viewer and calls the startViewer function to create a viewer
-        void showViewer();
+
+        /*!
+         * \brief Starts the dedicated thread for the viewer and calls the startViewer function to create a viewer
+         *
+         * Returns once the viewer has been attached to the environment, or has failed to be created.
+         * Calling it again once the viewer is shown does nothing.
+         * \return True if the viewer is shown, false if it could not be created
+         */
+        bool showViewer();
 
         //! \brief Starts the simulation with a given period (in s) that can be run in real time
         void start(OpenRAVE::dReal step_period, bool real_time = true);
@@ -76,18 +93,64 @@ class SimulationOpenRAVE
         //! \brief Advances the simulation only a step of the specified duration
         void step( OpenRAVE::dReal step_period);
 
-        //! \brief Resets the simulation, reloading the environment, robots and controllers
+        /*!
+         * \brief Resets the simulation, returning all the bodies to the state they had after loading the
+         * environment
+         *
+         * The state saved by saveSnapshot() is restored in-place. If there is no snapshot or the
+         * bodies in the environment changed, the environment is reloaded instead (see reload()).
+         */
         void reset();
 
+        //! \brief Resets the simulation, reloading the environment, robots and controllers from disk
+        void reload();
+
+        /*!
+         * \brief Stores the current state of all the bodies in the environment (link transforms,
+         * joint values and velocities). It is called by init() once the environment is loaded.
+         */
+        void saveSnapshot();
+
+        /*!
+         * \brief Restores the state stored by saveSnapshot() and resets the controllers
+         * \return True if completed successfully, false if there is no valid snapshot
+         */
+        bool restoreSnapshot();
+
 private:
         //! \brief Creates a viewer and attaches it to the environment
         void startViewer();
+
+        //! \brief Adds the copies of the first robot to the environment
+        void createRobotCopies();
+        int robot_copies;
+        double copies_gap;
+        double copies_spacing;
+
         std::string environment_file;
         OpenRAVE::EnvironmentBasePtr penv;
         OpenRAVE::ViewerBasePtr pviewer;
         boost::thread * pthviewer;
+
+        //! \brief Signalled by the viewer thread once the viewer is attached to the environment (or failed)
+        boost::condition_variable viewer_ready_condition;
+        boost::mutex viewer_ready_mutex;
+        bool viewer_ready;
+        bool viewer_failed;
         std::vector< OpenRAVE::RobotBasePtr > robots;
         bool show_simulation;
+
+        //! \brief State of a body stored on a snapshot
+        struct BodyState
+        {
+            OpenRAVE::KinBodyPtr body;
+            std::vector<OpenRAVE::Transform> link_transforms;
+            std::vector<int> dof_branches;
+            std::vector< std::pair<OpenRAVE::Vector, OpenRAVE::Vector> > link_velocities;
+            std::vector<OpenRAVE::dReal> dof_values;
+        };
+
+        std::vector<BodyState> snapshot;
 };
 }
 
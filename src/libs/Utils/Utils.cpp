@@ -28,3 +28,28 @@ std::vector<std::string> hormodular::splitString(std::string stringToSplit)
     return tokens;
 
 }
+
+//-- Multiplier of the 32-bit FNV-1a hash
+static const uint32_t FNV1A_PRIME = 16777619u;
+
+uint32_t hormodular::hashFNV1a(uint32_t hash, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        hash ^= (value >> (8 * i)) & 0xff;
+        hash *= FNV1A_PRIME;
+    }
+
+    return hash;
+}
+
+uint32_t hormodular::hashFNV1a(uint32_t hash, const char *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (unsigned char) data[i];
+        hash *= FNV1A_PRIME;
+    }
+
+    return hash;
+}
@@ -18,6 +18,8 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdint.h>
+#include <cstddef>
 #include <string>
 #include <sstream>
 #include <algorithm>
@@ -35,5 +37,25 @@ namespace hormodular
  */
 std::vector<std::string> splitString(std::string stringToSplit);
 
+//! \brief Initial value for the FNV-1a hash
+static const uint32_t FNV1A_OFFSET_BASIS = 2166136261u;
+
+/*!
+ * \brief Combines a value with a hash using the 32-bit FNV-1a function (byte by byte)
+ * \param hash Current hash value (FNV1A_OFFSET_BASIS for an empty hash)
+ * \param value Value to add to the hash
+ * \return The resulting hash
+ */
+uint32_t hashFNV1a(uint32_t hash, uint32_t value);
+
+/*!
+ * \brief Combines a block of bytes with a hash using the 32-bit FNV-1a function
+ * \param hash Current hash value (FNV1A_OFFSET_BASIS for an empty hash)
+ * \param data Bytes to add to the hash
+ * \param size Number of bytes to add
+ * \return The resulting hash
+ */
+uint32_t hashFNV1a(uint32_t hash, const char * data, size_t size);
+
 }
 #endif //-- UTILS_H
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <fstream>
+#include <cstdio>
 #include "ConfigParser.h"
 
 using namespace hormodular;
@@ -146,3 +148,151 @@ TEST_F( ConfigParserTest, orientationReadOk)
     EXPECT_EQ(0, orientations[1].getPitch());
     EXPECT_EQ(0, orientations[1].getYaw());
 }
+
+TEST_F( ConfigParserTest, defaultGaitTablesAreMultiDof)
+{
+    std::vector<std::string> gaitTableFiles = configParser.getGaitTableFiles();
+
+    ASSERT_EQ(3, gaitTableFiles.size());
+    EXPECT_STREQ( "multidof-11-2-gaittable.txt", gaitTableFiles[0].c_str());
+    EXPECT_STREQ( "multidof-7-tripod-gaittable.txt", gaitTableFiles[1].c_str());
+    EXPECT_STREQ( "multidof-9-quad-gaittable.txt", gaitTableFiles[2].c_str());
+}
+
+TEST_F( ConfigParserTest, gaitTablesReadOk)
+{
+    ASSERT_EQ(0, configParser.parse("../../data/test/Test_robot3.xml"));
+    std::vector<std::string> gaitTableFiles = configParser.getGaitTableFiles();
+
+    //-- Configuration 1 has no gait table
+    ASSERT_EQ(3, gaitTableFiles.size());
+    EXPECT_STREQ( "test_gait_table.txt", gaitTableFiles[0].c_str());
+    EXPECT_TRUE( gaitTableFiles[1].empty());
+    EXPECT_STREQ( "test_gait_table.txt", gaitTableFiles[2].c_str());
+}
+
+TEST_F( ConfigParserTest, robotDescriptionIsOk)
+{
+    RobotDescriptionPtr robotDescription = configParser.getRobotDescription();
+    ASSERT_TRUE( robotDescription );
+
+    //-- The same description is shared by all its users
+    EXPECT_EQ( robotDescription.get(), configParser.getRobotDescription().get());
+
+    EXPECT_STREQ( "Test_robot", robotDescription->getRobotName().c_str() );
+    EXPECT_STREQ( "/dev/ttyUSB0", robotDescription->getSerialPort().c_str() );
+    EXPECT_EQ( 3, robotDescription->getGaitTableFiles().size());
+    ASSERT_EQ( 2, robotDescription->getNumModules());
+    EXPECT_EQ( 1, robotDescription->getJointID(1));
+    EXPECT_EQ( 0, robotDescription->getOrientation(1).getYaw());
+
+    //-- Module 0 front connector is connected to module 1 back connector
+    EXPECT_TRUE( robotDescription->getConnection(0, 0).isConnected());
+    EXPECT_EQ( 1, robotDescription->getConnection(0, 0).module);
+    EXPECT_EQ( 2, robotDescription->getConnection(0, 0).connector);
+    EXPECT_EQ( 0, robotDescription->getConnection(0, 0).orientation);
+    EXPECT_EQ( 0, robotDescription->getConnection(1, 2).module);
+    EXPECT_EQ( 0, robotDescription->getConnection(1, 2).connector);
+
+    for (int i = 1; i < RobotDescription::NUM_CONNECTORS; i++)
+        EXPECT_FALSE( robotDescription->getConnection(0, i).isConnected());
+}
+
+TEST_F( ConfigParserTest, robotDescriptionIsEmptyIfParsingFails)
+{
+    EXPECT_NE( 0, configParser.parse("../../data/test/this_file_does_not_exist.xml"));
+    EXPECT_FALSE( configParser.getRobotDescription() );
+}
+
+TEST_F( ConfigParserTest, cacheGivesSameDataAsXML)
+{
+    //-- Work on a copy of the file, to keep the data folder clean
+    const std::string xmlFile = "Test_robot2_cache.xml";
+    const std::string cacheFile = ConfigParser::getCacheFile(xmlFile);
+    {
+        std::ifstream source(FILEPATH.c_str(), std::ios::binary);
+        std::ofstream copy(xmlFile.c_str(), std::ios::binary);
+        copy << source.rdbuf();
+    }
+    std::remove(cacheFile.c_str());
+
+    ConfigParser xmlParser, cacheParser;
+    ASSERT_EQ(0, xmlParser.parse(xmlFile));
+    EXPECT_FALSE( xmlParser.isLoadedFromCache());
+    ASSERT_TRUE( xmlParser.saveCache(cacheFile));
+
+    ASSERT_EQ(0, cacheParser.parse(xmlFile));
+    EXPECT_TRUE( cacheParser.isLoadedFromCache());
+
+    EXPECT_EQ( xmlParser.getRobotName(), cacheParser.getRobotName());
+    EXPECT_EQ( xmlParser.getSimulationFile(), cacheParser.getSimulationFile());
+    EXPECT_EQ( xmlParser.getGaitTableFolder(), cacheParser.getGaitTableFolder());
+    EXPECT_EQ( xmlParser.getFrequencyTableFile(), cacheParser.getFrequencyTableFile());
+    EXPECT_EQ( xmlParser.getGaitTableFiles(), cacheParser.getGaitTableFiles());
+    EXPECT_EQ( xmlParser.getSerialPort(), cacheParser.getSerialPort());
+    ASSERT_EQ( xmlParser.getNumModules(), cacheParser.getNumModules());
+    EXPECT_EQ( xmlParser.getJointIDs(), cacheParser.getJointIDs());
+    EXPECT_EQ( xmlParser.getFunctionIDs(), cacheParser.getFunctionIDs());
+    EXPECT_EQ( xmlParser.getDepthIDs(), cacheParser.getDepthIDs());
+    EXPECT_EQ( xmlParser.getShapeIDs(), cacheParser.getShapeIDs());
+    EXPECT_EQ( xmlParser.getNumLimbsIDs(), cacheParser.getNumLimbsIDs());
+    EXPECT_EQ( xmlParser.getLimbsIDs(), cacheParser.getLimbsIDs());
+
+    for (int i = 0; i < xmlParser.getNumModules(); i++)
+    {
+        EXPECT_EQ( xmlParser.getConnectorInfo(i), cacheParser.getConnectorInfo(i));
+        EXPECT_EQ( xmlParser.getOrientations()[i].getRoll(), cacheParser.getOrientations()[i].getRoll());
+        EXPECT_EQ( xmlParser.getOrientations()[i].getPitch(), cacheParser.getOrientations()[i].getPitch());
+        EXPECT_EQ( xmlParser.getOrientations()[i].getYaw(), cacheParser.getOrientations()[i].getYaw());
+    }
+
+    ASSERT_TRUE( cacheParser.getRobotDescription());
+    EXPECT_EQ( 1, cacheParser.getRobotDescription()->getConnection(0, 0).module);
+
+    //-- Disabling the cache parses the XML file
+    cacheParser.setCacheEnabled(false);
+    ASSERT_EQ(0, cacheParser.parse(xmlFile));
+    EXPECT_FALSE( cacheParser.isLoadedFromCache());
+
+    std::remove(cacheFile.c_str());
+    std::remove(xmlFile.c_str());
+}
+
+TEST_F( ConfigParserTest, cacheIsIgnoredIfXMLChanges)
+{
+    const std::string xmlFile = "Test_robot2_outdated_cache.xml";
+    const std::string cacheFile = ConfigParser::getCacheFile(xmlFile);
+    {
+        std::ifstream source(FILEPATH.c_str(), std::ios::binary);
+        std::ofstream copy(xmlFile.c_str(), std::ios::binary);
+        copy << source.rdbuf();
+    }
+
+    ASSERT_EQ(0, configParser.parse(xmlFile));
+    ASSERT_TRUE( configParser.saveCache(cacheFile));
+
+    //-- Modify the XML file after creating the cache
+    {
+        std::ofstream modified(xmlFile.c_str(), std::ios::binary | std::ios::app);
+        modified << "<!-- modified -->" << std::endl;
+    }
+
+    ASSERT_EQ(0, configParser.parse(xmlFile));
+    EXPECT_FALSE( configParser.isLoadedFromCache());
+    EXPECT_EQ( 2, configParser.getNumModules());
+
+    //-- A corrupt cache is ignored too
+    ASSERT_TRUE( configParser.saveCache(cacheFile));
+    {
+        std::ofstream corrupt(cacheFile.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+        corrupt.seekp(20);
+        corrupt << "corrupt";
+    }
+
+    ASSERT_EQ(0, configParser.parse(xmlFile));
+    EXPECT_FALSE( configParser.isLoadedFromCache());
+    EXPECT_STREQ( "Test_robot", configParser.getRobotName().c_str());
+
+    std::remove(cacheFile.c_str());
+    std::remove(xmlFile.c_str());
+}
@@ -2,8 +2,11 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include "ConfigParser.h"
 #include "Module.hpp"
+#include "IdSolver.hpp"
 
 using namespace hormodular;
 
@@ -15,21 +18,60 @@ class ConnectionsFromConfigParserTest : public testing::Test
         std::vector<Module *> modules;
 
         static const std::string FILEPATH;
+        static const std::string TRIPOD_FILEPATH;
 
         virtual void SetUp()
         {
             configParser.parse(FILEPATH);
         }
+
+        //-- Creates and attaches the modules of a robot configuration
+        void createModules(ConfigParser& parser, std::vector<Module *>& robotModules)
+        {
+            for(int i = 0; i < parser.getNumModules(); i++)
+                robotModules.push_back( new Module(parser.getRobotDescription(), i) );
+
+            for(int i = 0; i < (int) robotModules.size(); i++)
+            {
+                std::vector< std::vector<int> > connectorConfig = parser.getConnectorInfo(i);
+
+                for (int j = 0; j < (int) connectorConfig.size(); j++)
+                    if ( connectorConfig[j].size() != 0 )
+                        robotModules[i]->attach( j, robotModules[connectorConfig[j][0]]->getConnector(connectorConfig[j][1]));
+                    else
+                        robotModules[i]->attach(j, NULL);
+            }
+        }
+
+        //-- Runs a number of communication periods on a set of modules
+        void exchangeHormones(std::vector<Module *>& robotModules, int periods)
+        {
+            for( int j = 0; j < periods; j++)
+            {
+                for(int i = 0; i < (int) robotModules.size(); i++)
+                    ASSERT_TRUE(robotModules[i]->processHormones());
+                for(int i = 0; i < (int) robotModules.size(); i++)
+                    ASSERT_TRUE(robotModules[i]->sendHormones());
+            }
+        }
+
+        virtual void TearDown()
+        {
+            for(int i = 0; i < (int) modules.size(); i++)
+                delete modules[i];
+            modules.clear();
+        }
 };
 
 //const std::string ConnectionsFromConfigParserTest::FILEPATH = "../../data/test/Test_robot.xml";
 const std::string ConnectionsFromConfigParserTest::FILEPATH = "../../data/test/Test_robot2.xml";
+const std::string ConnectionsFromConfigParserTest::TRIPOD_FILEPATH = "../../data/robots/MultiDof-7-tripod.xml";
 
 TEST_F( ConnectionsFromConfigParserTest, connectionsLoadedOk)
 {
     //-- Create as many modules as needed
     for(int i = 0; i < configParser.getNumModules(); i++)
-        modules.push_back( new Module(configParser, i) );
+        modules.push_back( new Module(configParser.getRobotDescription(), i) );
 
     //-- Attach the modules to the other modules
     for(int i = 0; i < (int) modules.size(); i++)
@@ -81,3 +123,241 @@ TEST_F( ConnectionsFromConfigParserTest, connectionsLoadedOk)
     }
 
 }
+
+TEST_F( ConnectionsFromConfigParserTest, incrementalModeGivesSameIDs)
+{
+    std::vector<Module *> incrementalModules;
+
+    //-- Create two copies of the robot, one of them in incremental mode
+    for(int i = 0; i < configParser.getNumModules(); i++)
+    {
+        modules.push_back( new Module(configParser.getRobotDescription(), i) );
+        incrementalModules.push_back( new Module(configParser.getRobotDescription(), i) );
+        incrementalModules[i]->setIncrementalMode(true);
+    }
+
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        std::vector< std::vector<int> > connectorConfig = configParser.getConnectorInfo(i);
+
+        for (int j = 0; j < (int) connectorConfig.size(); j++)
+        {
+            if ( connectorConfig[j].size() != 0 )
+            {
+                int moduleConnectedTo = connectorConfig[j][0];
+                int connectorConnectedTo = connectorConfig[j][1];
+                modules[i]->attach( j, modules[moduleConnectedTo]->getConnector(connectorConnectedTo));
+                incrementalModules[i]->attach( j, incrementalModules[moduleConnectedTo]->getConnector(connectorConnectedTo));
+            }
+            else
+            {
+                modules[i]->attach(j, NULL);
+                incrementalModules[i]->attach(j, NULL);
+            }
+        }
+    }
+
+    //-- Both robots must agree on every communication period
+    int recomputed = 0;
+    for( int j = 0; j < 10; j++)
+    {
+        for(int i = 0; i < (int) modules.size(); i++)
+        {
+            EXPECT_TRUE(modules[i]->processHormones());
+            EXPECT_TRUE(incrementalModules[i]->processHormones());
+        }
+
+        recomputed = 0;
+        for(int i = 0; i < (int) modules.size(); i++)
+        {
+            EXPECT_EQ( modules[i]->getID(), incrementalModules[i]->getID());
+            EXPECT_TRUE( modules[i]->wasRecomputed());
+            if ( incrementalModules[i]->wasRecomputed() )
+                recomputed++;
+
+            EXPECT_TRUE(modules[i]->sendHormones());
+            EXPECT_TRUE(incrementalModules[i]->sendHormones());
+        }
+    }
+
+    EXPECT_EQ( 83506, incrementalModules[0]->getID() );
+    EXPECT_EQ( 78896, incrementalModules[1]->getID() );
+
+    //-- Once the IDs have converged, nothing is recomputed
+    EXPECT_EQ( 0, recomputed);
+
+    //-- Destroy modules
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        delete modules[i];
+        modules[i] = NULL;
+        delete incrementalModules[i];
+        incrementalModules[i] = NULL;
+    }
+}
+
+TEST_F( ConnectionsFromConfigParserTest, descriptorIDsConvergeAfterDepthPeriods)
+{
+    ConfigParser tripodParser;
+    ASSERT_EQ(0, tripodParser.parse(TRIPOD_FILEPATH));
+    createModules(tripodParser, modules);
+
+    const int depth = 3;
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        EXPECT_TRUE(modules[i]->setIdEncoding(Module::DESCRIPTOR_ID, depth));
+        EXPECT_EQ(Module::DESCRIPTOR_ID, modules[i]->getIdEncoding());
+        EXPECT_EQ(depth, modules[i]->getDescriptorDepth());
+    }
+
+    //-- One period for the ping hormones, one for the local descriptors and one more per depth level
+    exchangeHormones(modules, depth + 2);
+
+    std::vector<unsigned long> ids;
+    for(int i = 0; i < (int) modules.size(); i++)
+        ids.push_back(modules[i]->getID());
+
+    exchangeHormones(modules, 5);
+
+    for(int i = 0; i < (int) modules.size(); i++)
+        EXPECT_EQ(ids[i], modules[i]->getID());
+
+    //-- On the tripod, every module has a different neighbourhood
+    std::sort(ids.begin(), ids.end());
+    EXPECT_TRUE( std::adjacent_find(ids.begin(), ids.end()) == ids.end() );
+}
+
+TEST_F( ConnectionsFromConfigParserTest, incrementalModeGivesSameDescriptorIDs)
+{
+    std::vector<Module *> incrementalModules;
+    createModules(configParser, modules);
+    createModules(configParser, incrementalModules);
+
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        modules[i]->setIdEncoding(Module::DESCRIPTOR_ID);
+        incrementalModules[i]->setIdEncoding(Module::DESCRIPTOR_ID);
+        incrementalModules[i]->setIncrementalMode(true);
+    }
+
+    exchangeHormones(modules, Module::DEFAULT_DESCRIPTOR_DEPTH + 2);
+    exchangeHormones(incrementalModules, Module::DEFAULT_DESCRIPTOR_DEPTH + 2);
+
+    for(int i = 0; i < (int) modules.size(); i++)
+        EXPECT_EQ( modules[i]->getID(), incrementalModules[i]->getID());
+
+    EXPECT_NE( modules[0]->getID(), modules[1]->getID());
+
+    //-- Once the descriptors have converged, nothing is recomputed
+    exchangeHormones(incrementalModules, 2);
+    for(int i = 0; i < (int) incrementalModules.size(); i++)
+        EXPECT_FALSE( incrementalModules[i]->wasRecomputed());
+
+    for(int i = 0; i < (int) incrementalModules.size(); i++)
+        delete incrementalModules[i];
+}
+
+TEST_F( ConnectionsFromConfigParserTest, gaitTablesFromConfigParserAreUsed)
+{
+    ConfigParser gaitTablesParser;
+    ASSERT_EQ(0, gaitTablesParser.parse("../../data/test/Test_robot3.xml"));
+    createModules(gaitTablesParser, modules);
+
+    exchangeHormones(modules, 5);
+
+    //-- Oscillator parameters of configuration 0 (amplitude 60, offset 0, phase 0 and 120)
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        EXPECT_EQ(0, modules[i]->getConfigurationId());
+        EXPECT_TRUE(modules[i]->updateOscillatorParameters());
+        modules[i]->calculateNextJointPos();
+    }
+
+    EXPECT_NEAR( 0, modules[0]->getCurrentJointPos(), 1e-3);
+    EXPECT_NEAR( 60 * sin(120 * M_PI / 180), modules[1]->getCurrentJointPos(), 1e-3);
+}
+
+TEST_F( ConnectionsFromConfigParserTest, idSolverGivesDistributedIDs)
+{
+    std::vector<std::string> files;
+    files.push_back("../../data/robots/MultiDof-11-2.xml");
+    files.push_back("../../data/robots/MultiDof-7-tripod.xml");
+    files.push_back("../../data/robots/MultiDof-9-quad.xml");
+
+    for (int f = 0; f < (int) files.size(); f++)
+        for (int encoding = Module::BASE17_ID; encoding <= Module::DESCRIPTOR_ID; encoding++)
+        {
+            ConfigParser robotParser;
+            ASSERT_EQ(0, robotParser.parse(files[f]));
+
+            IdSolver idSolver(robotParser.getRobotDescription());
+            ASSERT_TRUE(idSolver.solve((Module::IdEncoding) encoding));
+            EXPECT_GT(idSolver.getWarmUpPeriods(), 0);
+
+            createModules(robotParser, modules);
+            for(int i = 0; i < (int) modules.size(); i++)
+                modules[i]->setIdEncoding((Module::IdEncoding) encoding);
+
+            //-- The distributed algorithm reaches the solution just after the warm up periods
+            exchangeHormones(modules, idSolver.getWarmUpPeriods());
+            bool allEqual = true;
+            for(int i = 0; i < (int) modules.size(); i++)
+                allEqual = allEqual && modules[i]->getID() == idSolver.getIDs()[i]
+                        && modules[i]->getConfigurationId() == idSolver.getConfigurationIds()[i];
+            EXPECT_FALSE(allEqual);
+
+            exchangeHormones(modules, 1);
+            for(int i = 0; i < (int) modules.size(); i++)
+            {
+                EXPECT_EQ(idSolver.getIDs()[i], modules[i]->getID()) << files[f] << ", module " << i;
+                EXPECT_EQ(idSolver.getConfigurationIds()[i], modules[i]->getConfigurationId()) << files[f];
+            }
+
+            //-- Modules not in a leg get their local base-17 ID
+            if ( encoding == Module::BASE17_ID )
+            {
+                for(int i = 0; i < (int) modules.size(); i++)
+                    if ( modules[i]->getID() < Module::LEG_BASE17_ID )
+                    {
+                        EXPECT_EQ(idSolver.getLocalBase17ID(i), modules[i]->getID());
+                    }
+            }
+
+            TearDown();
+        }
+}
+
+TEST_F( ConnectionsFromConfigParserTest, warmStartedModulesHaveFinalIDsFromStart)
+{
+    ConfigParser tripodParser;
+    ASSERT_EQ(0, tripodParser.parse(TRIPOD_FILEPATH));
+    createModules(tripodParser, modules);
+
+    IdSolver idSolver(tripodParser.getRobotDescription());
+    ASSERT_TRUE(idSolver.solve());
+
+    for(int i = 0; i < (int) modules.size(); i++)
+    {
+        modules[i]->setWarmStart(idSolver.getIDs()[i], idSolver.getConfigurationIds()[i],
+                                 idSolver.getWarmUpPeriods());
+        EXPECT_EQ(idSolver.getIDs()[i], modules[i]->getID());
+    }
+
+    for (int period = 0; period < 2 * idSolver.getWarmUpPeriods(); period++)
+    {
+        exchangeHormones(modules, 1);
+        for(int i = 0; i < (int) modules.size(); i++)
+        {
+            EXPECT_EQ(idSolver.getIDs()[i], modules[i]->getID()) << "period " << period;
+            EXPECT_EQ(idSolver.getConfigurationIds()[i], modules[i]->getConfigurationId());
+        }
+    }
+
+    //-- Warm start is kept after reset, and disabled when changing the ID encoding
+    modules[0]->reset();
+    EXPECT_EQ(idSolver.getIDs()[0], modules[0]->getID());
+
+    modules[0]->setIdEncoding(Module::DESCRIPTOR_ID);
+    modules[0]->reset();
+    EXPECT_NE(idSolver.getIDs()[0], modules[0]->getID());
+}
@@ -59,3 +59,11 @@ TEST_F( GaitTableTest, selectByIDReturnsParametersCorrectly)
     for (int i = 0; i < 3; i++)
         EXPECT_FLOAT_EQ( parameters2[i], answer2[i]);
 }
+
+TEST_F( GaitTableTest, hasIDOnlyForLoadedIDs)
+{
+    EXPECT_TRUE( gaitTable->hasID(83506));
+    EXPECT_TRUE( gaitTable->hasID(78896));
+    EXPECT_FALSE( gaitTable->hasID(0));
+    EXPECT_FALSE( gaitTable->hasID(4294967295ul));
+}
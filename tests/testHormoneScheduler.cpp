@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+#include "ConfigParser.h"
+#include "Module.hpp"
+#include "HormoneScheduler.hpp"
+
+using namespace hormodular;
+
+
+class HormoneSchedulerTest : public testing::Test
+{
+    public:
+        ConfigParser configParser;
+
+        static const std::string FILEPATH;
+        static const unsigned long MAX_TIME_US;
+
+        virtual void SetUp()
+        {
+            configParser.parse(FILEPATH);
+        }
+
+        //-- IDs obtained with the lockstep hormone processing used by ModularRobot
+        std::vector<unsigned long> lockstepIDs(ConfigParser configParser)
+        {
+            std::vector<Module *> modules;
+            for(int i = 0; i < configParser.getNumModules(); i++)
+                modules.push_back( new Module(configParser.getRobotDescription(), i) );
+
+            for(int i = 0; i < (int) modules.size(); i++)
+            {
+                std::vector< std::vector<int> > connectorConfig = configParser.getConnectorInfo(i);
+
+                for (int j = 0; j < (int) connectorConfig.size(); j++)
+                    if ( connectorConfig[j].size() != 0 )
+                        modules[i]->attach( j, modules[connectorConfig[j][0]]->getConnector(connectorConfig[j][1]));
+                    else
+                        modules[i]->attach(j, NULL);
+            }
+
+            for( int j = 0; j < 20; j++)
+            {
+                for(int i = 0; i < (int) modules.size(); i++)
+                    modules[i]->processHormones();
+                for(int i = 0; i < (int) modules.size(); i++)
+                    modules[i]->sendHormones();
+            }
+
+            std::vector<unsigned long> ids;
+            for(int i = 0; i < (int) modules.size(); i++)
+            {
+                ids.push_back(modules[i]->getID());
+                delete modules[i];
+            }
+
+            return ids;
+        }
+};
+
+const std::string HormoneSchedulerTest::FILEPATH = "../../data/robots/MultiDof-7-tripod.xml";
+const unsigned long HormoneSchedulerTest::MAX_TIME_US = 10000000;
+
+TEST_F( HormoneSchedulerTest, convergesToLockstepIDs)
+{
+    HormoneScheduler scheduler(configParser.getRobotDescription());
+
+    EXPECT_TRUE( scheduler.run(MAX_TIME_US) );
+    EXPECT_TRUE( scheduler.isQuiescent() );
+    EXPECT_LT( 0u, scheduler.getConvergenceTime() );
+    EXPECT_GE( scheduler.getCurrentTime(), scheduler.getConvergenceTime() );
+
+    std::vector<unsigned long> ids = lockstepIDs(configParser);
+    ASSERT_EQ( (int) ids.size(), scheduler.getNumModules() );
+    for (int i = 0; i < scheduler.getNumModules(); i++)
+        EXPECT_EQ( ids[i], scheduler.getModule(i)->getID() );
+}
+
+TEST_F( HormoneSchedulerTest, settersCheckIndices)
+{
+    HormoneScheduler scheduler(configParser.getRobotDescription());
+
+    EXPECT_TRUE( scheduler.setStartTime(0, 1000) );
+    EXPECT_TRUE( scheduler.setExecutionTime(0, 200) );
+    EXPECT_TRUE( scheduler.setLinkLatency(0, 3, 2000) );
+
+    EXPECT_FALSE( scheduler.setStartTime(-1, 1000) );
+    EXPECT_FALSE( scheduler.setExecutionTime(scheduler.getNumModules(), 10) );
+    EXPECT_FALSE( scheduler.setLinkLatency(0, 4, 10) );
+    EXPECT_TRUE( scheduler.getModule(scheduler.getNumModules()) == NULL );
+}
+
+TEST_F( HormoneSchedulerTest, runStopsAtMaxTime)
+{
+    HormoneScheduler scheduler(configParser.getRobotDescription(), 500, 50);
+
+    //-- Modules powered at different times (the network may never settle)
+    for (int i = 0; i < scheduler.getNumModules(); i++)
+        scheduler.setStartTime(i, 1000 * (i % 3));
+    scheduler.reset();
+
+    scheduler.run(100000);
+    EXPECT_GE( 100000u, scheduler.getCurrentTime() );
+    EXPECT_LT( 0u, scheduler.getNumWakeUps() );
+    EXPECT_LT( 0u, scheduler.getNumDeliveries() );
+}
+
+TEST_F( HormoneSchedulerTest, convergenceTimeDependsOnLatency)
+{
+    HormoneScheduler fastScheduler(configParser.getRobotDescription(), 1000, 100);
+    HormoneScheduler slowScheduler(configParser.getRobotDescription(), 2000, 200);
+
+    EXPECT_TRUE( fastScheduler.run(MAX_TIME_US) );
+    EXPECT_TRUE( slowScheduler.run(MAX_TIME_US) );
+    EXPECT_LT( fastScheduler.getConvergenceTime(), slowScheduler.getConvergenceTime() );
+
+    //-- Runs are repeatable
+    unsigned long convergenceTime = fastScheduler.getConvergenceTime();
+    unsigned long wakeUps = fastScheduler.getNumWakeUps();
+    fastScheduler.reset();
+    EXPECT_TRUE( fastScheduler.run(MAX_TIME_US) );
+    EXPECT_EQ( convergenceTime, fastScheduler.getConvergenceTime() );
+    EXPECT_EQ( wakeUps, fastScheduler.getNumWakeUps() );
+
+    //-- Not enough time to converge
+    fastScheduler.reset();
+    EXPECT_FALSE( fastScheduler.run(convergenceTime / 2) );
+}
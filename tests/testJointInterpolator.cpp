@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "JointInterpolator.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace hormodular;
+
+
+//-- Interpolates a sinusoid sampled every control period, returning the maximum error with
+//-- respect to the sinusoid delayed by the interpolator delay (once the four targets used by the
+//-- cubic interpolation are real samples)
+static float maxInterpolationError(JointInterpolator::Mode mode, int control_period_us, int step_us)
+{
+    JointInterpolator interpolator(mode);
+    const float period_us = 1000000, amplitude = 45;
+    float max_error = 0;
+
+    std::vector<float> targets(1), joint_values;
+    for (int time = 0; time < 2 * period_us; time += step_us)
+    {
+        int phase = time % control_period_us;
+        if ( phase == 0 )
+        {
+            targets[0] = amplitude * sin(2 * M_PI * time / period_us);
+            interpolator.addTargets(targets);
+        }
+
+        interpolator.interpolate(phase / (float) control_period_us, joint_values);
+
+        int delayed_time = time - interpolator.getDelay() * control_period_us;
+        if ( delayed_time >= control_period_us )
+            max_error = std::max(max_error, fabsf(joint_values[0] - amplitude * sin(2 * M_PI * delayed_time / period_us)));
+    }
+
+    return max_error;
+}
+
+TEST(JointInterpolatorTest, firstTargetsAreHeldStill)
+{
+    std::vector<float> targets;
+    targets.push_back(10);
+    targets.push_back(-20);
+
+    JointInterpolator::Mode modes[] = { JointInterpolator::LINEAR, JointInterpolator::CUBIC };
+    for (int i = 0; i < 2; i++)
+    {
+        JointInterpolator interpolator(modes[i]);
+        std::vector<float> joint_values;
+
+        //-- Nothing to interpolate yet
+        interpolator.interpolate(0.5, joint_values);
+        EXPECT_EQ(0, joint_values.size());
+
+        interpolator.addTargets(targets);
+        for (float fraction = 0; fraction < 1; fraction += 0.25)
+        {
+            interpolator.interpolate(fraction, joint_values);
+            ASSERT_EQ(2, joint_values.size());
+            EXPECT_FLOAT_EQ(10, joint_values[0]);
+            EXPECT_FLOAT_EQ(-20, joint_values[1]);
+        }
+    }
+}
+
+TEST(JointInterpolatorTest, linearInterpolatesLastTwoTargets)
+{
+    JointInterpolator interpolator;
+    EXPECT_EQ(JointInterpolator::LINEAR, interpolator.getMode());
+    EXPECT_EQ(1, interpolator.getDelay());
+
+    std::vector<float> targets(1, 0), joint_values;
+    interpolator.addTargets(targets);
+    targets[0] = 40;
+    interpolator.addTargets(targets);
+
+    interpolator.interpolate(0, joint_values);
+    EXPECT_FLOAT_EQ(0, joint_values[0]);
+    interpolator.interpolate(0.25, joint_values);
+    EXPECT_FLOAT_EQ(10, joint_values[0]);
+    interpolator.interpolate(0.75, joint_values);
+    EXPECT_FLOAT_EQ(30, joint_values[0]);
+}
+
+TEST(JointInterpolatorTest, cubicFollowsRampsWithTwoPeriodsDelay)
+{
+    JointInterpolator::Mode mode;
+    ASSERT_TRUE(JointInterpolator::parseMode("cubic", mode));
+    EXPECT_FALSE(JointInterpolator::parseMode("quadratic", mode));
+
+    JointInterpolator interpolator(mode);
+    EXPECT_EQ(2, interpolator.getDelay());
+
+    //-- Catmull-Rom splines reproduce straight lines
+    std::vector<float> targets(1), joint_values;
+    for (int i = 0; i < 4; i++)
+    {
+        targets[0] = 10 * i;
+        interpolator.addTargets(targets);
+    }
+
+    for (float fraction = 0; fraction < 1; fraction += 0.125)
+    {
+        interpolator.interpolate(fraction, joint_values);
+        EXPECT_NEAR(10 + 10 * fraction, joint_values[0], 1e-4);
+    }
+}
+
+TEST(JointInterpolatorTest, interpolatedGaitIsCloseToTheOriginal)
+{
+    //-- 50 Hz control rate, 4 kHz step
+    float linear_error = maxInterpolationError(JointInterpolator::LINEAR, 20000, 250);
+    float cubic_error = maxInterpolationError(JointInterpolator::CUBIC, 20000, 250);
+
+    EXPECT_LT(linear_error, 0.5);
+    EXPECT_LT(cubic_error, 0.05);
+    EXPECT_LT(cubic_error, linear_error);
+}
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <string>
 #include <vector>
 #include "ConfigParser.h"
@@ -8,6 +10,24 @@
 using namespace hormodular;
 
 
+//-- Counts the allocations of the whole test program
+static unsigned long allocations = 0;
+
+void * operator new(std::size_t size) throw(std::bad_alloc)
+{
+    allocations++;
+    void * memory = std::malloc(size > 0 ? size : 1);
+    if ( !memory )
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void * memory) throw()
+{
+    std::free(memory);
+}
+
+
 class ModularRobotTest : public testing::Test
 {
     public:
@@ -21,7 +41,7 @@ class ModularRobotTest : public testing::Test
         {
             configParser.parse(FILEPATH);
 
-            modularRobot = new ModularRobot(configParser);
+            modularRobot = new ModularRobot(configParser.getRobotDescription());
         }
 
         virtual void TearDown()
@@ -47,3 +67,27 @@ TEST_F( ModularRobotTest, robotMovesUsingHormonesAndTable)
     std::cout << "Distance travelled: " << distance << std::endl;
     EXPECT_LT(0.01, distance );
 }
+
+TEST( ModularRobotRealTimeTest, realtimeLoopDoesNotAllocateOnceConverged)
+{
+    ConfigParser configParser;
+    ASSERT_EQ(0, configParser.parse(ModularRobotTest::FILEPATH));
+
+    ModularRobot modularRobot(configParser.getRobotDescription(), "dummy");
+    ASSERT_TRUE(modularRobot.setProperty("incremental", "enabled"));
+    ASSERT_TRUE(modularRobot.setProperty("realtime", "enabled"));
+    ASSERT_TRUE(modularRobot.setTimeStep(1));
+    ASSERT_TRUE(modularRobot.reset());
+
+    //-- Until the IDs converge, hormones are still exchanged (and allocated)
+    ASSERT_TRUE(modularRobot.run(2000));
+    std::vector<int> recomputed = modularRobot.getRecomputedModulesPerPeriod();
+    ASSERT_EQ(0, recomputed.back());
+
+    //-- Then, run() only allocates the memory reserved before the loop (jitter statistics and recomputed
+    //-- modules per period), whatever the number of steps and communication periods
+    unsigned long start = allocations;
+    ASSERT_TRUE(modularRobot.run(12000));
+    EXPECT_GE(2, (int) (allocations - start));
+    EXPECT_EQ(100, (int) (modularRobot.getRecomputedModulesPerPeriod().size() - recomputed.size()));
+}
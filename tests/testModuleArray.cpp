@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ConfigParser.h"
+#include "IdSolver.hpp"
+#include "Module.hpp"
+#include "ModuleArray.hpp"
+#include "RobotGenerator.hpp"
+#include "SinusoidalOscillator.h"
+
+using namespace hormodular;
+
+static const int NUM_MODULES = 20;
+
+class ModuleArrayTest : public testing::Test
+{
+    public:
+        ConfigParser configParser;
+        RobotDescriptionPtr robotDescription;
+        IdSolver * idSolver;
+
+        virtual void SetUp()
+        {
+            RobotGenerator robotGenerator(RobotGenerator::TREE, NUM_MODULES, 7);
+            ASSERT_TRUE(robotGenerator.save(".", "testModuleArray"));
+
+            configParser.setCacheEnabled(false);
+            ASSERT_EQ(0, configParser.parse(RobotGenerator::getConfigFile(".", "testModuleArray")));
+            robotDescription = configParser.getRobotDescription();
+
+            idSolver = new IdSolver(robotDescription);
+            ASSERT_TRUE(idSolver->solve(Module::DESCRIPTOR_ID));
+        }
+
+        virtual void TearDown()
+        {
+            delete idSolver;
+            std::remove(RobotGenerator::getConfigFile(".", "testModuleArray").c_str());
+            std::remove("./testModuleArray-gaittable.txt");
+            std::remove("./testModuleArray-frequencies.txt");
+        }
+
+        //-- Sets the IDs found offline on a module, so that no hormones are needed to find its parameters
+        void setUpModule(Module * module, int index)
+        {
+            module->setIdEncoding(Module::DESCRIPTOR_ID);
+            module->setWarmStart(idSolver->getIDs()[index], idSolver->getConfigurationIds()[index],
+                                 idSolver->getWarmUpPeriods());
+            ASSERT_TRUE(module->updateOscillatorParameters());
+        }
+};
+
+TEST_F( ModuleArrayTest, sweepGivesSameJointPositionsAsOscillators)
+{
+    ModuleArray moduleArray(robotDescription, NUM_MODULES);
+    std::vector<Module *> modules;
+    for (int i = 0; i < NUM_MODULES; i++)
+    {
+        modules.push_back(new Module(robotDescription, i, &moduleArray));
+        setUpModule(modules[i], i);
+    }
+    ASSERT_EQ(NUM_MODULES, moduleArray.size());
+
+    //-- Reference oscillators, with the parameters read directly from the tables
+    std::vector<SinusoidalOscillator> oscillators;
+    GaitTable frequencyTable(robotDescription->getFrequencyTableFile());
+    for (int i = 0; i < NUM_MODULES; i++)
+    {
+        int configurationId = idSolver->getConfigurationIds()[i];
+        GaitTable gaitTable(robotDescription->getGaitTableFolder() + robotDescription->getGaitTableFiles()[configurationId]);
+
+        std::vector<float> parameters = gaitTable.getParameters(idSolver->getIDs()[i]);
+        std::vector<float> frequency = frequencyTable.getParameters(configurationId);
+        ASSERT_LE(3, (int) parameters.size());
+        ASSERT_LE(1, (int) frequency.size());
+
+        oscillators.push_back(SinusoidalOscillator(parameters[0], parameters[1], parameters[2],
+                                                   (int) (1000.0 / frequency[0])));
+    }
+
+    std::vector<float> jointValues;
+    for (int step = 0; step < 100; step++)
+    {
+        moduleArray.calculateJointPositions(jointValues);
+        ASSERT_EQ(NUM_MODULES, (int) jointValues.size());
+
+        for (int i = 0; i < NUM_MODULES; i++)
+        {
+            EXPECT_NEAR(oscillators[i].calculatePos(step * 25000), jointValues[i], 1e-3);
+            EXPECT_FLOAT_EQ(jointValues[i], modules[i]->getCurrentJointPos());
+        }
+
+        moduleArray.updateElapsedTime(25);
+    }
+
+    for (int i = 0; i < NUM_MODULES; i++)
+    {
+        EXPECT_EQ(idSolver->getIDs()[i], modules[i]->getID());
+        delete modules[i];
+    }
+}
+
+TEST_F( ModuleArrayTest, gaitTablesAreShared)
+{
+    ModuleArray moduleArray(robotDescription, NUM_MODULES);
+    ASSERT_EQ(1, moduleArray.getNumConfigurations());
+    EXPECT_EQ(0, moduleArray.getDefaultConfigurationId());
+
+    GaitTable * gaitTable = moduleArray.getGaitTable(0);
+    ASSERT_TRUE(gaitTable != NULL);
+    EXPECT_EQ(gaitTable, moduleArray.getGaitTable(0));
+    EXPECT_TRUE(moduleArray.getGaitTable(1) == NULL);
+}
@@ -2,6 +2,7 @@
 #include "SinusoidalOscillator.h"
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
+#include "ConfigParser.h"
 
 #include <iostream>
 
@@ -26,7 +27,7 @@ class MovementTest : public testing::Test
         configParser.parse("../../data/robots/Test_robot.xml");
 
         //-- Create robot, simulated type
-        robotInterface = createModularRobotInterface( "simulated", configParser);
+        robotInterface = createModularRobotInterface( "simulated", configParser.getRobotDescription());
 
         //-- Create sinusoidal oscillators with the test parameters
         for ( int i = 0; i < configParser.getNumModules(); i++)
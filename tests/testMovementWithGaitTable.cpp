@@ -2,6 +2,7 @@
 #include "SinusoidalOscillator.h"
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
+#include "ConfigParser.h"
 #include "GaitTable.h"
 
 #include <iostream>
@@ -28,7 +29,7 @@ class MovementTestWithGaitTable : public testing::Test
         gaitTable = new GaitTable(GAIT_TABLE_FILEPATH);
 
         //-- Create robot, simulated type
-        robotInterface = createModularRobotInterface( "simulated", configParser);
+        robotInterface = createModularRobotInterface( "simulated", configParser.getRobotDescription());
 
         //-- Create sinusoidal oscillators with the test parameters
         for ( int i = 0; i < configParser.getNumModules(); i++)
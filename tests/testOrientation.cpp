@@ -3,6 +3,7 @@
 #include <eigen3/Eigen/Geometry>
 
 #include <iostream>
+#include <vector>
 
 using namespace hormodular;
 
@@ -127,3 +128,46 @@ TEST( TestOrientation, getRelativeOrientationOk)
     EXPECT_EQ(3, Orientation::getRelativeOrientation(2, x6_2, x4));
 
 }
+
+TEST( TestOrientation, getIndexOk)
+{
+    //-- Equivalent orientations share the same index
+    EXPECT_EQ(Orientation(0, 0, 0).getIndex(), Orientation(180, 180, 180).getIndex());
+    EXPECT_EQ(Orientation(0, 0, 180).getIndex(), Orientation(180, 180, 0).getIndex());
+    EXPECT_NE(Orientation(0, 0, 0).getIndex(), Orientation(90, 0, 0).getIndex());
+
+    //-- There are 24 different orientations
+    std::vector<bool> found(Orientation::NUM_ORIENTATIONS, false);
+    for (int roll = 0; roll < 360; roll+=90)
+        for (int pitch = 0; pitch < 360; pitch+=90)
+            for (int yaw = 0; yaw < 360; yaw+=90)
+            {
+                OrientationIndex index = Orientation(roll, pitch, yaw).getIndex();
+                ASSERT_LE(0, index);
+                ASSERT_GT(Orientation::NUM_ORIENTATIONS, index);
+                found[index] = true;
+            }
+
+    for (int i = 0; i < Orientation::NUM_ORIENTATIONS; i++)
+        EXPECT_TRUE(found[i]);
+
+    EXPECT_EQ(Orientation::INVALID_INDEX, Orientation(45, 0, 0).getIndex());
+}
+
+TEST( TestOrientation, lookupTableMatchesEigen)
+{
+    for (int local = 0; local < 64; local++)
+        for (int remote = 0; remote < 64; remote++)
+        {
+            Orientation localOrient( (local / 16) * 90, ((local / 4) % 4) * 90, (local % 4) * 90);
+            Orientation remoteOrient( (remote / 16) * 90, ((remote / 4) % 4) * 90, (remote % 4) * 90);
+
+            for (int connector = 0; connector < 4; connector++)
+            {
+                int expected = Orientation::getRelativeOrientationEigen(connector, localOrient, remoteOrient);
+                EXPECT_EQ(expected, Orientation::getRelativeOrientation(connector, localOrient, remoteOrient));
+                EXPECT_EQ(expected, Orientation::getRelativeOrientation(connector, localOrient.getIndex(),
+                                                                        remoteOrient.getIndex()));
+            }
+        }
+}
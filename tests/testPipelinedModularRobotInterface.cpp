@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <stdint.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <vector>
+#include "PipelinedModularRobotInterface.hpp"
+
+using namespace hormodular;
+
+
+//-- Target interface that stores the frames received, taking some time to "execute" each of them
+class FrameStoreInterface : public ModularRobotInterface
+{
+    public:
+        FrameStoreInterface(int execution_time_us) : execution_time_us(execution_time_us), executing(0),
+            max_executing(0), destroyed(false) {}
+
+        virtual bool start() { return true; }
+        virtual bool stop() { return true; }
+        virtual bool destroy() { destroyed = true; return true; }
+        virtual bool reset() { frames.clear(); return true; }
+        virtual float getTravelledDistance() { return frames.size(); }
+
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0)
+        {
+            max_executing = std::max(max_executing, ++executing);
+            usleep(execution_time_us);
+            frames.push_back(joint_values);
+            steps.push_back(step_ms);
+            executing--;
+
+            //-- Empty frames are rejected
+            return !joint_values.empty();
+        }
+
+        virtual std::vector<float> getJointValues()
+        {
+            return frames.empty() ? std::vector<float>() : frames.back();
+        }
+
+        std::vector<std::vector<float> > frames;
+        std::vector<float> steps;
+        int execution_time_us;
+        int executing;
+        int max_executing;
+        bool destroyed;
+};
+
+//-- Time elapsed since start (in us)
+static uint64_t elapsedUs(uint64_t start)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec * (uint64_t) 1000000 + now.tv_usec - start;
+}
+
+TEST(PipelinedModularRobotInterfaceTest, framesAreSentInOrder)
+{
+    FrameStoreInterface * target = new FrameStoreInterface(100);
+    PipelinedModularRobotInterface pipeline(target, 1);
+    EXPECT_EQ(1, pipeline.getLatency());
+
+    for (int i = 0; i < 100; i++)
+        EXPECT_TRUE(pipeline.sendJointValues(std::vector<float>(3, i), 0.25 * i));
+
+    //-- Queries wait until all the frames are executed
+    EXPECT_FLOAT_EQ(100, pipeline.getTravelledDistance());
+    ASSERT_EQ(100, target->frames.size());
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_FLOAT_EQ(i, target->frames[i][0]);
+        EXPECT_FLOAT_EQ(0.25 * i, target->steps[i]);
+    }
+
+    EXPECT_EQ(1, target->max_executing);
+    EXPECT_FLOAT_EQ(99, pipeline.getJointValues()[0]);
+
+    EXPECT_TRUE(pipeline.destroy());
+}
+
+TEST(PipelinedModularRobotInterfaceTest, controllerIsAtMostLatencyFramesAhead)
+{
+    for (int latency = 1; latency <= 3; latency++)
+    {
+        FrameStoreInterface * target = new FrameStoreInterface(20000);
+        PipelinedModularRobotInterface pipeline(target, latency);
+
+        //-- The first latency + 1 frames fill the buffer without waiting
+        uint64_t start = elapsedUs(0);
+        for (int i = 0; i <= latency; i++)
+            pipeline.sendJointValues(std::vector<float>(1, i));
+        EXPECT_GT(10000, elapsedUs(start));
+
+        //-- The next one waits until the first one has been executed
+        pipeline.sendJointValues(std::vector<float>(1, latency + 1));
+        EXPECT_LE(10000, elapsedUs(start));
+
+        EXPECT_TRUE(pipeline.flush());
+        EXPECT_EQ(latency + 2, target->frames.size());
+        pipeline.destroy();
+    }
+}
+
+TEST(PipelinedModularRobotInterfaceTest, errorsAreReportedAfterwards)
+{
+    FrameStoreInterface * target = new FrameStoreInterface(0);
+    PipelinedModularRobotInterface pipeline(target);
+
+    pipeline.sendJointValues(std::vector<float>());
+    EXPECT_FALSE(pipeline.flush());
+    EXPECT_FALSE(pipeline.sendJointValues(std::vector<float>(1, 0)));
+
+    //-- Reset clears the error
+    EXPECT_TRUE(pipeline.reset());
+    EXPECT_TRUE(pipeline.sendJointValues(std::vector<float>(1, 0)));
+    EXPECT_TRUE(pipeline.flush());
+
+    pipeline.destroy();
+}
+
+TEST(PipelinedModularRobotInterfaceTest, releaseReturnsTheTarget)
+{
+    FrameStoreInterface * target = new FrameStoreInterface(1000);
+    PipelinedModularRobotInterface * pipeline = new PipelinedModularRobotInterface(target, 2);
+
+    for (int i = 0; i < 10; i++)
+        pipeline->sendJointValues(std::vector<float>(1, i));
+
+    //-- The queued frames are sent before releasing the target
+    EXPECT_EQ(target, pipeline->release());
+    EXPECT_EQ(10, target->frames.size());
+    EXPECT_FALSE(pipeline->sendJointValues(std::vector<float>(1, 0)));
+
+    delete pipeline;
+    EXPECT_FALSE(target->destroyed);
+    delete target;
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <boost/thread.hpp>
+#include "Profiler.hpp"
+
+using namespace hormodular;
+
+
+//-- Records a number of intervals of 1 us on a phase
+struct IntervalRecorder
+{
+    IntervalRecorder(Profiler::Phase phase, int num_intervals) : phase(phase), num_intervals(num_intervals) {}
+
+    void operator()()
+    {
+        for (int i = 0; i < num_intervals; i++)
+            Profiler::record(phase, 1000 * i, 1000 * i + 1000);
+    }
+
+    Profiler::Phase phase;
+    int num_intervals;
+};
+
+class ProfilerTest : public testing::Test
+{
+    public:
+        virtual void SetUp()
+        {
+            Profiler::enableTrace(false);
+            Profiler::reset();
+        }
+
+        virtual void TearDown()
+        {
+            Profiler::enableTrace(false);
+            Profiler::reset();
+        }
+};
+
+TEST_F(ProfilerTest, ResetClearsThePhases)
+{
+    IntervalRecorder(Profiler::JOINT_SEND, 10)();
+    EXPECT_EQ(10, (int) Profiler::getCalls(Profiler::JOINT_SEND));
+
+    Profiler::reset();
+    EXPECT_EQ(0, (int) Profiler::getCalls(Profiler::JOINT_SEND));
+    EXPECT_EQ(0, (int) Profiler::getTotalTime(Profiler::JOINT_SEND));
+}
+
+TEST_F(ProfilerTest, ThreadsAreMergedOnReport)
+{
+    const int NUM_THREADS = 4;
+    const int NUM_INTERVALS = 10000;
+
+    boost::thread_group threads;
+    for (int i = 0; i < NUM_THREADS; i++)
+        threads.create_thread(IntervalRecorder(Profiler::OSCILLATOR_UPDATE, NUM_INTERVALS));
+    threads.join_all();
+
+    //-- The data of the finished threads is still reported
+    EXPECT_EQ(NUM_THREADS * NUM_INTERVALS, (int) Profiler::getCalls(Profiler::OSCILLATOR_UPDATE));
+    EXPECT_EQ((uint64_t) NUM_THREADS * NUM_INTERVALS * 1000, Profiler::getTotalTime(Profiler::OSCILLATOR_UPDATE));
+    EXPECT_EQ(0, (int) Profiler::getCalls(Profiler::JOINT_SEND));
+}
+
+TEST_F(ProfilerTest, TraceKeepsTheEventsOfEveryThread)
+{
+    Profiler::enableTrace(true, 5);
+
+    IntervalRecorder(Profiler::JOINT_SEND, 3)();
+    boost::thread thread(IntervalRecorder(Profiler::SIMULATION_STEP, 8));
+    thread.join();
+
+    const std::string filepath = "testProfilerTrace.json";
+    ASSERT_TRUE(Profiler::saveTrace(filepath));
+
+    std::ifstream trace_file(filepath.c_str());
+    std::stringstream contents;
+    contents << trace_file.rdbuf();
+    trace_file.close();
+    std::remove(filepath.c_str());
+
+    //-- 3 events of this thread and 5 of the other one (the rest are dropped)
+    std::string trace = contents.str();
+    int joint_send_events = 0, simulation_step_events = 0;
+    for (size_t pos = trace.find("joint_send"); pos != std::string::npos; pos = trace.find("joint_send", pos + 1))
+        joint_send_events++;
+    for (size_t pos = trace.find("simulation_step"); pos != std::string::npos; pos = trace.find("simulation_step", pos + 1))
+        simulation_step_events++;
+
+    EXPECT_EQ(3, joint_send_events);
+    EXPECT_EQ(5, simulation_step_events);
+    EXPECT_EQ(11, (int) Profiler::getCalls(Profiler::JOINT_SEND) + (int) Profiler::getCalls(Profiler::SIMULATION_STEP));
+}
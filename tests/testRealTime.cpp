@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <sys/resource.h>
+#include "JitterStats.hpp"
+#include "RealTime.hpp"
+#include "PeriodicDeadline.hpp"
+#include "Profiler.hpp"
+
+using namespace hormodular;
+
+
+class JitterStatsTest : public testing::Test
+{
+    public:
+        static const uint64_t PERIOD_NS = 1000000;
+
+        virtual void SetUp()
+        {
+            stats.reset(PERIOD_NS, 100);
+        }
+
+        //-- Adds the cycles of a loop whose periods are the nominal one plus the given jitters
+        void addCycles(const int64_t * jitters, int num_jitters)
+        {
+            uint64_t time_ns = 5000000000ULL;
+            stats.addCycle(time_ns);
+
+            for (int i = 0; i < num_jitters; i++)
+            {
+                time_ns += PERIOD_NS + jitters[i];
+                stats.addCycle(time_ns);
+            }
+        }
+
+        JitterStats stats;
+};
+
+TEST_F(JitterStatsTest, EmptyStatsAreZero)
+{
+    EXPECT_EQ(0, (int) stats.getNumPeriods());
+    stats.addCycle(1000);
+    EXPECT_EQ(0, (int) stats.getNumPeriods());
+    EXPECT_EQ(0, stats.getMeanPeriod());
+    EXPECT_EQ(0, stats.getPercentile(99));
+    EXPECT_EQ(0, (int) stats.getOverruns());
+}
+
+TEST_F(JitterStatsTest, StatsOfKnownJitters)
+{
+    int64_t jitters[] = { 0, 10000, -10000, 20000, -20000, 0, 1500000, 0 };
+    addCycles(jitters, 8);
+
+    EXPECT_EQ(8, (int) stats.getNumPeriods());
+    EXPECT_EQ((int64_t) PERIOD_NS, (int64_t) stats.getNominalPeriod());
+    EXPECT_NEAR(PERIOD_NS + 1500000 / 8.0, stats.getMeanPeriod(), 1e-6);
+    EXPECT_EQ(-20000, stats.getMinJitter());
+    EXPECT_EQ(1500000, stats.getMaxJitter());
+    EXPECT_GT(stats.getStdDevJitter(), 0);
+
+    //-- Only the period of 2.5ms is longer than twice the nominal one
+    EXPECT_EQ(1, (int) stats.getOverruns());
+
+    //-- Percentiles of the absolute jitter: 0 0 0 10k 10k 20k 20k 1500k
+    EXPECT_EQ(0, stats.getPercentile(0));
+    EXPECT_EQ(10000, stats.getPercentile(50));
+    EXPECT_EQ(1500000, stats.getPercentile(100));
+}
+
+TEST_F(JitterStatsTest, CyclesBeyondCapacityAreStillCounted)
+{
+    stats.reset(PERIOD_NS, 4);
+
+    int64_t jitters[] = { 100, 100, 100, 100, 100, 100, 3000000 };
+    addCycles(jitters, 7);
+
+    EXPECT_EQ(7, (int) stats.getNumPeriods());
+    EXPECT_EQ(3000000, stats.getMaxJitter());
+    EXPECT_EQ(1, (int) stats.getOverruns());
+
+    //-- The percentiles only include the stored jitters
+    EXPECT_EQ(100, stats.getPercentile(100));
+}
+
+TEST(RealTimeTest, EnableDegradesGracefully)
+{
+    //-- Without privileges some of the settings may fail, but the rest are still applied
+    bool ok = RealTime::enable(0);
+    EXPECT_TRUE(RealTime::isCpuPinned());
+    EXPECT_EQ(ok, RealTime::isCpuPinned() && RealTime::isFifoScheduled() && RealTime::isMemoryLocked());
+
+    RealTime::disable();
+    EXPECT_FALSE(RealTime::isCpuPinned());
+    EXPECT_FALSE(RealTime::isFifoScheduled());
+    EXPECT_FALSE(RealTime::isMemoryLocked());
+}
+
+TEST(RealTimeTest, SleepUntilWaitsForTheDeadline)
+{
+    uint64_t deadline = Profiler::now() + 2000000;
+    RealTime::sleepUntil(deadline);
+    EXPECT_GE(Profiler::now(), deadline);
+
+    //-- Deadlines in the past return immediately
+    uint64_t start = Profiler::now();
+    RealTime::sleepUntil(start - 1000000);
+    EXPECT_LT(Profiler::now() - start, (uint64_t) 1000000);
+}
+
+//-- Minor page faults of the process so far
+static long minorPageFaults()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+TEST(RealTimeTest, PrefaultHeapTouchesThePages)
+{
+    //-- Larger than any heap used before, so that its pages are not mapped yet
+    static const size_t SIZE = 4 * RealTime::DEFAULT_PREFAULT_HEAP;
+
+    long faults = minorPageFaults();
+    RealTime::prefaultHeap(SIZE);
+    faults = minorPageFaults() - faults;
+
+    //-- At least one fault every two pages, even if the kernel maps huge pages of 2MB
+    EXPECT_LE((long) (SIZE / (2 * 2 * 1024 * 1024)), faults);
+}
+
+//-- Runs steps of 2ms that take 0.5ms of work each, and returns the time taken (in ms)
+static double runPacedSteps(PeriodicDeadline& pacing, int steps)
+{
+    uint64_t start = Profiler::now();
+    for (int i = 0; i < steps; i++)
+    {
+        uint64_t work_end = Profiler::now() + 500000;
+        while ( Profiler::now() < work_end ) {}
+
+        pacing.waitStep(2);
+    }
+    return (Profiler::now() - start) / 1e6;
+}
+
+TEST(PeriodicDeadlineTest, AbsoluteDeadlinesDoNotAccumulateTheWork)
+{
+    PeriodicDeadline pacing;
+    EXPECT_FALSE(pacing.isAbsolute());
+
+    //-- Sleeping the step after the work of each step
+    EXPECT_LE(20 * 2.5, runPacedSteps(pacing, 20));
+
+    //-- The schedule starts on the first step, the work of the rest is done within their period
+    pacing.setAbsolute(true);
+    EXPECT_TRUE(pacing.isAbsolute());
+    double elapsed_ms = runPacedSteps(pacing, 20);
+    EXPECT_LE(20 * 2, elapsed_ms);
+    EXPECT_GT(20 * 2.25, elapsed_ms);
+
+    //-- Steps of 0 do not wait
+    uint64_t start = Profiler::now();
+    pacing.waitStep(0);
+    EXPECT_LT(Profiler::now() - start, (uint64_t) 1000000);
+}
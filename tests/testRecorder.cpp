@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Recorder.hpp"
+#include "RecordingReader.hpp"
+
+using namespace hormodular;
+
+
+class RecorderTest : public testing::Test
+{
+    public:
+        static const int NUM_MODULES = 5;
+        static const int NUM_STEPS = 10000;
+        static const std::string FILEPATH;
+
+        //-- Records NUM_STEPS steps (joints + timing) and one modules record every 400 steps
+        void record(const std::string& filepath, bool compressed, int chunk_size = Recorder::DEFAULT_CHUNK_SIZE)
+        {
+            Recorder recorder;
+            ASSERT_TRUE(recorder.open(filepath, NUM_MODULES, 0.25, compressed, chunk_size));
+
+            std::vector<float> joint_values(NUM_MODULES);
+            std::vector<uint64_t> ids(NUM_MODULES);
+            std::vector<int32_t> configuration_ids(NUM_MODULES);
+
+            for (int step = 0; step < NUM_STEPS; step++)
+            {
+                uint64_t time_us = step * 250;
+
+                if ( step % 400 == 0 )
+                {
+                    for (int i = 0; i < NUM_MODULES; i++)
+                    {
+                        ids[i] = 17 * step + i;
+                        configuration_ids[i] = step / 400 - i;
+                    }
+                    recorder.recordModules(time_us, ids, configuration_ids);
+                }
+
+                for (int i = 0; i < NUM_MODULES; i++)
+                    joint_values[i] = 0.5f * step - i;
+                recorder.recordJointValues(time_us, joint_values);
+                recorder.recordTiming(time_us, step + 1000);
+            }
+
+            EXPECT_EQ(2 * NUM_STEPS + NUM_STEPS / 400, (int) recorder.getNumRecords());
+            EXPECT_TRUE(recorder.close());
+        }
+
+        //-- Checks that the recording contains what record() stored
+        void check(const std::string& filepath, bool compressed)
+        {
+            RecordingReader reader;
+            ASSERT_TRUE(reader.open(filepath));
+            EXPECT_EQ(NUM_MODULES, reader.getNumModules());
+            EXPECT_FLOAT_EQ(0.25, reader.getStepTime());
+            EXPECT_EQ(compressed, reader.isCompressed());
+
+            Recorder::Record record;
+            int joints = 0, timings = 0, modules = 0;
+            while ( reader.readNext(record) )
+            {
+                int step = record.time_us / 250;
+
+                switch (record.type)
+                {
+                    case Recorder::JOINT_VALUES:
+                        ASSERT_EQ(joints, step);
+                        ASSERT_EQ(NUM_MODULES, (int) record.joint_values.size());
+                        for (int i = 0; i < NUM_MODULES; i++)
+                            ASSERT_FLOAT_EQ(0.5f * step - i, record.joint_values[i]);
+                        joints++;
+                        break;
+
+                    case Recorder::TIMING:
+                        ASSERT_EQ(step + 1000, (int) record.send_time_ns);
+                        timings++;
+                        break;
+
+                    case Recorder::MODULES:
+                        ASSERT_EQ(modules * 400, step);
+                        for (int i = 0; i < NUM_MODULES; i++)
+                        {
+                            ASSERT_EQ((uint64_t) (17 * step + i), record.ids[i]);
+                            ASSERT_EQ(step / 400 - i, record.configuration_ids[i]);
+                        }
+                        modules++;
+                        break;
+                }
+            }
+
+            EXPECT_EQ(NUM_STEPS, joints);
+            EXPECT_EQ(NUM_STEPS, timings);
+            EXPECT_EQ(NUM_STEPS / 400, modules);
+        }
+
+        virtual void TearDown()
+        {
+            std::remove(FILEPATH.c_str());
+        }
+};
+
+const int RecorderTest::NUM_MODULES;
+const int RecorderTest::NUM_STEPS;
+const std::string RecorderTest::FILEPATH = "testRecorder.hmr";
+
+TEST_F(RecorderTest, recordingIsReadBack)
+{
+    record(FILEPATH, false);
+    check(FILEPATH, false);
+}
+
+TEST_F(RecorderTest, compressedRecordingIsReadBack)
+{
+    record(FILEPATH, true);
+    check(FILEPATH, true);
+}
+
+TEST_F(RecorderTest, smallChunksAreReadBack)
+{
+    record(FILEPATH, false, 64);
+    check(FILEPATH, false);
+}
+
+TEST_F(RecorderTest, truncatedRecordingStopsReading)
+{
+    record(FILEPATH, false);
+
+    //-- Remove the last bytes of the file
+    std::ifstream in(FILEPATH.c_str(), std::ios_base::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    std::ofstream out(FILEPATH.c_str(), std::ios_base::binary);
+    out.write(contents.data(), contents.size() - 10);
+    out.close();
+
+    RecordingReader reader;
+    ASSERT_TRUE(reader.open(FILEPATH));
+
+    Recorder::Record record;
+    int records = 0;
+    while ( reader.readNext(record) )
+        records++;
+
+    //-- Only the records of the complete chunks are read
+    EXPECT_LT(0, records);
+    EXPECT_GT(2 * NUM_STEPS + NUM_STEPS / 400, records);
+}
+
+TEST_F(RecorderTest, wrongFileIsRejected)
+{
+    std::ofstream out(FILEPATH.c_str());
+    out << "This is not a recording" << std::endl;
+    out.close();
+
+    RecordingReader reader;
+    EXPECT_FALSE(reader.open(FILEPATH));
+}
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ConfigParser.h"
+#include "Recorder.hpp"
+#include "ReplayModularRobotInterface.hpp"
+#include "Profiler.hpp"
+#include "DummyModularRobotInterface.hpp"
+
+using namespace hormodular;
+
+
+//-- Dummy target that waits the step it is given, as the serial interfaces do
+class SleepingInterface : public DummyModularRobotInterface
+{
+    public:
+        SleepingInterface(RobotDescriptionPtr robotDescription) : DummyModularRobotInterface(robotDescription) {}
+
+        virtual bool sendJointValues(const std::vector<float>& joint_values, float step_ms=0)
+        {
+            steps.push_back(step_ms);
+            usleep(step_ms * 1000);
+            return DummyModularRobotInterface::sendJointValues(joint_values, step_ms);
+        }
+
+        std::vector<float> steps;
+};
+
+
+class ReplayModularRobotInterfaceTest : public testing::Test
+{
+    public:
+        ConfigParser configParser;
+
+        static const std::string CONFIG_FILE;
+        static const std::string RECORDING_FILE;
+        static const int NUM_STEPS = 400;
+
+        static float jointValue(int step, int joint) { return step * 0.1f + joint; }
+
+        //-- Records NUM_STEPS steps of 1ms, with a reset (time back to 0) halfway
+        void record(int num_modules)
+        {
+            Recorder recorder;
+            ASSERT_TRUE(recorder.open(RECORDING_FILE, num_modules, 1));
+
+            std::vector<float> joint_values(num_modules);
+            for (int step = 0; step < NUM_STEPS; step++)
+            {
+                uint64_t time_us = 1000 * (step % (NUM_STEPS / 2));
+
+                for (int i = 0; i < num_modules; i++)
+                    joint_values[i] = jointValue(step, i);
+
+                recorder.recordJointValues(time_us, joint_values);
+                recorder.recordTiming(time_us, 1000);
+            }
+
+            recorder.close();
+        }
+
+        virtual void SetUp()
+        {
+            configParser.parse(CONFIG_FILE);
+        }
+
+        virtual void TearDown()
+        {
+            std::remove(RECORDING_FILE.c_str());
+        }
+};
+
+const int ReplayModularRobotInterfaceTest::NUM_STEPS;
+const std::string ReplayModularRobotInterfaceTest::CONFIG_FILE = "../../data/robots/MultiDof-7-tripod.xml";
+const std::string ReplayModularRobotInterfaceTest::RECORDING_FILE = "testReplay.hmr";
+
+TEST_F(ReplayModularRobotInterfaceTest, recordedValuesAreReplayed)
+{
+    record(configParser.getNumModules());
+
+    ReplayModularRobotInterface robotInterface(configParser.getRobotDescription(), RECORDING_FILE, "dummy");
+    ASSERT_TRUE(robotInterface.isReady());
+
+    for (int step = 0; step < NUM_STEPS; step++)
+    {
+        ASSERT_TRUE(robotInterface.replayStep());
+
+        std::vector<float> joint_values = robotInterface.getJointValues();
+        ASSERT_EQ(configParser.getNumModules(), (int) joint_values.size());
+        for (int i = 0; i < (int) joint_values.size(); i++)
+            ASSERT_FLOAT_EQ(jointValue(step, i), joint_values[i]);
+
+        //-- Time keeps increasing after the recorded reset
+        ASSERT_EQ(1000 * (uint64_t) step, robotInterface.getRecordedTime());
+    }
+
+    EXPECT_FALSE(robotInterface.replayStep());
+    EXPECT_TRUE(robotInterface.isFinished());
+    EXPECT_EQ(NUM_STEPS, (int) robotInterface.getReplayedSteps());
+
+    //-- Reset rewinds the recording
+    ASSERT_TRUE(robotInterface.reset());
+    ASSERT_TRUE(robotInterface.replayStep());
+    EXPECT_FLOAT_EQ(jointValue(0, 1), robotInterface.getJointValues()[1]);
+
+    robotInterface.destroy();
+}
+
+TEST_F(ReplayModularRobotInterfaceTest, realtimeReplayFollowsRecordedTime)
+{
+    record(configParser.getNumModules());
+
+    ReplayModularRobotInterface robotInterface(configParser.getRobotDescription(), RECORDING_FILE, "dummy");
+    ASSERT_TRUE(robotInterface.setProperty("realtime", "enabled"));
+
+    uint64_t start = Profiler::now();
+    while ( robotInterface.replayStep() )
+        EXPECT_LE(0, robotInterface.getLastLateness());
+    double elapsed_ms = (Profiler::now() - start) / 1e6;
+
+    //-- Last step is sent (NUM_STEPS - 1) ms after the first one
+    EXPECT_LE(NUM_STEPS - 1, elapsed_ms);
+    EXPECT_GT(NUM_STEPS * 1.5, elapsed_ms);
+
+    robotInterface.destroy();
+}
+
+TEST_F(ReplayModularRobotInterfaceTest, onlyTheReplayPacesTheTarget)
+{
+    record(configParser.getNumModules());
+
+    //-- Real time: the steps are sent at their recorded time, and the target does not wait again
+    SleepingInterface * target = new SleepingInterface(configParser.getRobotDescription());
+    ReplayModularRobotInterface robotInterface(configParser.getRobotDescription(), RECORDING_FILE, target, false);
+    ASSERT_TRUE(robotInterface.setProperty("realtime", "enabled"));
+
+    uint64_t start = Profiler::now();
+    while ( robotInterface.replayStep() ) {}
+    double elapsed_ms = (Profiler::now() - start) / 1e6;
+
+    EXPECT_LE(NUM_STEPS - 1, elapsed_ms);
+    EXPECT_GT(NUM_STEPS * 1.5, elapsed_ms);
+    ASSERT_EQ(NUM_STEPS, (int) target->steps.size());
+    for (int i = 0; i < (int) target->steps.size(); i++)
+        ASSERT_EQ(0, target->steps[i]);
+
+    //-- Not in real time: the steps are sent as fast as possible
+    ASSERT_TRUE(robotInterface.setProperty("realtime", "disabled"));
+    ASSERT_TRUE(robotInterface.reset());
+
+    start = Profiler::now();
+    while ( robotInterface.replayStep() ) {}
+    elapsed_ms = (Profiler::now() - start) / 1e6;
+
+    EXPECT_GT(NUM_STEPS / 4, elapsed_ms);
+
+    robotInterface.destroy();
+}
+
+TEST_F(ReplayModularRobotInterfaceTest, simulatedTargetGetsTheRecordedStep)
+{
+    record(configParser.getNumModules());
+
+    SleepingInterface * target = new SleepingInterface(configParser.getRobotDescription());
+    ReplayModularRobotInterface robotInterface(configParser.getRobotDescription(), RECORDING_FILE, target, true);
+
+    ASSERT_TRUE(robotInterface.replayStep());
+    ASSERT_EQ(1, (int) target->steps.size());
+    EXPECT_FLOAT_EQ(1, target->steps[0]);
+
+    robotInterface.destroy();
+}
+
+TEST_F(ReplayModularRobotInterfaceTest, recordingOfOtherRobotIsRejected)
+{
+    record(configParser.getNumModules() + 1);
+
+    ReplayModularRobotInterface robotInterface(configParser.getRobotDescription(), RECORDING_FILE, "dummy");
+    EXPECT_FALSE(robotInterface.isReady());
+    EXPECT_FALSE(robotInterface.replayStep());
+
+    robotInterface.destroy();
+}
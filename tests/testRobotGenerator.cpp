@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ConfigParser.h"
+#include "GaitTable.h"
+#include "IdSolver.hpp"
+#include "RobotGenerator.hpp"
+
+using namespace hormodular;
+
+
+class RobotGeneratorTest : public testing::Test
+{
+    public:
+        ConfigParser configParser;
+
+        //-- Generates and parses a robot, returning its number of connections
+        int generate(RobotGenerator::Shape shape, int numModules, const std::string& name)
+        {
+            RobotGenerator robotGenerator(shape, numModules, 42);
+            EXPECT_TRUE(robotGenerator.save(".", name));
+            EXPECT_EQ(0, configParser.parse(RobotGenerator::getConfigFile(".", name)));
+
+            int connections = 0;
+            RobotDescriptionPtr robotDescription = configParser.getRobotDescription();
+            for (int i = 0; robotDescription && i < robotDescription->getNumModules(); i++)
+                for (int j = 0; j < RobotDescription::NUM_CONNECTORS; j++)
+                {
+                    const RobotDescription::Connection& connection = robotDescription->getConnection(i, j);
+                    if ( !connection.isConnected() )
+                        continue;
+
+                    //-- Connections must be symmetric
+                    const RobotDescription::Connection& remote = robotDescription->getConnection(
+                                connection.module, connection.connector);
+                    EXPECT_EQ(i, remote.module);
+                    EXPECT_EQ(j, remote.connector);
+                    connections++;
+                }
+
+            return connections / 2;
+        }
+
+        void remove(const std::string& name)
+        {
+            std::remove(RobotGenerator::getConfigFile(".", name).c_str());
+            std::remove(("./" + name + "-gaittable.txt").c_str());
+            std::remove(("./" + name + "-frequencies.txt").c_str());
+        }
+};
+
+TEST_F( RobotGeneratorTest, treeIsConnected)
+{
+    EXPECT_EQ(49, generate(RobotGenerator::TREE, 50, "testRobotGenerator-tree"));
+    EXPECT_EQ(50, configParser.getNumModules());
+    remove("testRobotGenerator-tree");
+}
+
+TEST_F( RobotGeneratorTest, latticeIsSquare)
+{
+    //-- 4x4 lattice: 3 horizontal and 3 vertical connections per row / column
+    EXPECT_EQ(24, generate(RobotGenerator::LATTICE, 16, "testRobotGenerator-lattice"));
+    EXPECT_EQ(16, configParser.getNumModules());
+    remove("testRobotGenerator-lattice");
+}
+
+TEST_F( RobotGeneratorTest, gaitTableHasAllDescriptorIDs)
+{
+    generate(RobotGenerator::TREE, 30, "testRobotGenerator-gaittable");
+
+    RobotDescriptionPtr robotDescription = configParser.getRobotDescription();
+    ASSERT_TRUE( robotDescription );
+    ASSERT_EQ(1, robotDescription->getGaitTableFiles().size());
+
+    GaitTable gaitTable(robotDescription->getGaitTableFolder() + robotDescription->getGaitTableFiles()[0]);
+    EXPECT_EQ(3, gaitTable.getNumParameters());
+
+    IdSolver idSolver(robotDescription);
+    ASSERT_TRUE(idSolver.solve(Module::DESCRIPTOR_ID));
+    for (int i = 0; i < robotDescription->getNumModules(); i++)
+    {
+        EXPECT_TRUE(gaitTable.hasID(idSolver.getIDs()[i]));
+        EXPECT_EQ(0, idSolver.getConfigurationIds()[i]);
+    }
+
+    remove("testRobotGenerator-gaittable");
+}
@@ -2,6 +2,7 @@
 #include <string>
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
+#include "ConfigParser.h"
 
 using namespace hormodular;
 
@@ -18,7 +19,7 @@ public:
         configParser.parse("../../data/robots/Test_robot.xml");
 
         //-- Create robot, serial type
-        robotInterface = createModularRobotInterface( "serial", configParser);
+        robotInterface = createModularRobotInterface( "serial", configParser.getRobotDescription());
         robotInterface->start();
     }
 
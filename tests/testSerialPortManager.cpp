@@ -0,0 +1,276 @@
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "SerialPortManager.hpp"
+#include "MultiSerialModularRobotInterface.hpp"
+#include "ConfigParser.h"
+
+using namespace hormodular;
+
+
+//-- Pseudo-terminal pair: the manager opens the slave, the test acts as the device on the master
+class PseudoTerminal
+{
+    public:
+        PseudoTerminal()
+        {
+            master = posix_openpt(O_RDWR | O_NOCTTY);
+            if ( master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0 )
+                slave_name = ptsname(master);
+
+            //-- Raw mode, so that the bytes are not translated
+            struct termios options;
+            tcgetattr(master, &options);
+            cfmakeraw(&options);
+            tcsetattr(master, TCSANOW, &options);
+        }
+
+        ~PseudoTerminal()
+        {
+            closeMaster();
+        }
+
+        void closeMaster()
+        {
+            if ( master >= 0 )
+                close(master);
+            master = -1;
+        }
+
+        //-- Reads the given number of bytes from the master, waiting at most timeout_ms for each read
+        std::vector<unsigned char> read(int size, int timeout_ms = 1000)
+        {
+            std::vector<unsigned char> data;
+            unsigned char buffer[256];
+
+            while ( (int) data.size() < size )
+            {
+                struct pollfd pfd = { master, POLLIN, 0 };
+                if ( poll(&pfd, 1, timeout_ms) <= 0 )
+                    break;
+
+                int remaining = size - data.size();
+                ssize_t bytes = ::read(master, buffer, remaining < (int) sizeof(buffer) ? remaining : sizeof(buffer));
+                if ( bytes <= 0 )
+                    break;
+                data.insert(data.end(), buffer, buffer + bytes);
+            }
+
+            return data;
+        }
+
+        bool write(const std::string& data)
+        {
+            return ::write(master, data.c_str(), data.size()) == (ssize_t) data.size();
+        }
+
+        int master;
+        std::string slave_name;
+};
+
+static std::vector<unsigned char> makeFrame(int port, int index, int size = 9)
+{
+    std::vector<unsigned char> frame(size);
+    for (int i = 0; i < size; i++)
+        frame[i] = (unsigned char) (port * 64 + index + i);
+    return frame;
+}
+
+TEST(SerialPortManagerTest, framesAreWrittenInOrderToEachPort)
+{
+    static const int NUM_PORTS = 4;
+    static const int NUM_FRAMES = 200;
+
+    PseudoTerminal terminals[NUM_PORTS];
+    SerialPortManager manager;
+    int ports[NUM_PORTS];
+
+    for (int i = 0; i < NUM_PORTS; i++)
+    {
+        ASSERT_FALSE(terminals[i].slave_name.empty());
+        ports[i] = manager.open(terminals[i].slave_name);
+        ASSERT_LE(0, ports[i]);
+        EXPECT_EQ(terminals[i].slave_name, manager.getPortName(ports[i]));
+    }
+    EXPECT_EQ(NUM_PORTS, manager.getNumPorts());
+
+    //-- Frames to all the ports interleaved, reading them as the devices would
+    for (int frame = 0; frame < NUM_FRAMES; frame++)
+    {
+        for (int i = 0; i < NUM_PORTS; i++)
+            EXPECT_TRUE(manager.send(ports[i], makeFrame(i, frame)));
+
+        for (int i = 0; i < NUM_PORTS; i++)
+        {
+            std::vector<unsigned char> received = terminals[i].read(9);
+            EXPECT_TRUE(received == makeFrame(i, frame));
+        }
+    }
+
+    for (int i = 0; i < NUM_PORTS; i++)
+    {
+        EXPECT_TRUE(manager.flush(ports[i], 1000));
+
+        SerialPortManager::PortStats stats = manager.getStats(ports[i]);
+        EXPECT_EQ(NUM_FRAMES, (int) stats.frames_queued);
+        EXPECT_EQ(NUM_FRAMES, (int) stats.frames_sent);
+        EXPECT_EQ(0, (int) stats.frames_dropped);
+        EXPECT_EQ(NUM_FRAMES * 9, (int) stats.bytes_written);
+        EXPECT_EQ(0, (int) stats.errors);
+    }
+
+    for (int i = 0; i < NUM_PORTS; i++)
+        EXPECT_TRUE(manager.close(ports[i]));
+    EXPECT_EQ(0, manager.getNumPorts());
+}
+
+TEST(SerialPortManagerTest, slowPortDropsOldFramesWithoutBlockingTheOthers)
+{
+    PseudoTerminal slow, fast;
+    SerialPortManager manager;
+
+    int slow_port = manager.open(slow.slave_name, SerialPortManager::DEFAULT_BAUD_RATE, 4);
+    int fast_port = manager.open(fast.slave_name);
+    ASSERT_LE(0, slow_port);
+    ASSERT_LE(0, fast_port);
+
+    //-- Nobody reads the slow port: once the kernel buffer is full the frames queue, and then the
+    //-- oldest ones are dropped, but sending never blocks
+    static const int NUM_FRAMES = 20000;
+    static const int FRAME_SIZE = 64;
+    for (int frame = 0; frame < NUM_FRAMES; frame++)
+        EXPECT_TRUE(manager.send(slow_port, makeFrame(0, frame % 64, FRAME_SIZE)));
+
+    SerialPortManager::PortStats slow_stats = manager.getStats(slow_port);
+    EXPECT_LT(0, (int) slow_stats.frames_dropped);
+    EXPECT_LT(0, (int) slow_stats.partial_writes);
+    EXPECT_EQ(4, slow_stats.max_queue_depth);
+    EXPECT_GE(NUM_FRAMES, (int) (slow_stats.frames_sent + slow_stats.frames_dropped));
+    EXPECT_LE(NUM_FRAMES - 4, (int) (slow_stats.frames_sent + slow_stats.frames_dropped));
+
+    //-- The other port is not affected
+    EXPECT_TRUE(manager.send(fast_port, makeFrame(1, 0)));
+    EXPECT_TRUE(fast.read(9) == makeFrame(1, 0));
+
+    //-- Once the device reads, the queued frames are written and the last one is the last sent
+    int written = slow_stats.bytes_written;
+    std::vector<unsigned char> received = slow.read(written);
+    EXPECT_EQ(written, (int) received.size());
+    EXPECT_TRUE(manager.flush(slow_port, 2000));
+
+    slow_stats = manager.getStats(slow_port);
+    EXPECT_EQ(NUM_FRAMES, (int) (slow_stats.frames_sent + slow_stats.frames_dropped));
+    EXPECT_EQ(slow_stats.frames_sent * FRAME_SIZE, slow_stats.bytes_written);
+
+    //-- Only whole frames are written
+    received = slow.read(slow_stats.bytes_written - written);
+    EXPECT_EQ(slow_stats.bytes_written - written, received.size());
+    std::vector<unsigned char> last_frame(received.end() - FRAME_SIZE, received.end());
+    EXPECT_TRUE(last_frame == makeFrame(0, (NUM_FRAMES - 1) % 64, FRAME_SIZE));
+}
+
+TEST(SerialPortManagerTest, receiveWaitsForTheBytes)
+{
+    PseudoTerminal terminal;
+    SerialPortManager manager;
+
+    int port = manager.open(terminal.slave_name);
+    ASSERT_LE(0, port);
+
+    std::vector<unsigned char> data;
+    EXPECT_FALSE(manager.receive(port, data, 4, 50));
+
+    ASSERT_TRUE(terminal.write("[Debug] Ok!\r\n"));
+    ASSERT_TRUE(manager.receive(port, data, 7, 1000));
+    EXPECT_EQ("[Debug]", std::string(data.begin(), data.end()));
+    ASSERT_TRUE(manager.receive(port, data, 6, 1000));
+    EXPECT_EQ(" Ok!\r\n", std::string(data.begin(), data.end()));
+    EXPECT_EQ(13, (int) manager.getStats(port).bytes_read);
+}
+
+TEST(SerialPortManagerTest, disconnectedPortFails)
+{
+    SerialPortManager manager;
+    PseudoTerminal terminal;
+
+    EXPECT_EQ(-1, manager.open("/dev/does-not-exist"));
+    EXPECT_EQ(-1, manager.open(terminal.slave_name, 1234));
+
+    int port = manager.open(terminal.slave_name);
+    ASSERT_LE(0, port);
+
+    //-- Closing the master hangs up the slave
+    terminal.closeMaster();
+
+    std::vector<unsigned char> data;
+    EXPECT_FALSE(manager.receive(port, data, 1, 1000));
+    EXPECT_FALSE(manager.send(port, makeFrame(0, 0)));
+    EXPECT_EQ(1, (int) manager.getStats(port).errors);
+
+    EXPECT_TRUE(manager.close(port));
+    EXPECT_FALSE(manager.send(port, makeFrame(0, 0)));
+    EXPECT_FALSE(manager.close(port));
+}
+
+TEST(SerialPortManagerTest, robotInterfacesShareTheManager)
+{
+    PseudoTerminal terminals[2];
+    SerialPortManager manager;
+    MultiSerialModularRobotInterface * interfaces[2];
+    ConfigParser configParsers[2];
+
+    for (int i = 0; i < 2; i++)
+    {
+        //-- Test robot connected to the pseudo-terminal
+        std::ifstream original("../../data/robots/Test_robot.xml");
+        std::string config((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+        config.replace(config.find("/dev/ttyUSB0"), 12, terminals[i].slave_name);
+
+        char filepath[] = "/tmp/testSerialPortManager-XXXXXX";
+        int fd = mkstemp(filepath);
+        ASSERT_LE(0, fd);
+        ASSERT_EQ((ssize_t) config.size(), write(fd, config.c_str(), config.size()));
+        close(fd);
+
+        ASSERT_EQ(0, configParsers[i].parse(filepath));
+        remove(filepath);
+
+        interfaces[i] = new MultiSerialModularRobotInterface(configParsers[i].getRobotDescription(), &manager);
+
+        //-- The robot sends its welcome message when connected
+        ASSERT_TRUE(terminals[i].write("[Debug] Ok!\r\n"));
+        ASSERT_TRUE(interfaces[i]->start());
+    }
+    EXPECT_EQ(2, manager.getNumPorts());
+
+    std::vector<float> joint_values;
+    joint_values.push_back(30);
+    joint_values.push_back(-45);
+
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_TRUE(interfaces[i]->sendJointValues(joint_values, 0));
+
+        std::vector<unsigned char> received = terminals[i].read(3);
+        ASSERT_EQ(3, (int) received.size());
+        EXPECT_EQ(0x50, received[0]);
+        EXPECT_EQ(120, received[1]);
+        EXPECT_EQ(45, received[2]);
+
+        EXPECT_EQ(1, (int) interfaces[i]->getStats().frames_sent);
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_TRUE(interfaces[i]->destroy());
+        delete interfaces[i];
+    }
+    EXPECT_EQ(0, manager.getNumPorts());
+}
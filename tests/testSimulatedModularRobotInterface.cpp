@@ -1,7 +1,10 @@
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include "ModularRobotInterface.hpp"
 #include "ModularRobotInterfaceFactory.hpp"
+#include "ConfigParser.h"
 
 using namespace hormodular;
 
@@ -18,7 +21,7 @@ public:
         configParser.parse("../../data/robots/Test_robot.xml");
 
         //-- Create robot, simulated type
-        robotInterface = createModularRobotInterface( "simulated", configParser);
+        robotInterface = createModularRobotInterface( "simulated", configParser.getRobotDescription());
    	}
 
     virtual void TearDown()
@@ -61,3 +64,103 @@ TEST_F(RobotInterfaceTest, sendJointValuesSendsJointValues)
     EXPECT_NEAR(30, joint_values_received[0], 5);
     EXPECT_NEAR(-45, joint_values_received[1], 5);
 }
+
+//-- Joint values of the robot after each control step of 10ms, holding the joint values sent
+static std::vector<float> heldJointValuesTrajectory(ModularRobotInterface * robotInterface, int steps)
+{
+    std::vector<float> joint_values_sent, trajectory;
+    joint_values_sent.push_back(30);
+    joint_values_sent.push_back(-45);
+
+    for(int i = 0; i < steps; i ++)
+    {
+        EXPECT_TRUE(robotInterface->sendJointValues(joint_values_sent, 10));
+
+        std::vector<float> joint_values_received = robotInterface->getJointValues();
+        trajectory.insert(trajectory.end(), joint_values_received.begin(), joint_values_received.end());
+    }
+
+    return trajectory;
+}
+
+TEST_F(RobotInterfaceTest, sendJointValuesWithSubstepsSendsJointValues)
+{
+    EXPECT_FALSE(robotInterface->setProperty("substeps", "0"));
+
+    //-- Same simulated time as sendJointValuesSendsJointValues, with ten times less control steps
+    ASSERT_TRUE(robotInterface->setProperty("substeps", "1"));
+    ASSERT_TRUE(robotInterface->reset());
+    std::vector<float> trajectory = heldJointValuesTrajectory(robotInterface, 500);
+
+    ASSERT_TRUE(robotInterface->setProperty("substeps", "10"));
+    ASSERT_TRUE(robotInterface->reset());
+    std::vector<float> substeps_trajectory = heldJointValuesTrajectory(robotInterface, 500);
+
+    //-- The robot reaches the joint values sent
+    ASSERT_EQ(trajectory.size(), substeps_trajectory.size());
+    EXPECT_NEAR(30, substeps_trajectory[substeps_trajectory.size() - 2], 5);
+    EXPECT_NEAR(-45, substeps_trajectory[substeps_trajectory.size() - 1], 5);
+
+    //-- But the servocontrollers are updated on each substep, so it gets there in a different way than
+    //-- with a single physics step of 10ms
+    float max_difference = 0;
+    for (int i = 0; i < (int) trajectory.size(); i++)
+        max_difference = std::max(max_difference, std::fabs(trajectory[i] - substeps_trajectory[i]));
+    EXPECT_LT(0.01, max_difference);
+}
+
+//-- Sinusoidal joint values of a gait, that is different for each robot
+static std::vector<float> gaitJointValues(int robot, int step_ms)
+{
+    float amplitude = 20 + 10 * robot;
+    float phase = 2 * M_PI * step_ms / 1000.0;
+
+    std::vector<float> joint_values;
+    joint_values.push_back(amplitude * sin(phase));
+    joint_values.push_back(amplitude * sin(phase + M_PI / 2));
+    return joint_values;
+}
+
+TEST(BatchedRobotInterfaceTest, batchedDistancesMatchSingleRobotRuns)
+{
+    static const int NUM_ROBOTS = 4;
+    static const int RUN_TIME_MS = 5000;
+
+    ConfigParser configParser;
+    configParser.parse("../../data/robots/Test_robot.xml");
+
+    //-- Each gait evaluated alone
+    std::vector<float> single_distances;
+    for (int robot = 0; robot < NUM_ROBOTS; robot++)
+    {
+        SimulatedModularRobotInterface single(configParser.getRobotDescription());
+        ASSERT_TRUE(single.reset());
+
+        for (int step = 0; step < RUN_TIME_MS; step++)
+            ASSERT_TRUE(single.sendJointValues(gaitJointValues(robot, step), 1));
+
+        single_distances.push_back(single.getTravelledDistance());
+        single.destroy();
+    }
+
+    //-- All the gaits at the same time, on copies separated for a speed of 0.25 m/s
+    SimulatedModularRobotInterface batched(configParser.getRobotDescription(), NUM_ROBOTS,
+                                           2 * 0.25 * RUN_TIME_MS / 1000.0);
+    ASSERT_TRUE(batched.reset());
+    ASSERT_EQ(NUM_ROBOTS, batched.getNumRobots());
+
+    std::vector<std::vector<float> > joint_values(NUM_ROBOTS);
+    for (int step = 0; step < RUN_TIME_MS; step++)
+    {
+        for (int robot = 0; robot < NUM_ROBOTS; robot++)
+            joint_values[robot] = gaitJointValues(robot, step);
+        ASSERT_TRUE(batched.sendJointValues(joint_values, 1));
+    }
+
+    //-- The copies do not interfere with each other
+    std::vector<float> batched_distances = batched.getTravelledDistances();
+    for (int robot = 0; robot < NUM_ROBOTS; robot++)
+        EXPECT_NEAR(single_distances[robot], batched_distances[robot], 0.01 + 0.05 * single_distances[robot]);
+
+    batched.destroy();
+}
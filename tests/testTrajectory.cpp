@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "SinusoidalOscillator.h"
+#include "Trajectory.h"
+#include <vector>
+
+using namespace hormodular;
+
+
+//-- Oscillator with a period of 0 ms, that setPeriod() does not allow
+class ZeroPeriodOscillator : public SinusoidalOscillator
+{
+    public:
+        ZeroPeriodOscillator() : SinusoidalOscillator(0, 10, 0) { period_ms = 0; }
+};
+
+class TrajectoryTest : public testing::Test
+{
+    public:
+        static const int NUM_JOINTS = 3;
+        static const int PERIOD = 1000;
+
+        std::vector<Oscillator *> oscillators;
+
+        virtual void SetUp()
+        {
+            oscillators.push_back(new SinusoidalOscillator(30, 10, 0, PERIOD));
+            oscillators.push_back(new SinusoidalOscillator(45, -20, 90, PERIOD));
+            oscillators.push_back(new SinusoidalOscillator(60, 0, 270, PERIOD));
+        }
+
+        virtual void TearDown()
+        {
+            for (int i = 0; i < (int) oscillators.size(); i++)
+                delete oscillators[i];
+            oscillators.clear();
+        }
+};
+
+const int TrajectoryTest::NUM_JOINTS;
+const int TrajectoryTest::PERIOD;
+
+TEST_F(TrajectoryTest, periodicTrajectoryIsStoredOnce)
+{
+    Trajectory trajectory;
+    ASSERT_TRUE(trajectory.compute(oscillators, 0.25, 10000000));
+
+    EXPECT_EQ(NUM_JOINTS, trajectory.getNumJoints());
+    EXPECT_EQ(40000, trajectory.getNumSteps());
+    EXPECT_EQ(4000, trajectory.getBufferedSteps());
+    EXPECT_TRUE(trajectory.isCyclic());
+    EXPECT_EQ(250, trajectory.getStepTime());
+}
+
+TEST_F(TrajectoryTest, trajectoryMatchesOscillators)
+{
+    Trajectory trajectory;
+    ASSERT_TRUE(trajectory.compute(oscillators, 0.25, 3000000));
+
+    unsigned long elapsed_time = 0;
+    for (int step = 0; step < trajectory.getNumSteps(); step++)
+    {
+        const float * joint_values = trajectory.getJointValues(step);
+        for (int i = 0; i < NUM_JOINTS; i++)
+            ASSERT_NEAR(oscillators[i]->calculatePos(elapsed_time), joint_values[i], 1e-3);
+
+        elapsed_time += trajectory.getStepTime();
+    }
+}
+
+TEST_F(TrajectoryTest, differentPeriodsAreNotCyclic)
+{
+    oscillators[1]->setPeriod(1500);
+
+    Trajectory trajectory;
+    ASSERT_TRUE(trajectory.compute(oscillators, 0.25, 2000000));
+
+    EXPECT_FALSE(trajectory.isCyclic());
+    EXPECT_EQ(8000, trajectory.getNumSteps());
+    EXPECT_EQ(trajectory.getNumSteps(), trajectory.getBufferedSteps());
+    EXPECT_FLOAT_EQ(oscillators[1]->calculatePos(7999*250), trajectory.getJointValues(7999)[1]);
+}
+
+TEST_F(TrajectoryTest, zeroStepFails)
+{
+    Trajectory trajectory;
+    EXPECT_FALSE(trajectory.compute(oscillators, 0, 1000000));
+}
+
+TEST_F(TrajectoryTest, zeroPeriodIsNotCyclic)
+{
+    std::vector<Oscillator *> zero_period_oscillators(2, (Oscillator *) NULL);
+    ZeroPeriodOscillator first, second;
+    zero_period_oscillators[0] = &first;
+    zero_period_oscillators[1] = &second;
+
+    Trajectory trajectory;
+    ASSERT_TRUE(trajectory.compute(zero_period_oscillators, 0.25, 1000000));
+
+    //-- The whole trajectory is stored, so the callers advance through it
+    EXPECT_FALSE(trajectory.isCyclic());
+    EXPECT_EQ(4000, trajectory.getNumSteps());
+    EXPECT_EQ(trajectory.getNumSteps(), trajectory.getBufferedSteps());
+}
+
+TEST_F(TrajectoryTest, emptyTrajectoryHasNoJointValues)
+{
+    Trajectory trajectory;
+    EXPECT_TRUE(trajectory.getJointValues(0) == NULL);
+
+    //-- Without oscillators
+    std::vector<Oscillator *> no_oscillators;
+    trajectory.compute(no_oscillators, 0.25, 1000000);
+    EXPECT_TRUE(trajectory.getJointValues(0) == NULL);
+}